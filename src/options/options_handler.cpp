@@ -155,6 +155,7 @@ void OptionsHandler::checkBvSatSolver(std::string option, SatSolverMode m)
   }
 
   if (options::bvSolver() != options::BVSolver::BITBLAST
+      && options::bvSolver() != options::BVSolver::ABSTRACT
       && (m == SatSolverMode::CRYPTOMINISAT || m == SatSolverMode::CADICAL
           || m == SatSolverMode::KISSAT))
   {
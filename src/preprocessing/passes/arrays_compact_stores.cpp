@@ -0,0 +1,231 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Preprocessing pass that compacts store chains with constant indices.
+ */
+
+#include "preprocessing/passes/arrays_compact_stores.h"
+
+#include <map>
+
+#include "expr/array_store_all.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/trust_substitutions.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+namespace {
+
+/** Returns true if n is a store with a constant index */
+bool isConstStore(TNode n)
+{
+  return n.getKind() == kind::STORE && n[1].isConst();
+}
+
+}  // namespace
+
+ArraysCompactStores::ArraysCompactStores(
+    PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "arrays-compact-stores")
+{
+}
+
+ArraysCompactStores::Statistics::Statistics()
+    : d_numWritesRemoved(smtStatisticsRegistry().registerInt(
+        "preprocessing::passes::ArraysCompactStores::NumWritesRemoved")),
+      d_numReadsResolved(smtStatisticsRegistry().registerInt(
+          "preprocessing::passes::ArraysCompactStores::NumReadsResolved"))
+{
+}
+
+PreprocessingPassResult ArraysCompactStores::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  // clear the cache, which otherwise grows across incremental calls
+  d_cache.clear();
+  theory::SubstitutionMap& sm =
+      d_preprocContext->getTopLevelSubstitutions().get();
+  for (size_t i = 0, size = assertionsToPreprocess->size(); i < size; ++i)
+  {
+    if (assertionsToPreprocess->isSubstsIndex(i))
+    {
+      continue;
+    }
+    d_preprocContext->spendResource(Resource::PreprocessStep);
+    Node a = (*assertionsToPreprocess)[i];
+    // expand the definitions without rewriting them, since they may contain
+    // the store chains
+    Node ac = compact(sm.apply(a));
+    if (ac != a)
+    {
+      Trace("arrays-compact-stores")
+          << "Compacted " << a << std::endl
+          << "  to " << ac << std::endl;
+      assertionsToPreprocess->replace(i, ac);
+    }
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+Node ArraysCompactStores::compact(TNode n)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::unordered_map<Node, Node, NodeHashFunction>::iterator it;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    it = d_cache.find(cur);
+    if (it == d_cache.end())
+    {
+      d_cache[cur] = Node::null();
+      visit.push_back(cur);
+      if (isConstStore(cur))
+      {
+        // the children of a run of stores are the values and the base, which
+        // avoids compacting every suffix of the run
+        TNode s = cur;
+        for (; isConstStore(s); s = s[0])
+        {
+          visit.push_back(s[2]);
+        }
+        visit.push_back(s);
+      }
+      else
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+      }
+    }
+    else if (it->second.isNull())
+    {
+      Node ret;
+      if (isConstStore(cur))
+      {
+        ret = compactStores(cur);
+      }
+      else
+      {
+        ret = cur;
+        bool childChanged = false;
+        std::vector<Node> children;
+        if (cur.getMetaKind() == kind::metakind::PARAMETERIZED)
+        {
+          children.push_back(cur.getOperator());
+        }
+        for (const Node& cn : cur)
+        {
+          it = d_cache.find(cn);
+          Assert(it != d_cache.end());
+          Assert(!it->second.isNull());
+          childChanged = childChanged || cn != it->second;
+          children.push_back(it->second);
+        }
+        if (childChanged)
+        {
+          ret = nm->mkNode(cur.getKind(), children);
+        }
+        if (ret.getKind() == kind::SELECT && ret[1].isConst())
+        {
+          ret = resolveSelect(ret);
+        }
+      }
+      d_cache[cur] = ret;
+    }
+  } while (!visit.empty());
+  Assert(d_cache.find(n) != d_cache.end());
+  Assert(!d_cache[n].isNull());
+  return d_cache[n];
+}
+
+Node ArraysCompactStores::compactStores(TNode n)
+{
+  // The write set, ordered as in the normal form of the rewriter, which has
+  // the smallest index innermost. The first write to an index found from the
+  // top of the chain is the last one executed, all others are shadowed.
+  std::map<Node, Node> writes;
+  size_t nstores = 0;
+  TNode s = n;
+  for (; isConstStore(s); s = s[0])
+  {
+    Assert(d_cache.find(s[2]) != d_cache.end());
+    writes.emplace(s[1], d_cache[s[2]]);
+    nstores++;
+  }
+  Assert(d_cache.find(s) != d_cache.end());
+  Node base = d_cache[s];
+  // the base may have become a run of stores, e.g. if its index was resolved
+  // to a constant
+  for (; isConstStore(base); base = base[0])
+  {
+    writes.emplace(base[1], base[2]);
+    nstores++;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Node ret = base;
+  for (const std::pair<const Node, Node>& w : writes)
+  {
+    // writes that do not change the base are redundant
+    if (base.getKind() == kind::STORE_ALL)
+    {
+      if (w.second == base.getConst<ArrayStoreAll>().getValue())
+      {
+        continue;
+      }
+    }
+    else if (w.second.getKind() == kind::SELECT && w.second[0] == base
+             && w.second[1] == w.first)
+    {
+      continue;
+    }
+    ret = nm->mkNode(kind::STORE, ret, w.first, w.second);
+    nstores--;
+  }
+  d_statistics.d_numWritesRemoved += nstores;
+  return ret;
+}
+
+Node ArraysCompactStores::resolveSelect(Node n)
+{
+  Assert(n.getKind() == kind::SELECT && n[1].isConst());
+  TNode index = n[1];
+  TNode a = n[0];
+  // distinct constant indices are disequal, so the runs of stores with
+  // constant indices can be skipped
+  for (; isConstStore(a); a = a[0])
+  {
+    if (a[1] == index)
+    {
+      ++d_statistics.d_numReadsResolved;
+      return a[2];
+    }
+  }
+  if (a.getKind() == kind::STORE_ALL)
+  {
+    ++d_statistics.d_numReadsResolved;
+    return a.getConst<ArrayStoreAll>().getValue();
+  }
+  if (a == n[0])
+  {
+    return n;
+  }
+  return NodeManager::currentNM()->mkNode(kind::SELECT, a, index);
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
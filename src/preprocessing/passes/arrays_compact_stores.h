@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Preprocessing pass that compacts store chains with constant indices.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PREPROCESSING__PASSES__ARRAYS_COMPACT_STORES_H
+#define CVC5__PREPROCESSING__PASSES__ARRAYS_COMPACT_STORES_H
+
+#include <unordered_map>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * Compacts the runs of stores with constant indices in the assertions, before
+ * they are rewritten for the first time. The stores of a run are collected in
+ * a write set that keeps the last write to each index, and the run is rebuilt
+ * with its indices in the order of the array rewriter's normal form, so that
+ * the rewriter does not have to sort and deduplicate deep chains one store at
+ * a time. Writes that do not change the base of the run (store_all(v) at v,
+ * or a at select(a, i)) are dropped. Reads at constant indices are resolved
+ * against the write sets, skipping the runs that do not write the index.
+ *
+ * The pass runs before the definitions are expanded and rewritten, so it
+ * expands them itself, without rewriting. It is iterative, so it handles
+ * chains of any depth.
+ */
+class ArraysCompactStores : public PreprocessingPass
+{
+ public:
+  ArraysCompactStores(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** Compact the store chains in n */
+  Node compact(TNode n);
+  /**
+   * Compact the run of stores with constant indices of n, whose values and
+   * base are already compacted.
+   */
+  Node compactStores(TNode n);
+  /** Resolve the read n at a constant index against its compacted array */
+  Node resolveSelect(Node n);
+
+  struct Statistics
+  {
+    /** The number of writes removed because they are shadowed or redundant */
+    IntStat d_numWritesRemoved;
+    /** The number of reads resolved to the value of a write or a constant */
+    IntStat d_numReadsResolved;
+    Statistics();
+  };
+  /**
+   * Maps terms to their compacted form, which is shared by the assertions of
+   * one call to applyInternal.
+   */
+  std::unordered_map<Node, Node, NodeHashFunction> d_cache;
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC5__PREPROCESSING__PASSES__ARRAYS_COMPACT_STORES_H */
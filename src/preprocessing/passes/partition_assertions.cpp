@@ -0,0 +1,271 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Preprocessing pass that solves independent sets of assertions separately.
+ */
+
+#include "preprocessing/passes/partition_assertions.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "expr/node_algorithm.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/preprocessing_pass_context.h"
+#include "smt/smt_engine.h"
+#include "smt/smt_engine_scope.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/rewriter.h"
+#include "theory/smt_engine_subsolver.h"
+#include "util/resource_manager.h"
+
+using namespace cvc5::kind;
+using namespace cvc5::theory;
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+PartitionAssertions::PartitionAssertions(
+    PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "partition-assertions")
+{
+}
+
+PartitionAssertions::Statistics::Statistics()
+    : d_numComponents(smtStatisticsRegistry().registerInt(
+        "preprocessing::passes::PartitionAssertions::NumComponents")),
+      d_numSolved(smtStatisticsRegistry().registerInt(
+          "preprocessing::passes::PartitionAssertions::NumSolved"))
+{
+}
+
+PreprocessingPassResult PartitionAssertions::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  const std::vector<Node>& assertions = assertionsToPreprocess->ref();
+  size_t nasserts = assertions.size();
+  // union-find over the assertions, where assertions that share a free symbol
+  // are in the same set
+  std::vector<size_t> parent(nasserts);
+  for (size_t i = 0; i < nasserts; i++)
+  {
+    parent[i] = i;
+  }
+  auto find = [&parent](size_t i) {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  // maps each symbol to the first assertion it occurs in
+  std::unordered_map<Node, size_t, NodeHashFunction> symToAssert;
+  std::vector<bool> supported(nasserts, true);
+  for (size_t i = 0; i < nasserts; i++)
+  {
+    if (expr::hasClosure(assertions[i]))
+    {
+      supported[i] = false;
+    }
+    std::unordered_set<Node, NodeHashFunction> syms;
+    expr::getSymbols(assertions[i], syms);
+    for (const Node& s : syms)
+    {
+      if (!isSupportedSymbol(s))
+      {
+        supported[i] = false;
+      }
+      std::unordered_map<Node, size_t, NodeHashFunction>::iterator it =
+          symToAssert.find(s);
+      if (it == symToAssert.end())
+      {
+        symToAssert[s] = i;
+      }
+      else
+      {
+        size_t ri = find(i);
+        size_t rj = find(it->second);
+        if (ri != rj)
+        {
+          parent[std::max(ri, rj)] = std::min(ri, rj);
+        }
+      }
+    }
+  }
+  // collect the components, their symbols and whether they are supported
+  std::map<size_t, std::vector<size_t>> comps;
+  std::map<size_t, std::vector<Node>> compSyms;
+  std::map<size_t, bool> compSupported;
+  for (size_t i = 0; i < nasserts; i++)
+  {
+    size_t r = find(i);
+    comps[r].push_back(i);
+    std::map<size_t, bool>::iterator its = compSupported.find(r);
+    if (its == compSupported.end())
+    {
+      compSupported[r] = supported[i];
+    }
+    else
+    {
+      its->second = its->second && supported[i];
+    }
+  }
+  for (const std::pair<const Node, size_t>& sa : symToAssert)
+  {
+    compSyms[find(sa.second)].push_back(sa.first);
+  }
+  Trace("partition-assertions")
+      << "PartitionAssertions: " << compSyms.size() << " components with "
+      << "symbols in " << nasserts << " assertions" << std::endl;
+  d_statistics.d_numComponents += compSyms.size();
+  if (compSyms.size() <= 1)
+  {
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  // order the components with symbols by size, the largest is left to the
+  // main solver
+  std::vector<std::pair<size_t, size_t>> order;
+  for (const std::pair<const size_t, std::vector<Node>>& cs : compSyms)
+  {
+    order.emplace_back(comps[cs.first].size(), cs.first);
+  }
+  std::sort(order.begin(), order.end());
+  order.pop_back();
+  ResourceManager* rm = smt::currentResourceManager();
+  for (const std::pair<size_t, size_t>& o : order)
+  {
+    if (rm->out())
+    {
+      // leave the remaining components to the main solver
+      break;
+    }
+    if (!compSupported[o.second])
+    {
+      continue;
+    }
+    // sort the symbols for determinism
+    std::vector<Node>& syms = compSyms[o.second];
+    std::sort(syms.begin(), syms.end());
+    Result r = solveComponent(assertionsToPreprocess, comps[o.second], syms);
+    if (r.asSatisfiabilityResult().isSat() == Result::UNSAT)
+    {
+      Trace("partition-assertions")
+          << "...component of " << o.first << " assertions is unsat"
+          << std::endl;
+      assertionsToPreprocess->clear();
+      Node n = NodeManager::currentNM()->mkConst<bool>(false);
+      assertionsToPreprocess->push_back(n);
+      return PreprocessingPassResult::CONFLICT;
+    }
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+bool PartitionAssertions::isSupportedSymbol(TNode s)
+{
+  TypeNode tn = s.getType();
+  if (!tn.isFunction())
+  {
+    return tn.isClosedEnumerable();
+  }
+  if (!tn.getRangeType().isClosedEnumerable())
+  {
+    return false;
+  }
+  for (TypeNode atn : tn.getArgTypes())
+  {
+    if (!atn.isClosedEnumerable())
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+Result PartitionAssertions::solveComponent(
+    AssertionPipeline* assertionsToPreprocess,
+    const std::vector<size_t>& indices,
+    const std::vector<Node>& syms)
+{
+  std::vector<Node> conj;
+  for (size_t i : indices)
+  {
+    conj.push_back((*assertionsToPreprocess)[i]);
+  }
+  Node query = NodeManager::currentNM()->mkAnd(conj);
+  Trace("partition-assertions")
+      << "Solve component with " << syms.size() << " symbols: " << query
+      << std::endl;
+  // the subsolver may only use what is left of the limits of this call, its
+  // resources are spent by the main solver as well
+  ResourceManager* rm = smt::currentResourceManager();
+  std::unique_ptr<SmtEngine> subsolver;
+  initializeSubsolver(subsolver);
+  subsolver->setTimeLimit(rm->getTimeRemainingThisCall());
+  subsolver->setResourceLimit(rm->getResourceRemainingThisCall(), false);
+  subsolver->setOption("produce-models", "true");
+  subsolver->assertFormula(query);
+  Result r = subsolver->checkSat();
+  rm->spendResource(static_cast<uint64_t>(subsolver->getResourceUsage()));
+  Trace("partition-assertions") << "...result : " << r << std::endl;
+  if (r.asSatisfiabilityResult().isSat() != Result::SAT)
+  {
+    return r;
+  }
+  std::vector<Node> vals;
+  for (const Node& s : syms)
+  {
+    Node v = subsolver->getValue(s);
+    if (!v.isConst() && v.getKind() != LAMBDA)
+    {
+      Trace("partition-assertions")
+          << "...non-constant value " << v << " for " << s << std::endl;
+      return r;
+    }
+    vals.push_back(v);
+  }
+  // the model must satisfy the assertions in the main solver as well
+  std::vector<Node> solved;
+  for (size_t i : indices)
+  {
+    Node a = (*assertionsToPreprocess)[i];
+    Node as = Rewriter::rewrite(
+        a.substitute(syms.begin(), syms.end(), vals.begin(), vals.end()));
+    if (!as.isConst() || !as.getConst<bool>())
+    {
+      Trace("partition-assertions")
+          << "...model does not satisfy " << a << std::endl;
+      return r;
+    }
+    solved.push_back(as);
+  }
+  for (size_t i = 0, nsyms = syms.size(); i < nsyms; i++)
+  {
+    Trace("partition-assertions")
+        << "  " << syms[i] << " -> " << vals[i] << std::endl;
+    d_preprocContext->addSubstitution(syms[i], vals[i]);
+  }
+  for (size_t j = 0, nindices = indices.size(); j < nindices; j++)
+  {
+    assertionsToPreprocess->replace(indices[j], solved[j]);
+  }
+  ++(d_statistics.d_numSolved);
+  return r;
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Preprocessing pass that solves independent sets of assertions separately.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PREPROCESSING__PASSES__PARTITION_ASSERTIONS_H
+#define CVC5__PREPROCESSING__PASSES__PARTITION_ASSERTIONS_H
+
+#include <vector>
+
+#include "expr/node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "util/result.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * Partitions the assertions into components that do not share free symbols,
+ * and solves all components but the largest one in separate subsolvers,
+ * smallest first:
+ * - if a component is unsatisfiable, the assertions are replaced by false,
+ * - if it is satisfiable, its symbols are substituted by their values in the
+ *   model of the subsolver, which are added to the model of the main solver,
+ *   and its assertions are replaced by true,
+ * - otherwise, it is left to the main solver.
+ *
+ * Only quantifier-free components whose symbols have closed enumerable types
+ * (or are functions over them) are solved separately, so that their model
+ * values are constants (or lambdas) that are meaningful in the main solver.
+ * A model is only used if it satisfies the assertions of its component after
+ * rewriting.
+ */
+class PartitionAssertions : public PreprocessingPass
+{
+ public:
+  PartitionAssertions(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** Returns true if the symbol s may be solved in a separate component */
+  static bool isSupportedSymbol(TNode s);
+  /**
+   * Solve the assertions at the given indices, whose free symbols are syms,
+   * in a subsolver. Returns the result of the subsolver, and if it is sat,
+   * replaces the assertions as described above.
+   */
+  Result solveComponent(AssertionPipeline* assertionsToPreprocess,
+                        const std::vector<size_t>& indices,
+                        const std::vector<Node>& syms);
+
+  struct Statistics
+  {
+    /** The number of components of the assertions */
+    IntStat d_numComponents;
+    /** The number of components solved in a subsolver */
+    IntStat d_numSolved;
+    Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC5__PREPROCESSING__PASSES__PARTITION_ASSERTIONS_H */
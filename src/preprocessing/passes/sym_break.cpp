@@ -0,0 +1,727 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Symmetry detection and lex-leader symmetry breaking.
+ */
+
+#include "preprocessing/passes/sym_break.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "expr/node_builder.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/quantifiers/term_util.h"
+#include "theory/rewriter.h"
+
+using namespace cvc5::kind;
+using namespace cvc5::theory;
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+namespace {
+
+/** The maximal number of vertices of the colored graph */
+const size_t s_maxVertices = 50000;
+/**
+ * The maximal number of searches, one for each candidate permutation and for
+ * each individualized constant
+ */
+const size_t s_maxSearches = 128;
+/**
+ * The maximal number of interchangeable constants of an uninterpreted sort,
+ * and of the other constants of that sort, in value precedence constraints
+ */
+const size_t s_maxPrecedence = 32;
+
+/** Returns true if we can express a total order on the values of tn */
+bool isOrderedType(TypeNode tn)
+{
+  return tn.isBoolean() || tn.isReal() || tn.isBitVector();
+}
+
+/** Make the constraint a <= b, for a and b of an ordered type */
+Node mkLeq(Node a, Node b)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TypeNode tn = a.getType();
+  if (tn.isBoolean())
+  {
+    return a.impNode(b);
+  }
+  else if (tn.isBitVector())
+  {
+    return nm->mkNode(BITVECTOR_ULE, a, b);
+  }
+  Assert(tn.isReal());
+  return nm->mkNode(LEQ, a, b);
+}
+
+/**
+ * Returns the rewritten form of n with the children of commutative operators
+ * sorted, so that the assertions are compared modulo commutativity.
+ */
+Node normalize(TNode n)
+{
+  n = Rewriter::rewrite(n);
+  std::unordered_map<TNode, Node, TNodeHashFunction> visited;
+  std::unordered_map<TNode, Node, TNodeHashFunction>::iterator it;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    it = visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = Node::null();
+      visit.push_back(cur);
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+    else if (it->second.isNull())
+    {
+      std::vector<Node> children;
+      for (const Node& cn : cur)
+      {
+        children.push_back(visited[cn]);
+      }
+      Kind k = cur.getKind();
+      if (quantifiers::TermUtil::isComm(k))
+      {
+        std::sort(children.begin(), children.end());
+      }
+      Node ret = cur;
+      if (children.size() > 0)
+      {
+        NodeBuilder nb(k);
+        if (cur.getMetaKind() == metakind::PARAMETERIZED)
+        {
+          nb << cur.getOperator();
+        }
+        nb.append(children);
+        ret = nb.constructNode();
+      }
+      visited[cur] = ret;
+    }
+  } while (!visit.empty());
+  Assert(visited.find(n) != visited.end());
+  return visited[n];
+}
+
+/** Returns the number of vertices of each color */
+std::map<size_t, size_t> getCellSizes(const std::vector<size_t>& colors)
+{
+  std::map<size_t, size_t> sizes;
+  for (size_t c : colors)
+  {
+    sizes[c]++;
+  }
+  return sizes;
+}
+
+}  // namespace
+
+SymBreak::SymBreak(PreprocessingPassContext* preprocContext)
+    : PreprocessingPass(preprocContext, "sym-break"), d_numColors(0)
+{
+}
+
+SymBreak::Statistics::Statistics()
+    : d_numSymmetries(smtStatisticsRegistry().registerInt(
+        "preprocessing::passes::SymBreak::NumSymmetries")),
+      d_numFailed(smtStatisticsRegistry().registerInt(
+          "preprocessing::passes::SymBreak::NumFailed")),
+      d_numConstraints(smtStatisticsRegistry().registerInt(
+          "preprocessing::passes::SymBreak::NumConstraints"))
+{
+}
+
+PreprocessingPassResult SymBreak::applyInternal(
+    AssertionPipeline* assertionsToPreprocess)
+{
+  const std::vector<Node>& assertions = assertionsToPreprocess->ref();
+  if (!buildGraph(assertions))
+  {
+    Trace("sym-break") << "SymBreak: graph is too large" << std::endl;
+    return PreprocessingPassResult::NO_CONFLICT;
+  }
+  std::unordered_set<Node, NodeHashFunction> aset;
+  for (const Node& a : assertions)
+  {
+    aset.insert(normalize(a));
+  }
+  std::vector<size_t> colors = d_initColors;
+  d_colorIds.clear();
+  refine(colors);
+  std::vector<Permutation> gens;
+  size_t nsearches = 0;
+  size_t step = 0;
+  while (nsearches < s_maxSearches)
+  {
+    // the first constant in a non-singleton cell
+    std::map<size_t, std::vector<size_t>> cells;
+    for (size_t s : d_symbols)
+    {
+      cells[colors[s]].push_back(s);
+    }
+    const std::vector<size_t>* cell = nullptr;
+    for (size_t s : d_symbols)
+    {
+      if (cells[colors[s]].size() > 1)
+      {
+        cell = &cells[colors[s]];
+        break;
+      }
+    }
+    if (cell == nullptr)
+    {
+      break;
+    }
+    size_t a = (*cell)[0];
+    Trace("sym-break") << "SymBreak: map " << d_terms[a] << " to a cell of "
+                       << cell->size() << " constants" << std::endl;
+    // the orbit of a under the generators that fix the individualized
+    // constants
+    std::unordered_set<size_t> orbit;
+    orbit.insert(a);
+    std::vector<Permutation> levelGens;
+    for (size_t b : *cell)
+    {
+      if (orbit.find(b) != orbit.end())
+      {
+        continue;
+      }
+      if (nsearches >= s_maxSearches)
+      {
+        break;
+      }
+      nsearches++;
+      Permutation perm;
+      if (!findPermutation(colors, a, b, step, perm)
+          || !isSymmetry(assertions, aset, perm))
+      {
+        ++(d_statistics.d_numFailed);
+        continue;
+      }
+      Trace("sym-break") << "...found symmetry mapping " << d_terms[a]
+                         << " to " << d_terms[b] << std::endl;
+      ++(d_statistics.d_numSymmetries);
+      gens.push_back(perm);
+      levelGens.push_back(perm);
+      // close the orbit under the generators of this level
+      std::vector<size_t> toProcess(orbit.begin(), orbit.end());
+      while (!toProcess.empty())
+      {
+        size_t cur = toProcess.back();
+        toProcess.pop_back();
+        for (const Permutation& g : levelGens)
+        {
+          Permutation::const_iterator it = g.find(cur);
+          if (it != g.end() && orbit.insert(it->second).second)
+          {
+            toProcess.push_back(it->second);
+          }
+        }
+      }
+    }
+    // search for the generators of the stabilizer of a
+    individualize(colors, a, step);
+    step++;
+    nsearches++;
+    d_colorIds.clear();
+    refine(colors);
+  }
+  std::vector<Node> constraints;
+  std::set<TypeNode> sorts;
+  mkValuePrecedence(assertions, aset, gens, constraints, sorts);
+  for (const Permutation& g : gens)
+  {
+    // the values of the constants of sorts in sorts may be permuted by the
+    // value precedence constraints, which must not invalidate the lex-leader
+    // constraints
+    bool movesSort = false;
+    for (const std::pair<const size_t, size_t>& p : g)
+    {
+      if (sorts.find(d_terms[p.first].getType()) != sorts.end())
+      {
+        movesSort = true;
+        break;
+      }
+    }
+    if (movesSort)
+    {
+      continue;
+    }
+    Node ll = mkLexLeader(g);
+    if (!ll.isNull())
+    {
+      constraints.push_back(ll);
+    }
+  }
+  for (const Node& c : constraints)
+  {
+    Trace("sym-break") << "SymBreak: add " << c << std::endl;
+    assertionsToPreprocess->push_back(Rewriter::rewrite(c));
+    ++(d_statistics.d_numConstraints);
+  }
+  return PreprocessingPassResult::NO_CONFLICT;
+}
+
+bool SymBreak::buildGraph(const std::vector<Node>& assertions)
+{
+  d_terms.clear();
+  d_termIndex.clear();
+  d_children.clear();
+  d_comm.clear();
+  d_parents.clear();
+  d_symbols.clear();
+  d_initColors.clear();
+  d_initColorIds.clear();
+  d_colorIds.clear();
+  d_numColors = 0;
+  std::unordered_set<Node, NodeHashFunction> roots(assertions.begin(),
+                                                   assertions.end());
+  // collect the subterms in post-order
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  std::unordered_map<TNode, bool, TNodeHashFunction> visited;
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    std::unordered_map<TNode, bool, TNodeHashFunction>::iterator it =
+        visited.find(cur);
+    if (it == visited.end())
+    {
+      visited[cur] = false;
+      visit.insert(visit.end(), cur.begin(), cur.end());
+      continue;
+    }
+    visit.pop_back();
+    if (it->second)
+    {
+      continue;
+    }
+    it->second = true;
+    if (d_terms.size() >= s_maxVertices)
+    {
+      return false;
+    }
+    size_t v = d_terms.size();
+    d_terms.push_back(cur);
+    d_termIndex[cur] = v;
+    d_children.emplace_back();
+    d_parents.emplace_back();
+    Kind k = cur.getKind();
+    d_comm.push_back(quantifiers::TermUtil::isComm(k));
+    for (size_t i = 0, nchild = cur.getNumChildren(); i < nchild; i++)
+    {
+      size_t c = d_termIndex[cur[i]];
+      d_children[v].push_back(c);
+      d_parents[c].emplace_back(v, d_comm[v] ? 0 : i + 1);
+    }
+    // the initial color
+    bool isSymbol = cur.isVar() && k != BOUND_VARIABLE
+                    && !cur.getType().isFunction();
+    Node op;
+    if (isSymbol)
+    {
+      d_symbols.push_back(v);
+    }
+    else if (cur.getNumChildren() == 0)
+    {
+      op = cur;
+    }
+    else if (cur.hasOperator())
+    {
+      op = cur.getOperator();
+    }
+    std::tuple<bool, Kind, TypeNode, Node> key(
+        roots.find(cur) != roots.end(), k, cur.getType(), op);
+    std::map<std::tuple<bool, Kind, TypeNode, Node>, size_t>::iterator itc =
+        d_initColorIds.find(key);
+    if (itc == d_initColorIds.end())
+    {
+      d_initColorIds[key] = d_numColors;
+      d_initColors.push_back(d_numColors);
+      d_numColors++;
+    }
+    else
+    {
+      d_initColors.push_back(itc->second);
+    }
+  }
+  std::sort(d_symbols.begin(), d_symbols.end(), [this](size_t a, size_t b) {
+    return d_terms[a] < d_terms[b];
+  });
+  return true;
+}
+
+size_t SymBreak::getColor(const std::vector<size_t>& sig)
+{
+  std::map<std::vector<size_t>, size_t>::iterator it = d_colorIds.find(sig);
+  if (it != d_colorIds.end())
+  {
+    return it->second;
+  }
+  size_t color = d_numColors++;
+  d_colorIds[sig] = color;
+  return color;
+}
+
+size_t SymBreak::refineStep(std::vector<size_t>& colors)
+{
+  std::vector<size_t> next(colors.size());
+  std::unordered_set<size_t> ncolors;
+  std::vector<size_t> sig;
+  std::vector<size_t> ccolors;
+  std::vector<std::pair<size_t, size_t>> pcolors;
+  for (size_t v = 0, nvertices = colors.size(); v < nvertices; v++)
+  {
+    sig.clear();
+    sig.push_back(0);
+    sig.push_back(colors[v]);
+    ccolors.clear();
+    for (size_t c : d_children[v])
+    {
+      ccolors.push_back(colors[c]);
+    }
+    if (d_comm[v])
+    {
+      std::sort(ccolors.begin(), ccolors.end());
+    }
+    sig.push_back(ccolors.size());
+    sig.insert(sig.end(), ccolors.begin(), ccolors.end());
+    pcolors.clear();
+    for (const std::pair<size_t, size_t>& p : d_parents[v])
+    {
+      pcolors.emplace_back(colors[p.first], p.second);
+    }
+    std::sort(pcolors.begin(), pcolors.end());
+    for (const std::pair<size_t, size_t>& pc : pcolors)
+    {
+      sig.push_back(pc.first);
+      sig.push_back(pc.second);
+    }
+    next[v] = getColor(sig);
+    ncolors.insert(next[v]);
+  }
+  colors.swap(next);
+  return ncolors.size();
+}
+
+void SymBreak::refine(std::vector<size_t>& colors)
+{
+  size_t ncolors = getCellSizes(colors).size();
+  size_t nncolors;
+  while ((nncolors = refineStep(colors)) != ncolors)
+  {
+    ncolors = nncolors;
+  }
+}
+
+bool SymBreak::refinePair(std::vector<size_t>& c1, std::vector<size_t>& c2)
+{
+  std::map<size_t, size_t> sizes = getCellSizes(c1);
+  if (sizes != getCellSizes(c2))
+  {
+    return false;
+  }
+  size_t ncolors = sizes.size();
+  while (true)
+  {
+    size_t nncolors = refineStep(c1);
+    refineStep(c2);
+    sizes = getCellSizes(c1);
+    if (sizes != getCellSizes(c2))
+    {
+      return false;
+    }
+    if (nncolors == ncolors)
+    {
+      return true;
+    }
+    ncolors = nncolors;
+  }
+}
+
+void SymBreak::individualize(std::vector<size_t>& colors, size_t v, size_t step)
+{
+  std::vector<size_t> sig;
+  sig.push_back(1);
+  sig.push_back(step);
+  sig.push_back(colors[v]);
+  colors[v] = getColor(sig);
+}
+
+bool SymBreak::findPermutation(const std::vector<size_t>& c,
+                               size_t a,
+                               size_t b,
+                               size_t step,
+                               Permutation& perm)
+{
+  d_colorIds.clear();
+  std::vector<size_t> c1 = c;
+  std::vector<size_t> c2 = c;
+  size_t x = a;
+  size_t y = b;
+  while (true)
+  {
+    individualize(c1, x, step);
+    individualize(c2, y, step);
+    step++;
+    if (!refinePair(c1, c2))
+    {
+      return false;
+    }
+    // find the first constant in a non-singleton cell
+    std::map<size_t, size_t> sizes;
+    for (size_t s : d_symbols)
+    {
+      sizes[c1[s]]++;
+    }
+    std::vector<size_t>::const_iterator it =
+        std::find_if(d_symbols.begin(), d_symbols.end(), [&](size_t s) {
+          return sizes[c1[s]] > 1;
+        });
+    if (it == d_symbols.end())
+    {
+      break;
+    }
+    x = *it;
+    // map it to itself if possible
+    if (c2[x] != c1[x])
+    {
+      it = std::find_if(d_symbols.begin(), d_symbols.end(), [&](size_t s) {
+        return c2[s] == c1[x];
+      });
+      Assert(it != d_symbols.end());
+      y = *it;
+    }
+    else
+    {
+      y = x;
+    }
+  }
+  // the constants of each color in c1 and c2 correspond to each other
+  std::map<size_t, size_t> colorToSymbol;
+  for (size_t s : d_symbols)
+  {
+    colorToSymbol[c2[s]] = s;
+  }
+  for (size_t s : d_symbols)
+  {
+    size_t t = colorToSymbol[c1[s]];
+    if (s != t)
+    {
+      perm[s] = t;
+    }
+  }
+  return !perm.empty();
+}
+
+bool SymBreak::isSymmetry(
+    const std::vector<Node>& assertions,
+    const std::unordered_set<Node, NodeHashFunction>& aset,
+    const Permutation& perm)
+{
+  std::vector<Node> vars;
+  std::vector<Node> subs;
+  for (const std::pair<const size_t, size_t>& p : perm)
+  {
+    vars.push_back(d_terms[p.first]);
+    subs.push_back(d_terms[p.second]);
+  }
+  for (const Node& a : assertions)
+  {
+    Node as = normalize(
+        a.substitute(vars.begin(), vars.end(), subs.begin(), subs.end()));
+    if (aset.find(as) == aset.end())
+    {
+      Trace("sym-break-debug")
+          << "...not a symmetry, " << a << " maps to " << as << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+Node SymBreak::mkLexLeader(const Permutation& perm)
+{
+  // the moved constants in the order of d_symbols, up to the first one whose
+  // type is not ordered
+  std::vector<size_t> moved;
+  for (size_t s : d_symbols)
+  {
+    if (perm.find(s) == perm.end())
+    {
+      continue;
+    }
+    if (!isOrderedType(d_terms[s].getType()))
+    {
+      break;
+    }
+    moved.push_back(s);
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Node ret;
+  for (size_t i = moved.size(); i > 0; i--)
+  {
+    Node x = d_terms[moved[i - 1]];
+    Node sx = d_terms[perm.at(moved[i - 1])];
+    Node leq = mkLeq(x, sx);
+    if (ret.isNull())
+    {
+      ret = leq;
+    }
+    else
+    {
+      ret = nm->mkNode(AND, leq, nm->mkNode(IMPLIES, x.eqNode(sx), ret));
+    }
+  }
+  return ret;
+}
+
+void SymBreak::mkValuePrecedence(
+    const std::vector<Node>& assertions,
+    const std::unordered_set<Node, NodeHashFunction>& aset,
+    const std::vector<Permutation>& gens,
+    std::vector<Node>& constraints,
+    std::set<TypeNode>& sorts)
+{
+  // the orbits of the constants under the generators, represented by their
+  // first constant in the order of d_symbols
+  std::unordered_map<size_t, size_t> index;
+  std::unordered_map<size_t, size_t> rep;
+  for (size_t i = 0, nsymbols = d_symbols.size(); i < nsymbols; i++)
+  {
+    index[d_symbols[i]] = i;
+    rep[d_symbols[i]] = d_symbols[i];
+  }
+  std::function<size_t(size_t)> find = [&](size_t s) {
+    if (rep[s] != s)
+    {
+      rep[s] = find(rep[s]);
+    }
+    return rep[s];
+  };
+  for (const Permutation& g : gens)
+  {
+    for (const std::pair<const size_t, size_t>& p : g)
+    {
+      size_t r1 = find(p.first);
+      size_t r2 = find(p.second);
+      if (index[r2] < index[r1])
+      {
+        std::swap(r1, r2);
+      }
+      rep[r2] = r1;
+    }
+  }
+  std::map<size_t, std::vector<size_t>> orbits;
+  for (size_t s : d_symbols)
+  {
+    orbits[find(s)].push_back(s);
+  }
+  // the orbits of each uninterpreted sort
+  std::map<TypeNode, std::vector<std::vector<size_t>*>> sortOrbits;
+  for (std::pair<const size_t, std::vector<size_t>>& o : orbits)
+  {
+    TypeNode tn = d_terms[o.first].getType();
+    if (tn.isSort() && o.second.size() > 1)
+    {
+      sortOrbits[tn].push_back(&o.second);
+    }
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  for (std::pair<const TypeNode, std::vector<std::vector<size_t>*>>& p :
+       sortOrbits)
+  {
+    // the largest orbit whose constants are interchangeable
+    std::stable_sort(p.second.begin(),
+                     p.second.end(),
+                     [](const std::vector<size_t>* o1,
+                        const std::vector<size_t>* o2) {
+                       return o1->size() > o2->size();
+                     });
+    std::vector<size_t> cell;
+    for (const std::vector<size_t>* o : p.second)
+    {
+      cell = *o;
+      if (cell.size() > s_maxPrecedence)
+      {
+        cell.resize(s_maxPrecedence);
+      }
+      // the constants of cell are interchangeable if the transpositions of
+      // neighbors are symmetries, since they generate all permutations of cell
+      for (size_t i = 0, ncell = cell.size(); i + 1 < ncell; i++)
+      {
+        Permutation swap;
+        swap[cell[i]] = cell[i + 1];
+        swap[cell[i + 1]] = cell[i];
+        if (!isSymmetry(assertions, aset, swap))
+        {
+          Trace("sym-break") << "SymBreak: " << d_terms[cell[i]] << " and "
+                             << d_terms[cell[i + 1]]
+                             << " are not interchangeable" << std::endl;
+          ++(d_statistics.d_numFailed);
+          cell.clear();
+          break;
+        }
+      }
+      if (!cell.empty())
+      {
+        break;
+      }
+    }
+    if (cell.empty())
+    {
+      continue;
+    }
+    // the other constants of the sort, which the transpositions fix
+    std::vector<Node> others;
+    for (size_t s : d_symbols)
+    {
+      if (others.size() < s_maxPrecedence && d_terms[s].getType() == p.first
+          && std::find(cell.begin(), cell.end(), s) == cell.end())
+      {
+        others.push_back(d_terms[s]);
+      }
+    }
+    if (others.empty())
+    {
+      continue;
+    }
+    sorts.insert(p.first);
+    for (size_t j = 0, nothers = others.size(); j < nothers; j++)
+    {
+      for (size_t i = 1, ncell = cell.size(); i < ncell; i++)
+      {
+        Node prev = d_terms[cell[i - 1]];
+        std::vector<Node> disj;
+        for (size_t l = 0; l <= j; l++)
+        {
+          disj.push_back(others[l].eqNode(prev));
+        }
+        Node pre = disj.size() == 1 ? disj[0] : nm->mkNode(OR, disj);
+        constraints.push_back(
+            others[j].eqNode(d_terms[cell[i]]).impNode(pre));
+      }
+    }
+  }
+}
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
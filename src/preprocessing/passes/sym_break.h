@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Symmetry detection and lex-leader symmetry breaking.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PREPROCESSING__PASSES__SYM_BREAK_H
+#define CVC5__PREPROCESSING__PASSES__SYM_BREAK_H
+
+#include <map>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+#include "preprocessing/preprocessing_pass.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace preprocessing {
+namespace passes {
+
+/**
+ * Detects permutations of the free constants that map the set of assertions
+ * to itself, and adds lex-leader constraints that exclude all but the
+ * lexicographically smallest models of each orbit.
+ *
+ * The assertions are viewed as a colored graph whose vertices are their
+ * subterms, colored by kind, type and operator, where the free constants are
+ * colored by their type only. Symmetries are searched for like in graph
+ * automorphism tools: the coloring is refined to an equitable one (where
+ * vertices of the same color have the same colors of children, in order for
+ * non-commutative operators, and of parents), and for the first constant a in
+ * a non-singleton cell, we try mapping a to each other constant b of its cell
+ * that is not yet in the orbit of a, by individualizing a and b in two copies
+ * of the coloring and refining them in lockstep, individualizing further
+ * constants until all constants are in singleton cells. This yields a
+ * candidate permutation, which is kept if the assertions are invariant under
+ * it modulo rewriting. Then a is individualized, and generators of its
+ * stabilizer are searched for in the same way.
+ *
+ * The search does not backtrack, so it may miss generators, and it is
+ * bounded by the number of candidates tried and constants individualized.
+ * For each generator s, we add the constraint
+ *   x1 <= s(x1) ^ (x1 = s(x1) => (x2 <= s(x2) ^ (x2 = s(x2) => ...)))
+ * where x1, x2, ... are the constants moved by s, in a fixed order for all
+ * generators, and <= is implication for Booleans, arithmetic <= and
+ * unsigned <= for bit-vectors. The constraint is truncated before the first
+ * constant of another type.
+ *
+ * The values of uninterpreted sorts are not ordered. Instead, for the largest
+ * orbit m1, ..., mk of constants of an uninterpreted sort such that all
+ * permutations of m1, ..., mk are symmetries, we add the value precedence
+ * constraints
+ *   tj = mi => (t1 = m(i-1) v ... v tj = m(i-1))
+ * where t1, t2, ... are the other constants of the sort: m(i-1) is used by
+ * the t's before mi is. Since these constraints may permute the values of
+ * m1, ..., mk, no lex-leader constraint is added for the generators that move
+ * constants of that sort.
+ */
+class SymBreak : public PreprocessingPass
+{
+ public:
+  SymBreak(PreprocessingPassContext* preprocContext);
+
+ protected:
+  PreprocessingPassResult applyInternal(
+      AssertionPipeline* assertionsToPreprocess) override;
+
+ private:
+  /** A permutation of the free constants, as a map of vertices */
+  using Permutation = std::map<size_t, size_t>;
+  /**
+   * Build the colored graph of the assertions. Returns false if it has too
+   * many vertices.
+   */
+  bool buildGraph(const std::vector<Node>& assertions);
+  /** Get the color for the signature sig */
+  size_t getColor(const std::vector<size_t>& sig);
+  /** Refine colors once, returns the number of colors */
+  size_t refineStep(std::vector<size_t>& colors);
+  /** Refine colors until the coloring is equitable */
+  void refine(std::vector<size_t>& colors);
+  /**
+   * Refine c1 and c2 in lockstep until both are equitable. Returns false if
+   * they differ in the number of vertices of some color.
+   */
+  bool refinePair(std::vector<size_t>& c1, std::vector<size_t>& c2);
+  /** Give vertex v a new color, depending on step */
+  void individualize(std::vector<size_t>& colors, size_t v, size_t step);
+  /**
+   * Search for a permutation of the constants that maps a to b, given the
+   * equitable coloring c in which step vertices were individualized. Returns
+   * false if none was found, otherwise stores it in perm.
+   */
+  bool findPermutation(const std::vector<size_t>& c,
+                       size_t a,
+                       size_t b,
+                       size_t step,
+                       Permutation& perm);
+  /**
+   * Returns true if the assertions are invariant under perm, where aset are
+   * the normalized assertions.
+   */
+  bool isSymmetry(const std::vector<Node>& assertions,
+                  const std::unordered_set<Node, NodeHashFunction>& aset,
+                  const Permutation& perm);
+  /** Make the lex-leader constraint for perm, or null if it is trivial */
+  Node mkLexLeader(const Permutation& perm);
+  /**
+   * Make the value precedence constraints for the constants of uninterpreted
+   * sorts, for the orbits of the generators gens, and add them to
+   * constraints. Adds the sorts for which constraints were added to sorts.
+   */
+  void mkValuePrecedence(
+      const std::vector<Node>& assertions,
+      const std::unordered_set<Node, NodeHashFunction>& aset,
+      const std::vector<Permutation>& gens,
+      std::vector<Node>& constraints,
+      std::set<TypeNode>& sorts);
+
+  /** The vertices, i.e. the subterms of the assertions */
+  std::vector<Node> d_terms;
+  std::unordered_map<Node, size_t, NodeHashFunction> d_termIndex;
+  /** The children of each vertex */
+  std::vector<std::vector<size_t>> d_children;
+  /** Whether the order of the children of each vertex does not matter */
+  std::vector<bool> d_comm;
+  /** The parents of each vertex, with the position of the vertex */
+  std::vector<std::vector<std::pair<size_t, size_t>>> d_parents;
+  /** The vertices of the free constants, ordered by their terms */
+  std::vector<size_t> d_symbols;
+  /** The initial coloring */
+  std::vector<size_t> d_initColors;
+  /** The colors of the initial coloring, by root, kind, type and operator */
+  std::map<std::tuple<bool, Kind, TypeNode, Node>, size_t> d_initColorIds;
+  /**
+   * The colors of the refined colorings, by signature. This is cleared before
+   * each search, since only the colorings refined in the same search are
+   * compared.
+   */
+  std::map<std::vector<size_t>, size_t> d_colorIds;
+  /** The number of colors, which is used for the next color */
+  size_t d_numColors;
+
+  struct Statistics
+  {
+    /** The number of symmetries found */
+    IntStat d_numSymmetries;
+    /** The number of candidate permutations that were not symmetries */
+    IntStat d_numFailed;
+    /** The number of lex-leader and value precedence constraints added */
+    IntStat d_numConstraints;
+    Statistics();
+  };
+  Statistics d_statistics;
+};
+
+}  // namespace passes
+}  // namespace preprocessing
+}  // namespace cvc5
+
+#endif /* CVC5__PREPROCESSING__PASSES__SYM_BREAK_H */
@@ -123,7 +123,7 @@ void CvcPrinter::toStreamNode(std::ostream& out,
       break;
     case kind::CONST_BITVECTOR: {
       const BitVector& bv = n.getConst<BitVector>();
-      const Integer& x = bv.getValue();
+      Integer x = bv.getValue();
       out << "0bin";
       unsigned size = bv.getSize();
       while (size-- > 0)
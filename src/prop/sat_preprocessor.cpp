@@ -0,0 +1,858 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * CNF preprocessing in front of an arbitrary SAT solver back end.
+ */
+
+#include "prop/sat_preprocessor.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace prop {
+
+namespace {
+
+/** Effort limits, counted in visited literals. */
+constexpr int64_t s_probeBudget = 10000000;
+constexpr int64_t s_eliminateBudget = 20000000;
+constexpr int64_t s_blockedBudget = 10000000;
+/** Variables with more occurrences in one polarity are not eliminated. */
+constexpr size_t s_maxOccurrences = 16;
+/** Resolvents with more literals prevent the elimination of a variable. */
+constexpr size_t s_maxResolventSize = 32;
+
+}  // namespace
+
+SatPreprocessor::SatPreprocessor(SatSolver* solver,
+                                 StatisticsRegistry& registry,
+                                 const std::string& name)
+    : d_solver(solver),
+      d_hasModel(false),
+      d_preprocessed(false),
+      d_unsat(false),
+      d_unsatByPreprocessing(false),
+      d_statistics(registry, name)
+{
+}
+
+SatPreprocessor::~SatPreprocessor() {}
+
+SatPreprocessor::Lit SatPreprocessor::toLit(SatLiteral lit)
+{
+  return 2 * lit.getSatVariable() + (lit.isNegated() ? 1 : 0);
+}
+
+SatLiteral SatPreprocessor::toSatLiteral(Lit lit)
+{
+  return SatLiteral(var(lit), lit & 1);
+}
+
+void SatPreprocessor::ensureVar(SatVariable v)
+{
+  if (v < d_values.size())
+  {
+    return;
+  }
+  d_values.resize(v + 1, 0);
+  d_isVar.resize(v + 1, false);
+  d_frozen.resize(v + 1, false);
+  d_eliminated.resize(v + 1, false);
+  d_occs.resize(2 * (v + 1));
+}
+
+int8_t SatPreprocessor::litValue(Lit lit) const
+{
+  int8_t val = d_values[var(lit)];
+  return (lit & 1) ? -val : val;
+}
+
+ClauseId SatPreprocessor::addClause(SatClause& clause, bool removable)
+{
+  if (d_preprocessed)
+  {
+    restore();
+    return d_solver->addClause(clause, removable);
+  }
+  std::vector<Lit> lits;
+  for (const SatLiteral& lit : clause)
+  {
+    ensureVar(lit.getSatVariable());
+    lits.push_back(toLit(lit));
+  }
+  ++d_statistics.d_numClausesIn;
+  addInternal(lits);
+  return ClauseIdError;
+}
+
+ClauseId SatPreprocessor::addXorClause(SatClause& clause,
+                                       bool rhs,
+                                       bool removable)
+{
+  Unreachable() << "SatPreprocessor does not support adding XOR clauses.";
+}
+
+SatVariable SatPreprocessor::newVar(bool isTheoryAtom,
+                                    bool preRegister,
+                                    bool canErase)
+{
+  SatVariable v = d_solver->newVar(isTheoryAtom, preRegister, canErase);
+  ensureVar(v);
+  d_isVar[v] = true;
+  d_frozen[v] = isTheoryAtom || !canErase;
+  return v;
+}
+
+SatVariable SatPreprocessor::trueVar()
+{
+  SatVariable v = d_solver->trueVar();
+  ensureVar(v);
+  d_isVar[v] = true;
+  d_frozen[v] = true;
+  return v;
+}
+
+SatVariable SatPreprocessor::falseVar()
+{
+  SatVariable v = d_solver->falseVar();
+  ensureVar(v);
+  d_isVar[v] = true;
+  d_frozen[v] = true;
+  return v;
+}
+
+SatValue SatPreprocessor::solve()
+{
+  if (!prepareSolve({}))
+  {
+    return SAT_VALUE_FALSE;
+  }
+  return finishSolve(d_solver->solve());
+}
+
+SatValue SatPreprocessor::solve(long unsigned int& resource)
+{
+  if (!prepareSolve({}))
+  {
+    return SAT_VALUE_FALSE;
+  }
+  return finishSolve(d_solver->solve(resource));
+}
+
+SatValue SatPreprocessor::solve(const std::vector<SatLiteral>& assumptions)
+{
+  if (!prepareSolve(assumptions))
+  {
+    return SAT_VALUE_FALSE;
+  }
+  return finishSolve(d_solver->solve(assumptions));
+}
+
+void SatPreprocessor::getUnsatAssumptions(
+    std::vector<SatLiteral>& assumptions)
+{
+  // The clauses are unsatisfiable without any assumptions.
+  if (!d_unsatByPreprocessing)
+  {
+    d_solver->getUnsatAssumptions(assumptions);
+  }
+}
+
+void SatPreprocessor::interrupt() { d_solver->interrupt(); }
+
+SatValue SatPreprocessor::value(SatLiteral l)
+{
+  if (!d_hasModel || l.getSatVariable() >= d_model.size())
+  {
+    return d_solver->value(l);
+  }
+  SatValue val = d_model[l.getSatVariable()];
+  return l.isNegated() ? invertValue(val) : val;
+}
+
+SatValue SatPreprocessor::modelValue(SatLiteral l)
+{
+  if (!d_hasModel || l.getSatVariable() >= d_model.size())
+  {
+    return d_solver->modelValue(l);
+  }
+  return value(l);
+}
+
+unsigned SatPreprocessor::getAssertionLevel() const
+{
+  return d_solver->getAssertionLevel();
+}
+
+bool SatPreprocessor::ok() const { return !d_unsat && d_solver->ok(); }
+
+void SatPreprocessor::addInternal(std::vector<Lit> lits)
+{
+  std::sort(lits.begin(), lits.end());
+  lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+  for (size_t i = 1, size = lits.size(); i < size; ++i)
+  {
+    if (lits[i] == neg(lits[i - 1]))
+    {
+      // tautology
+      return;
+    }
+  }
+  if (lits.empty())
+  {
+    d_unsat = true;
+    return;
+  }
+  if (lits.size() == 1)
+  {
+    d_units.push_back(lits[0]);
+  }
+  size_t i = d_clauses.size();
+  for (Lit lit : lits)
+  {
+    d_occs[lit].push_back(i);
+  }
+  d_clauses.push_back(Clause{std::move(lits), false});
+}
+
+void SatPreprocessor::removeClause(size_t i)
+{
+  d_clauses[i].d_removed = true;
+}
+
+std::vector<size_t> SatPreprocessor::getOccurrences(Lit lit) const
+{
+  std::vector<size_t> res;
+  for (size_t i : d_occs[lit])
+  {
+    if (!d_clauses[i].d_removed)
+    {
+      res.push_back(i);
+    }
+  }
+  return res;
+}
+
+bool SatPreprocessor::prepareSolve(const std::vector<SatLiteral>& assumptions)
+{
+  d_hasModel = false;
+  d_unsatByPreprocessing = false;
+  if (!d_preprocessed)
+  {
+    for (const SatLiteral& lit : assumptions)
+    {
+      ensureVar(lit.getSatVariable());
+      d_frozen[lit.getSatVariable()] = true;
+    }
+    preprocess();
+  }
+  else if (!assumptions.empty())
+  {
+    restore();
+  }
+  d_unsatByPreprocessing = d_unsat;
+  return !d_unsat;
+}
+
+SatValue SatPreprocessor::finishSolve(SatValue result)
+{
+  if (result == SAT_VALUE_TRUE)
+  {
+    reconstruct();
+  }
+  return result;
+}
+
+void SatPreprocessor::preprocess()
+{
+  Assert(!d_preprocessed);
+  d_preprocessed = true;
+  {
+    TimerStat::CodeTimer timer(d_statistics.d_preprocessTime);
+    if (!d_unsat && propagate())
+    {
+      probe();
+    }
+    if (!d_unsat)
+    {
+      substitute();
+    }
+    if (!d_unsat)
+    {
+      eliminate();
+    }
+    if (!d_unsat)
+    {
+      eliminateBlocked();
+    }
+  }
+  Trace("sat-preprocess") << "SatPreprocessor: " << d_clauses.size()
+                          << " clauses, unsat: " << d_unsat << std::endl;
+  if (d_unsat)
+  {
+    d_clauses.clear();
+    d_occs.clear();
+    return;
+  }
+
+  // Pass the simplified clauses on to the back end.
+  for (size_t v = 0, size = d_values.size(); v < size; ++v)
+  {
+    if (d_values[v] != 0)
+    {
+      SatClause unit{SatLiteral(v, d_values[v] < 0)};
+      d_solver->addClause(unit, false);
+      ++d_statistics.d_numClausesOut;
+    }
+  }
+  for (const Clause& c : d_clauses)
+  {
+    if (c.d_removed)
+    {
+      continue;
+    }
+    SatClause clause;
+    for (Lit lit : c.d_lits)
+    {
+      clause.push_back(toSatLiteral(lit));
+    }
+    d_solver->addClause(clause, false);
+    ++d_statistics.d_numClausesOut;
+  }
+  d_clauses.clear();
+  d_occs.clear();
+}
+
+bool SatPreprocessor::propagate()
+{
+  while (!d_units.empty())
+  {
+    Lit lit = d_units.back();
+    d_units.pop_back();
+    int8_t val = litValue(lit);
+    if (val > 0)
+    {
+      continue;
+    }
+    if (val < 0)
+    {
+      d_unsat = true;
+      return false;
+    }
+    d_values[var(lit)] = (lit & 1) ? -1 : 1;
+    for (size_t i : d_occs[lit])
+    {
+      removeClause(i);
+    }
+    for (size_t i : d_occs[neg(lit)])
+    {
+      Clause& c = d_clauses[i];
+      if (c.d_removed)
+      {
+        continue;
+      }
+      c.d_lits.erase(std::find(c.d_lits.begin(), c.d_lits.end(), neg(lit)));
+      if (c.d_lits.empty())
+      {
+        d_unsat = true;
+        return false;
+      }
+      if (c.d_lits.size() == 1)
+      {
+        d_units.push_back(c.d_lits[0]);
+      }
+    }
+    d_occs[lit].clear();
+    d_occs[neg(lit)].clear();
+  }
+  return true;
+}
+
+void SatPreprocessor::probe()
+{
+  int64_t budget = s_probeBudget;
+  for (SatVariable v = 0, size = d_values.size(); v < size && budget > 0; ++v)
+  {
+    for (Lit lit : {Lit(2 * v), Lit(2 * v + 1)})
+    {
+      // Only probe literals that imply other literals via binary clauses.
+      if (d_values[v] != 0 || d_eliminated[v])
+      {
+        break;
+      }
+      bool hasBinary = false;
+      for (size_t i : d_occs[neg(lit)])
+      {
+        if (!d_clauses[i].d_removed && d_clauses[i].d_lits.size() == 2)
+        {
+          hasBinary = true;
+          break;
+        }
+      }
+      if (hasBinary && probeLiteral(lit, budget))
+      {
+        ++d_statistics.d_numFailedLiterals;
+        d_units.push_back(neg(lit));
+        if (!propagate())
+        {
+          return;
+        }
+      }
+    }
+  }
+}
+
+bool SatPreprocessor::probeLiteral(Lit lit, int64_t& budget)
+{
+  // Unit propagation on the clause database with a temporary assignment on
+  // top of the top-level assignment.
+  std::vector<Lit> trail{lit};
+  std::vector<int8_t>& values = d_values;
+  values[var(lit)] = (lit & 1) ? -1 : 1;
+  bool conflict = false;
+  for (size_t next = 0; next < trail.size() && !conflict; ++next)
+  {
+    for (size_t i : d_occs[neg(trail[next])])
+    {
+      const Clause& c = d_clauses[i];
+      if (c.d_removed)
+      {
+        continue;
+      }
+      budget -= c.d_lits.size();
+      Lit unassigned = 0;
+      size_t numUnassigned = 0;
+      bool sat = false;
+      for (Lit l : c.d_lits)
+      {
+        int8_t val = litValue(l);
+        if (val > 0)
+        {
+          sat = true;
+          break;
+        }
+        if (val == 0)
+        {
+          unassigned = l;
+          ++numUnassigned;
+        }
+      }
+      if (sat || numUnassigned > 1)
+      {
+        continue;
+      }
+      if (numUnassigned == 0)
+      {
+        conflict = true;
+        break;
+      }
+      values[var(unassigned)] = (unassigned & 1) ? -1 : 1;
+      trail.push_back(unassigned);
+    }
+  }
+  for (Lit l : trail)
+  {
+    values[var(l)] = 0;
+  }
+  return conflict;
+}
+
+void SatPreprocessor::substitute()
+{
+  // Tarjan's algorithm on the binary implication graph, where a binary clause
+  // (a b) induces the edges -a -> b and -b -> a.
+  size_t numLits = d_occs.size();
+  std::vector<std::vector<Lit>> edges(numLits);
+  for (const Clause& c : d_clauses)
+  {
+    if (!c.d_removed && c.d_lits.size() == 2)
+    {
+      edges[neg(c.d_lits[0])].push_back(c.d_lits[1]);
+      edges[neg(c.d_lits[1])].push_back(c.d_lits[0]);
+    }
+  }
+  constexpr size_t undef = static_cast<size_t>(-1);
+  std::vector<size_t> index(numLits, undef), lowlink(numLits, 0);
+  std::vector<bool> onStack(numLits, false);
+  std::vector<Lit> stack;
+  std::vector<Lit> repr(numLits);
+  for (Lit l = 0; l < numLits; ++l)
+  {
+    repr[l] = l;
+  }
+  size_t counter = 0;
+  for (Lit root = 0; root < numLits; ++root)
+  {
+    if (index[root] != undef || edges[root].empty())
+    {
+      continue;
+    }
+    // Iterative DFS, frames are pairs of literal and next edge.
+    std::vector<std::pair<Lit, size_t>> dfs{{root, 0}};
+    index[root] = lowlink[root] = counter++;
+    stack.push_back(root);
+    onStack[root] = true;
+    while (!dfs.empty())
+    {
+      Lit cur = dfs.back().first;
+      size_t& edge = dfs.back().second;
+      if (edge < edges[cur].size())
+      {
+        Lit succ = edges[cur][edge++];
+        if (index[succ] == undef)
+        {
+          index[succ] = lowlink[succ] = counter++;
+          stack.push_back(succ);
+          onStack[succ] = true;
+          dfs.emplace_back(succ, 0);
+        }
+        else if (onStack[succ])
+        {
+          lowlink[cur] = std::min(lowlink[cur], index[succ]);
+        }
+        continue;
+      }
+      dfs.pop_back();
+      if (!dfs.empty())
+      {
+        Lit parent = dfs.back().first;
+        lowlink[parent] = std::min(lowlink[parent], lowlink[cur]);
+      }
+      if (lowlink[cur] != index[cur])
+      {
+        continue;
+      }
+      // Pop the component and pick its representative: a frozen literal if
+      // there is one, otherwise the literal with the smallest variable. The
+      // component of the negated literals picks the negated representative.
+      std::vector<Lit> component;
+      Lit l;
+      do
+      {
+        l = stack.back();
+        stack.pop_back();
+        onStack[l] = false;
+        component.push_back(l);
+      } while (l != cur);
+      Lit rep = component[0];
+      for (Lit m : component)
+      {
+        bool mFrozen = d_frozen[var(m)], repFrozen = d_frozen[var(rep)];
+        if ((mFrozen && !repFrozen)
+            || (mFrozen == repFrozen && var(m) < var(rep)))
+        {
+          rep = m;
+        }
+      }
+      std::sort(component.begin(), component.end());
+      for (Lit m : component)
+      {
+        if (std::binary_search(component.begin(), component.end(), neg(m)))
+        {
+          // m and its negation are equivalent
+          d_unsat = true;
+          return;
+        }
+        repr[m] = rep;
+      }
+    }
+  }
+
+  std::vector<size_t> rewrite;
+  for (SatVariable v = 0, size = d_values.size(); v < size; ++v)
+  {
+    Lit pos = 2 * v;
+    if (repr[pos] == pos || d_frozen[v] || d_values[v] != 0)
+    {
+      continue;
+    }
+    Assert(repr[neg(pos)] == neg(repr[pos]));
+    ++d_statistics.d_numSubstituted;
+    d_eliminated[v] = true;
+    // v is equivalent to its representative r: (v -r) and (-v r)
+    Lit r = repr[pos];
+    d_reconstruction.emplace_back(pos, std::vector<Lit>{pos, neg(r)});
+    d_reconstruction.emplace_back(neg(pos), std::vector<Lit>{neg(pos), r});
+    for (Lit lit : {pos, neg(pos)})
+    {
+      std::vector<size_t> occs = getOccurrences(lit);
+      rewrite.insert(rewrite.end(), occs.begin(), occs.end());
+    }
+  }
+  std::sort(rewrite.begin(), rewrite.end());
+  rewrite.erase(std::unique(rewrite.begin(), rewrite.end()), rewrite.end());
+  for (size_t i : rewrite)
+  {
+    std::vector<Lit> lits;
+    for (Lit lit : d_clauses[i].d_lits)
+    {
+      lits.push_back(d_eliminated[var(lit)] ? repr[lit] : lit);
+    }
+    removeClause(i);
+    addInternal(lits);
+    if (d_unsat)
+    {
+      return;
+    }
+  }
+  propagate();
+}
+
+void SatPreprocessor::eliminate()
+{
+  std::vector<std::pair<size_t, SatVariable>> candidates;
+  for (SatVariable v = 0, size = d_values.size(); v < size; ++v)
+  {
+    if (!d_frozen[v] && !d_eliminated[v] && d_values[v] == 0)
+    {
+      size_t numPos = getOccurrences(2 * v).size();
+      size_t numNeg = getOccurrences(2 * v + 1).size();
+      if (numPos <= s_maxOccurrences && numNeg <= s_maxOccurrences)
+      {
+        candidates.emplace_back(numPos * numNeg, v);
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  int64_t budget = s_eliminateBudget;
+  for (const auto& candidate : candidates)
+  {
+    if (budget <= 0)
+    {
+      break;
+    }
+    SatVariable v = candidate.second;
+    if (d_values[v] == 0 && eliminateVar(v, budget))
+    {
+      ++d_statistics.d_numEliminated;
+      if (!propagate())
+      {
+        return;
+      }
+    }
+  }
+}
+
+bool SatPreprocessor::eliminateVar(SatVariable v, int64_t& budget)
+{
+  Lit pos = 2 * v;
+  std::vector<size_t> posOccs = getOccurrences(pos);
+  std::vector<size_t> negOccs = getOccurrences(neg(pos));
+  if (posOccs.size() > s_maxOccurrences || negOccs.size() > s_maxOccurrences)
+  {
+    return false;
+  }
+  // Eliminate v only if it does not increase the number of clauses.
+  size_t limit = posOccs.size() + negOccs.size();
+  std::vector<std::vector<Lit>> resolvents;
+  for (size_t p : posOccs)
+  {
+    for (size_t n : negOccs)
+    {
+      const std::vector<Lit>& a = d_clauses[p].d_lits;
+      const std::vector<Lit>& b = d_clauses[n].d_lits;
+      budget -= a.size() + b.size();
+      std::vector<Lit> resolvent;
+      for (Lit lit : a)
+      {
+        if (lit != pos)
+        {
+          resolvent.push_back(lit);
+        }
+      }
+      for (Lit lit : b)
+      {
+        if (lit != neg(pos))
+        {
+          resolvent.push_back(lit);
+        }
+      }
+      std::sort(resolvent.begin(), resolvent.end());
+      resolvent.erase(std::unique(resolvent.begin(), resolvent.end()),
+                      resolvent.end());
+      bool tautology = false;
+      for (size_t i = 1, size = resolvent.size(); i < size; ++i)
+      {
+        if (resolvent[i] == neg(resolvent[i - 1]))
+        {
+          tautology = true;
+          break;
+        }
+      }
+      if (tautology)
+      {
+        continue;
+      }
+      if (resolvent.size() > s_maxResolventSize
+          || resolvents.size() == limit)
+      {
+        return false;
+      }
+      resolvents.push_back(std::move(resolvent));
+    }
+  }
+
+  d_eliminated[v] = true;
+  for (size_t i : posOccs)
+  {
+    d_reconstruction.emplace_back(pos, d_clauses[i].d_lits);
+    removeClause(i);
+  }
+  for (size_t i : negOccs)
+  {
+    d_reconstruction.emplace_back(neg(pos), d_clauses[i].d_lits);
+    removeClause(i);
+  }
+  for (std::vector<Lit>& resolvent : resolvents)
+  {
+    addInternal(std::move(resolvent));
+  }
+  return true;
+}
+
+void SatPreprocessor::eliminateBlocked()
+{
+  int64_t budget = s_blockedBudget;
+  std::vector<bool> marked(d_occs.size(), false);
+  for (size_t i = 0, size = d_clauses.size(); i < size && budget > 0; ++i)
+  {
+    Clause& c = d_clauses[i];
+    if (c.d_removed)
+    {
+      continue;
+    }
+    for (Lit lit : c.d_lits)
+    {
+      marked[lit] = true;
+    }
+    for (Lit lit : c.d_lits)
+    {
+      if (d_frozen[var(lit)])
+      {
+        continue;
+      }
+      // c is blocked on lit if every resolvent on lit is a tautology.
+      bool blocked = true;
+      for (size_t j : d_occs[neg(lit)])
+      {
+        const Clause& d = d_clauses[j];
+        if (d.d_removed)
+        {
+          continue;
+        }
+        budget -= d.d_lits.size();
+        bool tautology = false;
+        for (Lit l : d.d_lits)
+        {
+          if (l != neg(lit) && marked[neg(l)])
+          {
+            tautology = true;
+            break;
+          }
+        }
+        if (!tautology)
+        {
+          blocked = false;
+          break;
+        }
+      }
+      if (blocked)
+      {
+        ++d_statistics.d_numBlocked;
+        d_reconstruction.emplace_back(lit, c.d_lits);
+        removeClause(i);
+        break;
+      }
+    }
+    for (Lit lit : c.d_lits)
+    {
+      marked[lit] = false;
+    }
+  }
+}
+
+void SatPreprocessor::reconstruct()
+{
+  d_model.assign(d_values.size(), SAT_VALUE_UNKNOWN);
+  for (SatVariable v = 0, size = d_values.size(); v < size; ++v)
+  {
+    if (d_isVar[v])
+    {
+      d_model[v] = d_solver->value(SatLiteral(v));
+    }
+    if (d_eliminated[v] && d_model[v] == SAT_VALUE_UNKNOWN)
+    {
+      d_model[v] = SAT_VALUE_FALSE;
+    }
+  }
+  auto isTrue = [this](Lit lit) {
+    SatValue val = d_model[var(lit)];
+    return (lit & 1) ? val == SAT_VALUE_FALSE : val == SAT_VALUE_TRUE;
+  };
+  for (auto it = d_reconstruction.rbegin(); it != d_reconstruction.rend();
+       ++it)
+  {
+    if (std::none_of(it->second.begin(), it->second.end(), isTrue))
+    {
+      Lit witness = it->first;
+      d_model[var(witness)] = (witness & 1) ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+    }
+  }
+  d_hasModel = true;
+}
+
+void SatPreprocessor::restore()
+{
+  d_hasModel = false;
+  if (d_reconstruction.empty())
+  {
+    return;
+  }
+  Trace("sat-preprocess") << "SatPreprocessor: restore "
+                          << d_reconstruction.size() << " clauses" << std::endl;
+  for (const auto& entry : d_reconstruction)
+  {
+    SatClause clause;
+    for (Lit lit : entry.second)
+    {
+      clause.push_back(toSatLiteral(lit));
+    }
+    d_solver->addClause(clause, false);
+    ++d_statistics.d_numRestored;
+  }
+  d_reconstruction.clear();
+}
+
+SatPreprocessor::Statistics::Statistics(StatisticsRegistry& registry,
+                                        const std::string& prefix)
+    : d_numFailedLiterals(
+          registry.registerInt(prefix + "preprocessor::failed_literals")),
+      d_numSubstituted(
+          registry.registerInt(prefix + "preprocessor::substituted_vars")),
+      d_numEliminated(
+          registry.registerInt(prefix + "preprocessor::eliminated_vars")),
+      d_numBlocked(
+          registry.registerInt(prefix + "preprocessor::blocked_clauses")),
+      d_numClausesIn(registry.registerInt(prefix + "preprocessor::clauses_in")),
+      d_numClausesOut(
+          registry.registerInt(prefix + "preprocessor::clauses_out")),
+      d_numRestored(
+          registry.registerInt(prefix + "preprocessor::restored_clauses")),
+      d_preprocessTime(registry.registerTimer(prefix + "preprocessor::time"))
+{
+}
+
+}  // namespace prop
+}  // namespace cvc5
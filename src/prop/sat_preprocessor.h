@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * CNF preprocessing in front of an arbitrary SAT solver back end.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PROP__SAT_PREPROCESSOR_H
+#define CVC5__PROP__SAT_PREPROCESSOR_H
+
+#include <memory>
+#include <vector>
+
+#include "prop/sat_solver.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace prop {
+
+/**
+ * A SAT solver that simplifies the clauses added before the first call to
+ * solve() and passes the simplified clauses on to a back end SAT solver:
+ *
+ * - top-level unit propagation,
+ * - failed literal probing,
+ * - equivalent literal substitution (strongly connected components of the
+ *   binary implication graph),
+ * - bounded variable elimination, and
+ * - blocked clause elimination.
+ *
+ * Variables that were created with canErase = false, the constant variables
+ * and the variables of the assumptions of the first call to solve() are
+ * frozen, i.e., they are never eliminated or substituted. The values of
+ * eliminated variables are reconstructed from the model of the back end, so
+ * value() and modelValue() return a model of the original clauses.
+ *
+ * Preprocessing is done only once. If clauses or assumptions are added after
+ * the first call to solve(), the clauses removed by preprocessing are added
+ * to the back end again and all further calls are passed on unchanged.
+ */
+class SatPreprocessor : public SatSolver
+{
+ public:
+  /** Takes ownership of the back end solver. */
+  SatPreprocessor(SatSolver* solver,
+                  StatisticsRegistry& registry,
+                  const std::string& name = "");
+  ~SatPreprocessor() override;
+
+  ClauseId addClause(SatClause& clause, bool removable) override;
+
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override;
+
+  SatVariable newVar(bool isTheoryAtom = false,
+                     bool preRegister = false,
+                     bool canErase = true) override;
+
+  SatVariable trueVar() override;
+
+  SatVariable falseVar() override;
+
+  SatValue solve() override;
+  SatValue solve(long unsigned int& resource) override;
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override;
+  void getUnsatAssumptions(std::vector<SatLiteral>& assumptions) override;
+
+  void interrupt() override;
+
+  SatValue value(SatLiteral l) override;
+
+  SatValue modelValue(SatLiteral l) override;
+
+  unsigned getAssertionLevel() const override;
+
+  bool ok() const override;
+
+ private:
+  /** Literals are encoded as 2 * variable + negated. */
+  using Lit = uint32_t;
+
+  struct Clause
+  {
+    std::vector<Lit> d_lits;
+    bool d_removed;
+  };
+
+  static Lit toLit(SatLiteral lit);
+  static SatLiteral toSatLiteral(Lit lit);
+  static Lit neg(Lit lit) { return lit ^ 1; }
+  static SatVariable var(Lit lit) { return lit >> 1; }
+
+  /** Make sure that the data structures cover variable v. */
+  void ensureVar(SatVariable v);
+  /** The top-level value of lit: 1 (true), -1 (false) or 0 (unassigned). */
+  int8_t litValue(Lit lit) const;
+
+  /**
+   * Add a clause to the clause database. Removes duplicate literals and
+   * ignores tautologies, queues units and records the empty clause.
+   */
+  void addInternal(std::vector<Lit> lits);
+  /** Mark clause i as removed. */
+  void removeClause(size_t i);
+  /** The clauses of d_occs[lit] that are not removed. */
+  std::vector<size_t> getOccurrences(Lit lit) const;
+
+  /**
+   * Prepare a call to solve() of the back end. Runs the preprocessing on the
+   * first call, and restores the removed clauses if needed on later calls.
+   * Returns false if the clauses are unsatisfiable.
+   */
+  bool prepareSolve(const std::vector<SatLiteral>& assumptions);
+  /** Reconstruct the model if the back end returned sat. */
+  SatValue finishSolve(SatValue result);
+
+  /** Run all preprocessing techniques and add the result to the back end. */
+  void preprocess();
+  /** Propagate the queued units, returns false on conflict. */
+  bool propagate();
+  /** Failed literal probing, adds the negation of failed literals. */
+  void probe();
+  /** Returns true if propagating lit on the clause database fails. */
+  bool probeLiteral(Lit lit, int64_t& budget);
+  /** Equivalent literal substitution. */
+  void substitute();
+  /** Bounded variable elimination. */
+  void eliminate();
+  /** Returns true if variable v was eliminated. */
+  bool eliminateVar(SatVariable v, int64_t& budget);
+  /** Blocked clause elimination. */
+  void eliminateBlocked();
+
+  /** Compute the values of the eliminated variables in d_model. */
+  void reconstruct();
+  /** Add the removed clauses to the back end again, see class comment. */
+  void restore();
+
+  /** The back end. */
+  std::unique_ptr<SatSolver> d_solver;
+
+  /** The clause database, only used before the first call to solve(). */
+  std::vector<Clause> d_clauses;
+  /** Maps literals to the clauses in which they occur, possibly removed. */
+  std::vector<std::vector<size_t>> d_occs;
+  /** The top-level assignment, 1 (true), -1 (false) or 0 (unassigned). */
+  std::vector<int8_t> d_values;
+  /** Units that still need to be propagated. */
+  std::vector<Lit> d_units;
+  /** Variables that were created via newVar(), trueVar() or falseVar(). */
+  std::vector<bool> d_isVar;
+  /** Variables that must not be eliminated. */
+  std::vector<bool> d_frozen;
+  /** Variables that were eliminated or substituted. */
+  std::vector<bool> d_eliminated;
+  /**
+   * Removed clauses with their witness literal, which is set to true if the
+   * clause is falsified during model reconstruction (in reverse order).
+   */
+  std::vector<std::pair<Lit, std::vector<Lit>>> d_reconstruction;
+  /** The reconstructed model, valid if d_hasModel is true. */
+  std::vector<SatValue> d_model;
+  bool d_hasModel;
+
+  /** True if preprocessing was done. */
+  bool d_preprocessed;
+  /** True if the clauses were found unsatisfiable during preprocessing. */
+  bool d_unsat;
+  /** True if the last call to solve() was answered by the preprocessor. */
+  bool d_unsatByPreprocessing;
+
+  struct Statistics
+  {
+    IntStat d_numFailedLiterals;
+    IntStat d_numSubstituted;
+    IntStat d_numEliminated;
+    IntStat d_numBlocked;
+    IntStat d_numClausesIn;
+    IntStat d_numClausesOut;
+    IntStat d_numRestored;
+    TimerStat d_preprocessTime;
+    Statistics(StatisticsRegistry& registry, const std::string& prefix);
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace prop
+}  // namespace cvc5
+
+#endif  // CVC5__PROP__SAT_PREPROCESSOR_H
@@ -19,6 +19,7 @@
 
 #include "expr/node_manager_attributes.h"
 #include "options/arith_options.h"
+#include "options/arrays_options.h"
 #include "options/base_options.h"
 #include "options/bv_options.h"
 #include "options/quantifiers_options.h"
@@ -120,6 +121,12 @@ bool ProcessAssertions::apply(Assertions& as)
     d_passes["bv-gauss"]->apply(&assertions);
   }
 
+  // Compact store chains before the rewriter sees them
+  if (options::arraysCompactStores())
+  {
+    d_passes["arrays-compact-stores"]->apply(&assertions);
+  }
+
   // Add dummy assertion in last position - to be used as a
   // placeholder for any new assertions to get added
   assertions.push_back(d_true);
@@ -282,6 +289,19 @@ bool ProcessAssertions::apply(Assertions& as)
                     << endl;
   dumpAssertions("post-simplify", assertions);
 
+  // solve the independent sets of assertions separately
+  if (options::partitionAssertions() && noConflict
+      && !d_smt.isInternalSubsolver())
+  {
+    d_passes["partition-assertions"]->apply(&assertions);
+  }
+
+  // break the symmetries of the assertions
+  if (options::symBreak() && noConflict && !d_smt.isInternalSubsolver())
+  {
+    d_passes["sym-break"]->apply(&assertions);
+  }
+
   if (options::doStaticLearning())
   {
     d_passes["static-learning"]->apply(&assertions);
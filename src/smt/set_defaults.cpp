@@ -168,17 +168,29 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     opts.set(options::bvSolver, options::BVSolver::LAZY);
   }
 
+  /* The abstraction refinement lemmas of BVSolver::ABSTRACT have no
+   * bit-blasting proofs, so we use BVSolver::BITBLAST with proofs. */
+  if (options::bvSolver() == options::BVSolver::ABSTRACT
+      && options::produceProofs())
+  {
+    Notice() << "SmtEngine: setting bv-solver to bitblast to support proofs"
+             << std::endl;
+    opts.set(options::bvSolver, options::BVSolver::BITBLAST);
+  }
+
   /* Only BVSolver::LAZY natively supports int2bv and nat2bv, for other solvers
    * we need to eagerly eliminate the operators. */
   if (options::bvSolver() == options::BVSolver::SIMPLE
-      || options::bvSolver() == options::BVSolver::BITBLAST)
+      || options::bvSolver() == options::BVSolver::BITBLAST
+      || options::bvSolver() == options::BVSolver::ABSTRACT)
   {
     opts.set(options::bvLazyReduceExtf, false);
     opts.set(options::bvLazyRewriteExtf, false);
   }
 
   /* Disable bit-level propagation by default for the BITBLAST solver. */
-  if (options::bvSolver() == options::BVSolver::BITBLAST)
+  if (options::bvSolver() == options::BVSolver::BITBLAST
+      || options::bvSolver() == options::BVSolver::ABSTRACT)
   {
     opts.set(options::bitvectorPropagate, false);
   }
@@ -475,6 +487,44 @@ void setDefaults(LogicInfo& logic, bool isInternalSubsolver)
     }
   }
 
+  // Disable assertion partitioning with incremental solving, since the values
+  // of the solved components are fixed, and with unsat cores or proofs, since
+  // it does not justify its conclusions.
+  if (options::partitionAssertions()
+      && (options::incrementalSolving() || options::unsatCores()
+          || options::produceProofs()))
+  {
+    if (opts.wasSetByUser(options::partitionAssertions))
+    {
+      throw OptionException(
+          "assertion partitioning not supported with incremental solving, "
+          "unsat cores or proofs");
+    }
+    Notice() << "SmtEngine: turning off assertion partitioning to support "
+                "incremental solving, unsat cores or proofs"
+             << std::endl;
+    opts.set(options::partitionAssertions, false);
+  }
+
+  // Disable symmetry breaking with incremental solving, since later
+  // assertions may not have the same symmetries, and with unsat cores or
+  // proofs, since its constraints are not implied by the assertions.
+  if (options::symBreak()
+      && (options::incrementalSolving() || options::unsatCores()
+          || options::produceProofs()))
+  {
+    if (opts.wasSetByUser(options::symBreak))
+    {
+      throw OptionException(
+          "symmetry breaking not supported with incremental solving, unsat "
+          "cores or proofs");
+    }
+    Notice() << "SmtEngine: turning off symmetry breaking to support "
+                "incremental solving, unsat cores or proofs"
+             << std::endl;
+    opts.set(options::symBreak, false);
+  }
+
   if (options::solveBVAsInt() != options::SolveBVAsIntMode::OFF)
   {
     /**
@@ -0,0 +1,419 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Native generation of Gomory mixed-integer and MIR cuts from the rows of
+ * the exact simplex tableau.
+ */
+
+#include "theory/arith/cut_generator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "base/output.h"
+#include "options/arith_options.h"
+#include "smt/smt_statistics_registry.h"
+#include "theory/arith/constraint.h"
+#include "theory/arith/partial_model.h"
+#include "theory/arith/tableau.h"
+
+using namespace std;
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+CutGenerator::CutGenerator(const ArithVariables& vars, const Tableau& tableau)
+    : d_vars(vars), d_tableau(tableau)
+{
+}
+
+CutGenerator::Statistics::Statistics()
+    : d_rowsTried(smtStatisticsRegistry().registerInt(
+        "theory::arith::cuts::rowsTried")),
+      d_rowsRejected(smtStatisticsRegistry().registerInt(
+          "theory::arith::cuts::rowsRejected")),
+      d_gmiCuts(
+          smtStatisticsRegistry().registerInt("theory::arith::cuts::gmiCuts")),
+      d_mirCuts(
+          smtStatisticsRegistry().registerInt("theory::arith::cuts::mirCuts")),
+      d_cutsTooDense(smtStatisticsRegistry().registerInt(
+          "theory::arith::cuts::cutsTooDense")),
+      d_cutsParallel(smtStatisticsRegistry().registerInt(
+          "theory::arith::cuts::cutsParallel")),
+      d_certificateFailures(smtStatisticsRegistry().registerInt(
+          "theory::arith::cuts::certificateFailures")),
+      d_cutTimer(
+          smtStatisticsRegistry().registerTimer("theory::arith::cuts::timer"))
+{
+}
+
+/** Returns the distance of q to the nearest integer. */
+static Rational fractionality(const Rational& q)
+{
+  Rational f = q.floor_frac();
+  Rational g = Rational(1) - f;
+  return f < g ? f : g;
+}
+
+std::vector<TableauCut> CutGenerator::generate(uint32_t maxCuts)
+{
+  TimerStat::CodeTimer codeTimer(d_statistics.d_cutTimer);
+  std::vector<TableauCut> selected;
+  if (maxCuts == 0)
+  {
+    return selected;
+  }
+
+  // Collect the fractional integer basic variables, most fractional first.
+  std::vector<std::pair<Rational, ArithVar> > candidates;
+  for (Tableau::BasicIterator it = d_tableau.beginBasic(),
+                              end = d_tableau.endBasic();
+       it != end;
+       ++it)
+  {
+    ArithVar basic = *it;
+    if (!d_vars.isInteger(basic))
+    {
+      continue;
+    }
+    const DeltaRational& beta = d_vars.getAssignment(basic);
+    if (!beta.infinitesimalIsZero()
+        || beta.getNoninfinitesimalPart().isIntegral())
+    {
+      continue;
+    }
+    candidates.push_back(std::make_pair(
+        fractionality(beta.getNoninfinitesimalPart()), basic));
+  }
+  std::sort(candidates.begin(),
+            candidates.end(),
+            [](const std::pair<Rational, ArithVar>& a,
+               const std::pair<Rational, ArithVar>& b) {
+              return a.first > b.first
+                     || (a.first == b.first && a.second < b.second);
+            });
+
+  // The pool of candidate cuts for this round.
+  std::vector<TableauCut> pool;
+  uint32_t maxRows = options::arithCutsMaxRows();
+  uint32_t maxMult = std::max(options::arithCutsMaxMultiplier(), 1u);
+  uint32_t maxDensity = options::arithCutsMaxDensity();
+  std::vector<RowTerm> terms;
+  for (size_t i = 0, n = std::min<size_t>(candidates.size(), maxRows); i < n;
+       ++i)
+  {
+    ArithVar basic = candidates[i].second;
+    ++(d_statistics.d_rowsTried);
+    terms.clear();
+    if (!collectRow(basic, terms))
+    {
+      ++(d_statistics.d_rowsRejected);
+      continue;
+    }
+    const Rational& beta =
+        d_vars.getAssignment(basic).getNoninfinitesimalPart();
+    // Keep the most efficacious cut of the MIR family of this row.
+    bool found = false;
+    TableauCut best;
+    for (uint32_t k = 1; k <= maxMult; ++k)
+    {
+      TableauCut cut;
+      if (!mkCut(basic, terms, beta, k, cut))
+      {
+        continue;
+      }
+      if (!found || cut.d_efficacy > best.d_efficacy)
+      {
+        best = cut;
+        found = true;
+      }
+    }
+    if (!found)
+    {
+      continue;
+    }
+    if (best.d_lhs.size() > maxDensity)
+    {
+      ++(d_statistics.d_cutsTooDense);
+      continue;
+    }
+    pool.push_back(best);
+  }
+
+  // Select the most efficacious cuts that are not nearly parallel to a cut
+  // that has already been selected.
+  std::sort(pool.begin(),
+            pool.end(),
+            [](const TableauCut& a, const TableauCut& b) {
+              return a.d_efficacy > b.d_efficacy
+                     || (a.d_efficacy == b.d_efficacy && a.d_basic < b.d_basic);
+            });
+  double maxParallelism = options::arithCutsMaxParallelism();
+  for (const TableauCut& cut : pool)
+  {
+    if (selected.size() >= maxCuts)
+    {
+      break;
+    }
+    bool parallel = false;
+    for (const TableauCut& s : selected)
+    {
+      if (parallelism(cut, s) > maxParallelism)
+      {
+        parallel = true;
+        break;
+      }
+    }
+    if (parallel)
+    {
+      ++(d_statistics.d_cutsParallel);
+      continue;
+    }
+    if (cut.d_multiplier == 1)
+    {
+      ++(d_statistics.d_gmiCuts);
+    }
+    else
+    {
+      ++(d_statistics.d_mirCuts);
+    }
+    selected.push_back(cut);
+  }
+  Debug("arith::cuts") << "generated " << selected.size() << " cuts from "
+                       << candidates.size() << " fractional rows" << endl;
+  return selected;
+}
+
+bool CutGenerator::collectRow(ArithVar basic,
+                              std::vector<RowTerm>& terms) const
+{
+  for (Tableau::RowIterator iter = d_tableau.basicRowIterator(basic);
+       !iter.atEnd();
+       ++iter)
+  {
+    const Tableau::Entry& entry = *iter;
+    ArithVar v = entry.getColVar();
+    if (v == basic)
+    {
+      continue;
+    }
+    RowTerm t;
+    t.d_var = v;
+    t.d_fixed = d_vars.boundsAreEqual(v);
+    if (d_vars.hasLowerBound(v) && d_vars.cmpAssignmentLowerBound(v) == 0)
+    {
+      t.d_atUpper = false;
+    }
+    else if (d_vars.hasUpperBound(v) && d_vars.cmpAssignmentUpperBound(v) == 0)
+    {
+      t.d_atUpper = true;
+    }
+    else
+    {
+      Debug("arith::cuts") << "row of " << basic << " rejected: " << v
+                           << " is not at a bound" << endl;
+      return false;
+    }
+    const DeltaRational& bound =
+        t.d_atUpper ? d_vars.getUpperBound(v) : d_vars.getLowerBound(v);
+    if (!bound.infinitesimalIsZero())
+    {
+      // strict bounds cannot be substituted exactly
+      return false;
+    }
+    // x_b = ... + a_j * x_j: with x_j = l_j + s_j the coefficient of s_j
+    // on the right-hand side is a_j, with x_j = u_j - s_j it is -a_j.
+    t.d_coeff = t.d_atUpper ? -entry.getCoefficient()
+                            : entry.getCoefficient();
+    t.d_integral = d_vars.isInteger(v)
+                   && bound.getNoninfinitesimalPart().isIntegral();
+    terms.push_back(t);
+  }
+  return true;
+}
+
+bool CutGenerator::mkCut(ArithVar basic,
+                         const std::vector<RowTerm>& terms,
+                         const Rational& basicValue,
+                         uint32_t k,
+                         TableauCut& cut)
+{
+  // The row multiplied by k is:
+  //   k*x_b + sum_j g_j s_j = b
+  // with g_j = -k * a'_j and b = k * beta(x_b).
+  Rational kq(k);
+  Rational b = kq * basicValue;
+  Rational f0 = b.floor_frac();
+  if (f0.isZero())
+  {
+    return false;
+  }
+  Rational oneMinusF0 = Rational(1) - f0;
+
+  std::vector<Rational> coeffs;
+  std::vector<Integer> pis;
+  coeffs.reserve(terms.size());
+  pis.reserve(terms.size());
+  for (const RowTerm& t : terms)
+  {
+    Rational g = -(kq * t.d_coeff);
+    if (t.d_integral)
+    {
+      Rational fj = g.floor_frac();
+      if (fj <= f0)
+      {
+        coeffs.push_back(fj / f0);
+        pis.push_back(g.floor());
+      }
+      else
+      {
+        coeffs.push_back((Rational(1) - fj) / oneMinusF0);
+        pis.push_back(g.ceiling());
+      }
+    }
+    else
+    {
+      coeffs.push_back(g.sgn() >= 0 ? g / f0 : (-g) / oneMinusF0);
+      pis.push_back(Integer(0));
+    }
+  }
+
+  if (!checkCertificate(terms, k, coeffs, pis, b))
+  {
+    ++(d_statistics.d_certificateFailures);
+    Debug("arith::cuts") << "certificate check failed for row of " << basic
+                         << " with multiplier " << k << endl;
+    Assert(false) << "invalid MIR cut derived from row";
+    return false;
+  }
+
+  // Map sum_j c_j s_j >= 1 back to the tableau variables. Fixed variables
+  // are dropped, as s_j = 0 is implied by their bounds.
+  cut.d_lhs.purge();
+  cut.d_rhs = Rational(1);
+  cut.d_explanation.clear();
+  cut.d_basic = basic;
+  cut.d_multiplier = k;
+  double sqnorm = 0;
+  for (size_t i = 0, n = terms.size(); i < n; ++i)
+  {
+    const RowTerm& t = terms[i];
+    const Rational& c = coeffs[i];
+    if (t.d_fixed)
+    {
+      ConstraintCP lb = d_vars.getLowerBoundConstraint(t.d_var);
+      ConstraintCP ub = d_vars.getUpperBoundConstraint(t.d_var);
+      cut.d_explanation.push_back(lb);
+      if (ub != lb)
+      {
+        cut.d_explanation.push_back(ub);
+      }
+      continue;
+    }
+    if (c.isZero())
+    {
+      continue;
+    }
+    if (t.d_atUpper)
+    {
+      // c * (u_j - x_j)
+      cut.d_lhs.set(t.d_var, -c);
+      cut.d_rhs -= c * d_vars.getUpperBound(t.d_var).getNoninfinitesimalPart();
+      cut.d_explanation.push_back(d_vars.getUpperBoundConstraint(t.d_var));
+    }
+    else
+    {
+      // c * (x_j - l_j)
+      cut.d_lhs.set(t.d_var, c);
+      cut.d_rhs += c * d_vars.getLowerBound(t.d_var).getNoninfinitesimalPart();
+      cut.d_explanation.push_back(d_vars.getLowerBoundConstraint(t.d_var));
+    }
+    double cd = c.getDouble();
+    sqnorm += cd * cd;
+  }
+  if (cut.d_lhs.empty())
+  {
+    // The bounds of the fixed variables alone already conflict with the row.
+    return false;
+  }
+  cut.d_norm = std::sqrt(sqnorm);
+  // The current assignment satisfies sum_j c_j s_j = 0, so it violates the
+  // cut by exactly 1 in the space of the s_j.
+  cut.d_efficacy = cut.d_norm > 0 ? 1.0 / cut.d_norm : 0;
+  return true;
+}
+
+bool CutGenerator::checkCertificate(const std::vector<RowTerm>& terms,
+                                    uint32_t k,
+                                    const std::vector<Rational>& coeffs,
+                                    const std::vector<Integer>& pis,
+                                    const Rational& b)
+{
+  Assert(terms.size() == coeffs.size());
+  Assert(terms.size() == pis.size());
+  if (k == 0)
+  {
+    return false;
+  }
+  Rational f0 = b - Rational(b.floor());
+  if (f0.sgn() <= 0 || f0 >= Rational(1))
+  {
+    return false;
+  }
+  Rational oneMinusF0 = Rational(1) - f0;
+  Rational kq(k);
+  for (size_t i = 0, n = terms.size(); i < n; ++i)
+  {
+    const RowTerm& t = terms[i];
+    // D may only contain the s_j that are known to be integral.
+    if (!t.d_integral && !pis[i].isZero())
+    {
+      return false;
+    }
+    Rational r = -(kq * t.d_coeff) - Rational(pis[i]);
+    // (D <= floor(b)) implies sum_j r_j s_j >= f0, and
+    // (D >= floor(b) + 1) implies sum_j -r_j s_j >= 1 - f0.
+    // Together with s_j >= 0, both imply the cut iff c_j dominates both
+    // scaled coefficients.
+    const Rational& c = coeffs[i];
+    if (c < r / f0 || c < (-r) / oneMinusF0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+double CutGenerator::parallelism(const TableauCut& a, const TableauCut& b)
+{
+  if (a.d_norm == 0 || b.d_norm == 0)
+  {
+    return 0;
+  }
+  double dot = 0;
+  for (DenseMap<Rational>::const_iterator it = a.d_lhs.begin(),
+                                          end = a.d_lhs.end();
+       it != end;
+       ++it)
+  {
+    ArithVar v = *it;
+    if (b.d_lhs.isKey(v))
+    {
+      dot += a.d_lhs[v].getDouble() * b.d_lhs[v].getDouble();
+    }
+  }
+  return std::fabs(dot) / (a.d_norm * b.d_norm);
+}
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,175 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Native generation of Gomory mixed-integer and MIR cuts from the rows of
+ * the exact simplex tableau.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__ARITH__CUT_GENERATOR_H
+#define CVC5__THEORY__ARITH__CUT_GENERATOR_H
+
+#include <vector>
+
+#include "theory/arith/arithvar.h"
+#include "theory/arith/constraint_forward.h"
+#include "util/dense_map.h"
+#include "util/integer.h"
+#include "util/rational.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+
+class ArithVariables;
+class Tableau;
+
+/**
+ * A cut over the variables of the tableau: lhs >= rhs.
+ *
+ * The cut is implied by the bound constraints in d_explanation together with
+ * the integrality of the variables involved.
+ */
+struct TableauCut
+{
+  /** The coefficients of the left-hand side. */
+  DenseMap<Rational> d_lhs;
+  /** The right-hand side constant. */
+  Rational d_rhs;
+  /** The bound constraints the cut depends upon. */
+  ConstraintCPVec d_explanation;
+  /** The basic variable whose row was used to derive the cut. */
+  ArithVar d_basic;
+  /** The multiplier applied to the row (1 for plain Gomory cuts). */
+  uint32_t d_multiplier;
+  /** Euclidean norm of d_lhs, approximated with doubles. */
+  double d_norm;
+  /**
+   * The efficacy of the cut: the euclidean distance by which the current
+   * assignment violates the cut.
+   */
+  double d_efficacy;
+};
+
+/**
+ * Generates Gomory mixed-integer (GMI) cuts and mixed-integer rounding (MIR)
+ * cuts directly from the rows of the exact tableau, without an external
+ * LP solver.
+ *
+ * A row x_b = sum_j a_j x_j of an integer basic variable x_b whose assignment
+ * is fractional is usable if every nonbasic x_j is assigned exactly to one of
+ * its bounds. Substituting x_j = l_j + s_j (resp. x_j = u_j - s_j) gives
+ *   k*x_b + sum_j g_j s_j = b,   s_j >= 0,
+ * for a row multiplier k >= 1. The mixed-integer rounding of this equality is
+ * a cut sum_j c_j s_j >= 1 that is violated by the current assignment
+ * (where all s_j are 0). For k = 1 this is the classic GMI cut; larger k give
+ * the k-cuts of the MIR family, which are sometimes stronger.
+ *
+ * Candidate cuts are collected in a pool, rejected if they are too dense,
+ * and selected by efficacy while skipping cuts that are nearly parallel to an
+ * already selected cut. Every cut is checked against an exact split-cut
+ * certificate before it is returned.
+ */
+class CutGenerator
+{
+ public:
+  CutGenerator(const ArithVariables& vars, const Tableau& tableau);
+
+  /**
+   * Generates candidate cuts from the rows of the fractional integer basic
+   * variables in the tableau, and returns at most maxCuts of them, ordered by
+   * decreasing efficacy.
+   */
+  std::vector<TableauCut> generate(uint32_t maxCuts);
+
+ private:
+  /**
+   * A term of the row x_b = beta(x_b) + sum_j a'_j s_j obtained by
+   * substituting each nonbasic variable x_j by the bound it is assigned to.
+   */
+  struct RowTerm
+  {
+    /** The nonbasic variable. */
+    ArithVar d_var;
+    /** The coefficient a'_j of s_j. */
+    Rational d_coeff;
+    /** Whether s_j = u_j - x_j, rather than s_j = x_j - l_j. */
+    bool d_atUpper;
+    /** Whether s_j is known to take only integer values. */
+    bool d_integral;
+    /** Whether x_j is fixed, i.e. has equal lower and upper bounds. */
+    bool d_fixed;
+  };
+
+  /**
+   * Collects the terms of the row of basic variable x_b into terms. Returns
+   * false if the row cannot be used for cutting, e.g. because some nonbasic
+   * variable is strictly between its bounds.
+   */
+  bool collectRow(ArithVar basic, std::vector<RowTerm>& terms) const;
+
+  /**
+   * Constructs the MIR cut of the row of basic, multiplied by k, and stores
+   * it in cut. Returns false if no valid cut exists for this multiplier.
+   */
+  bool mkCut(ArithVar basic,
+             const std::vector<RowTerm>& terms,
+             const Rational& basicValue,
+             uint32_t k,
+             TableauCut& cut);
+
+  /**
+   * Checks that the cut sum_j c_j s_j >= 1 is a split cut for the integer
+   * disjunction (D <= floor(b)) or (D >= floor(b) + 1), where
+   *   D = k*x_b + sum_j pi_j s_j
+   * is integral. The cut is valid if for every j it dominates both
+   *   r_j / f0  and  -r_j / (1 - f0),
+   * where r_j = g_j - pi_j and f0 = b - floor(b).
+   */
+  static bool checkCertificate(const std::vector<RowTerm>& terms,
+                               uint32_t k,
+                               const std::vector<Rational>& coeffs,
+                               const std::vector<Integer>& pis,
+                               const Rational& b);
+
+  /** Returns the cosine of the angle between the left-hand sides of a, b. */
+  static double parallelism(const TableauCut& a, const TableauCut& b);
+
+  /** The variables and their assignments and bounds. */
+  const ArithVariables& d_vars;
+  /** The tableau whose rows are used. */
+  const Tableau& d_tableau;
+
+  class Statistics
+  {
+   public:
+    IntStat d_rowsTried;
+    IntStat d_rowsRejected;
+    IntStat d_gmiCuts;
+    IntStat d_mirCuts;
+    IntStat d_cutsTooDense;
+    IntStat d_cutsParallel;
+    IntStat d_certificateFailures;
+    TimerStat d_cutTimer;
+
+    Statistics();
+  };
+
+  Statistics d_statistics;
+}; /* class CutGenerator */
+
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__ARITH__CUT_GENERATOR_H */
@@ -18,6 +18,8 @@
 
 #ifdef CVC5_POLY_IMP
 
+#include <algorithm>
+
 #include "options/arith_options.h"
 #include "theory/arith/nl/cad/projections.h"
 #include "theory/arith/nl/cad/variable_ordering.h"
@@ -59,10 +61,50 @@ void CDCAC::reset()
 void CDCAC::computeVariableOrdering()
 {
   // Actually compute the variable ordering
-  d_variableOrdering = d_varOrder(d_constraints.getConstraints(),
-                                  VariableOrderingStrategy::BROWN);
+  std::vector<poly::Variable> ordering = d_varOrder(
+      d_constraints.getConstraints(), VariableOrderingStrategy::BROWN);
+  if (isIncremental() && !d_variableOrdering.empty())
+  {
+    // Keep the previous ordering if it covers all variables, so that the
+    // retained intervals stay usable. Any ordering is correct.
+    bool covered = true;
+    for (const auto& v : ordering)
+    {
+      covered = std::any_of(
+          d_variableOrdering.begin(),
+          d_variableOrdering.end(),
+          [&v](const poly::Variable& w) {
+            return v.get_internal() == w.get_internal();
+          });
+      if (!covered) break;
+    }
+    if (covered)
+    {
+      ordering = d_variableOrdering;
+    }
+  }
+  bool changed = ordering.size() != d_variableOrdering.size();
+  for (std::size_t i = 0, n = ordering.size(); !changed && i < n; ++i)
+  {
+    changed = ordering[i].get_internal()
+              != d_variableOrdering[i].get_internal();
+  }
+  d_variableOrdering = ordering;
+  if (changed)
+  {
+    d_retained.clear();
+    d_numRetained = 0;
+  }
   Trace("cdcac") << "Variable ordering is now " << d_variableOrdering
                  << std::endl;
+  // Projections depend on the variable ordering, and so does the order of
+  // the keys of the projection cache.
+  if (changed || d_projCache.size() > options::nlCadProjCacheSize())
+  {
+    Trace("cdcac") << "Clearing projection cache of size "
+                   << d_projCache.size() << std::endl;
+    d_projCache.clear();
+  }
 
   // Write variable ordering back to libpoly.
   lp_variable_order_t* vo = poly::Context::get_context().get_variable_order();
@@ -202,12 +244,27 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
       // Add all polynomial from lower levels.
       res.add(p);
     }
+    // The root checks only depend on the interval, not on the polynomial from
+    // d_mainPolys we compute resultants with.
+    std::vector<poly::Polynomial> lowerWithRoot;
+    for (const auto& q : i.d_lowerPolys)
+    {
+      // Check whether q(s \times a) = 0 for some a <= l
+      if (hasRootBelow(q, get_lower(i.d_interval))) lowerWithRoot.push_back(q);
+    }
+    std::vector<poly::Polynomial> upperWithRoot;
+    for (const auto& q : i.d_upperPolys)
+    {
+      // Check whether q(s \times a) = 0 for some a >= u
+      if (hasRootAbove(q, get_upper(i.d_interval))) upperWithRoot.push_back(q);
+    }
     for (const auto& p : i.d_mainPolys)
     {
-      Trace("cdcac") << "Discriminant of " << p << " -> " << discriminant(p)
-                     << std::endl;
       // Add all discriminants
-      res.add(discriminant(p));
+      const PolyVector& disc = d_projCache.discriminant(p);
+      Trace("cdcac") << "Discriminant of " << p << " -> " << disc
+                     << std::endl;
+      res.addFactorized(disc);
 
       for (const auto& q : requiredCoefficients(p))
       {
@@ -215,23 +272,21 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
         Trace("cdcac") << "Coeff of " << p << " -> " << q << std::endl;
         res.add(q);
       }
-      for (const auto& q : i.d_lowerPolys)
+      for (const auto& q : lowerWithRoot)
       {
         if (p == q) continue;
-        // Check whether p(s \times a) = 0 for some a <= l
-        if (!hasRootBelow(q, get_lower(i.d_interval))) continue;
+        const PolyVector& resultant = d_projCache.resultant(p, q);
         Trace("cdcac") << "Resultant of " << p << " and " << q << " -> "
-                       << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+                       << resultant << std::endl;
+        res.addFactorized(resultant);
       }
-      for (const auto& q : i.d_upperPolys)
+      for (const auto& q : upperWithRoot)
       {
         if (p == q) continue;
-        // Check whether p(s \times a) = 0 for some a >= u
-        if (!hasRootAbove(q, get_upper(i.d_interval))) continue;
+        const PolyVector& resultant = d_projCache.resultant(p, q);
         Trace("cdcac") << "Resultant of " << p << " and " << q << " -> "
-                       << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+                       << resultant << std::endl;
+        res.addFactorized(resultant);
       }
     }
   }
@@ -243,9 +298,10 @@ PolyVector CDCAC::constructCharacterization(std::vector<CACInterval>& intervals)
     {
       for (const auto& q : intervals[i + 1].d_lowerPolys)
       {
+        const PolyVector& resultant = d_projCache.resultant(p, q);
         Trace("cdcac") << "Resultant of " << p << " and " << q << " -> "
-                       << resultant(p, q) << std::endl;
-        res.add(resultant(p, q));
+                       << resultant << std::endl;
+        res.addFactorized(resultant);
       }
     }
   }
@@ -356,7 +412,19 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
   }
   Trace("cdcac") << "Looking for unsat cover for "
                  << d_variableOrdering[curVariable] << std::endl;
+  if (curVariable == 0 && isIncremental())
+  {
+    d_asserted.clear();
+    for (const auto& c : d_constraints.getConstraints())
+    {
+      d_asserted.insert(std::get<2>(c));
+    }
+  }
   std::vector<CACInterval> intervals = getUnsatIntervals(curVariable);
+  if (isIncremental())
+  {
+    addRetainedIntervals(curVariable, intervals);
+  }
 
   if (Trace.isOn("cdcac"))
   {
@@ -390,6 +458,10 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
     {
       // We have a full assignment. SAT!
       Trace("cdcac") << "Found full assignment: " << d_assignment << std::endl;
+      if (isIncremental())
+      {
+        retainIntervals(curVariable, intervals);
+      }
       return {};
     }
     if (isProofEnabled())
@@ -402,6 +474,10 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
     {
       // Found SAT!
       Trace("cdcac") << "SAT!" << std::endl;
+      if (isIncremental())
+      {
+        retainIntervals(curVariable, intervals);
+      }
       return {};
     }
     Trace("cdcac") << "Refuting Sample: " << d_assignment << std::endl;
@@ -427,6 +503,10 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
 
     if (returnFirstInterval)
     {
+      if (isIncremental())
+      {
+        retainIntervals(curVariable, intervals);
+      }
       return intervals;
     }
 
@@ -458,6 +538,10 @@ std::vector<CACInterval> CDCAC::getUnsatCover(std::size_t curVariable,
   {
     d_proof->endRecursive();
   }
+  if (isIncremental())
+  {
+    retainIntervals(curVariable, intervals);
+  }
   return intervals;
 }
 
@@ -540,6 +624,87 @@ void CDCAC::pruneRedundantIntervals(std::vector<CACInterval>& intervals)
   }
 }
 
+bool CDCAC::isIncremental() const
+{
+  // Retained intervals have no proofs associated with them.
+  return options::nlCadIncremental() && !isProofEnabled();
+}
+
+std::vector<poly::Value> CDCAC::getSamplePrefix(std::size_t level) const
+{
+  std::vector<poly::Value> prefix;
+  for (std::size_t i = 0; i < level; ++i)
+  {
+    prefix.emplace_back(d_assignment.get(d_variableOrdering[i]));
+  }
+  return prefix;
+}
+
+void CDCAC::addRetainedIntervals(std::size_t level,
+                                 std::vector<CACInterval>& intervals)
+{
+  if (level >= d_retained.size())
+  {
+    return;
+  }
+  std::vector<poly::Value> prefix = getSamplePrefix(level);
+  for (const auto& r : d_retained[level])
+  {
+    if (r.d_prefix != prefix)
+    {
+      continue;
+    }
+    std::size_t reused = 0;
+    for (const auto& i : r.d_intervals)
+    {
+      bool asserted = std::all_of(
+          i.d_origins.begin(), i.d_origins.end(), [this](const Node& n) {
+            return d_asserted.find(n) != d_asserted.end();
+          });
+      if (asserted)
+      {
+        intervals.emplace_back(i);
+        ++reused;
+      }
+    }
+    Trace("cdcac") << "Reusing " << reused << " of " << r.d_intervals.size()
+                   << " retained intervals for "
+                   << d_variableOrdering[level] << std::endl;
+    pruneRedundantIntervals(intervals);
+    return;
+  }
+}
+
+void CDCAC::retainIntervals(std::size_t level,
+                            const std::vector<CACInterval>& intervals)
+{
+  if (d_numRetained + intervals.size() > options::nlCadIncrementalLimit())
+  {
+    Trace("cdcac") << "Clearing " << d_numRetained << " retained intervals"
+                   << std::endl;
+    d_retained.clear();
+    d_numRetained = 0;
+  }
+  if (level >= d_retained.size())
+  {
+    d_retained.resize(level + 1);
+  }
+  std::vector<poly::Value> prefix = getSamplePrefix(level);
+  for (auto& r : d_retained[level])
+  {
+    if (r.d_prefix == prefix)
+    {
+      d_numRetained -= r.d_intervals.size();
+      r.d_intervals = intervals;
+      d_numRetained += intervals.size();
+      return;
+    }
+  }
+  d_retained[level].emplace_back(
+      RetainedIntervals{std::move(prefix), intervals});
+  d_numRetained += intervals.size();
+}
+
 }  // namespace cad
 }  // namespace nl
 }  // namespace arith
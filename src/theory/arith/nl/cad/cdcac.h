@@ -23,6 +23,7 @@
 
 #include <poly/polyxx.h>
 
+#include <unordered_set>
 #include <vector>
 
 #include "theory/arith/nl/cad/cdcac_utils.h"
@@ -183,6 +184,26 @@ class CDCAC
    */
   void pruneRedundantIntervals(std::vector<CACInterval>& intervals);
 
+  /**
+   * Whether infeasible intervals are retained between calls to
+   * getUnsatCover() (see d_retained).
+   */
+  bool isIncremental() const;
+  /** Returns the values of the first level variables of d_assignment. */
+  std::vector<poly::Value> getSamplePrefix(std::size_t level) const;
+  /**
+   * Adds the intervals retained for the current sample of the variables below
+   * the given level to intervals, if all their origins are still asserted.
+   */
+  void addRetainedIntervals(std::size_t level,
+                            std::vector<CACInterval>& intervals);
+  /**
+   * Retains the given infeasible intervals for the current sample of the
+   * variables below the given level.
+   */
+  void retainIntervals(std::size_t level,
+                       const std::vector<CACInterval>& intervals);
+
   /**
    * The current assignment. When the method terminates with SAT, it contains a
    * model for the input constraints.
@@ -201,6 +222,34 @@ class CDCAC
   /** The linear assignment used as an initial guess. */
   std::vector<poly::Value> d_initialAssignment;
 
+  /** The infeasible intervals retained for a sample of the lower levels. */
+  struct RetainedIntervals
+  {
+    /** The values of the variables below the level of the intervals. */
+    std::vector<poly::Value> d_prefix;
+    /** The infeasible intervals for this sample. */
+    std::vector<CACInterval> d_intervals;
+  };
+  /**
+   * The infeasible intervals found by previous calls to getUnsatCover(), per
+   * level. An interval remains infeasible as long as all of its origins are
+   * asserted (adding constraints only shrinks the feasible region), hence
+   * they can be reused by subsequent checks that arrive at the same sample.
+   * Cleared whenever the variable ordering changes.
+   */
+  std::vector<std::vector<RetainedIntervals>> d_retained;
+  /** The total number of intervals in d_retained. */
+  std::size_t d_numRetained = 0;
+  /** The constraints asserted in the current check, as nodes. */
+  std::unordered_set<Node, NodeHashFunction> d_asserted;
+
+  /**
+   * Caches discriminants and resultants computed during characterization.
+   * Sibling cells and subsequent checks frequently project the same
+   * polynomials.
+   */
+  ProjectionCache d_projCache;
+
   /** The proof generator */
   std::unique_ptr<CADProofGenerator> d_proof;
 };
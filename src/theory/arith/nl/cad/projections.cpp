@@ -17,6 +17,8 @@
 
 #ifdef CVC5_POLY_IMP
 
+#include <utility>
+
 #include "base/check.h"
 
 namespace cvc5 {
@@ -77,6 +79,11 @@ void PolyVector::pushDownPolys(PolyVector& down, poly::Variable var)
   erase(it, end());
 }
 
+void PolyVector::addFactorized(const PolyVector& polys)
+{
+  std::vector<poly::Polynomial>::insert(end(), polys.begin(), polys.end());
+}
+
 PolyVector projection_mccallum(const std::vector<Polynomial>& polys)
 {
   PolyVector res;
@@ -101,6 +108,48 @@ PolyVector projection_mccallum(const std::vector<Polynomial>& polys)
   return res;
 }
 
+const PolyVector& ProjectionCache::discriminant(const poly::Polynomial& p)
+{
+  std::vector<Polynomial> key{p};
+  auto it = d_discriminants.find(key);
+  if (it == d_discriminants.end())
+  {
+    PolyVector res;
+    res.add(poly::discriminant(p));
+    it = d_discriminants.emplace(std::move(key), std::move(res)).first;
+  }
+  return it->second;
+}
+
+const PolyVector& ProjectionCache::resultant(const poly::Polynomial& p,
+                                             const poly::Polynomial& q)
+{
+  std::vector<Polynomial> key{p, q};
+  if (q < p)
+  {
+    std::swap(key[0], key[1]);
+  }
+  auto it = d_resultants.find(key);
+  if (it == d_resultants.end())
+  {
+    PolyVector res;
+    res.add(poly::resultant(key[0], key[1]));
+    it = d_resultants.emplace(std::move(key), std::move(res)).first;
+  }
+  return it->second;
+}
+
+void ProjectionCache::clear()
+{
+  d_discriminants.clear();
+  d_resultants.clear();
+}
+
+std::size_t ProjectionCache::size() const
+{
+  return d_discriminants.size() + d_resultants.size();
+}
+
 }  // namespace cad
 }  // namespace nl
 }  // namespace arith
@@ -22,6 +22,7 @@
 
 #include <poly/polyxx.h>
 
+#include <map>
 #include <vector>
 
 namespace cvc5 {
@@ -64,6 +65,47 @@ class PolyVector : public std::vector<poly::Polynomial>
   void makeFinestSquareFreeBasis();
   /** Push polynomials with a lower main variable to another PolyVector. */
   void pushDownPolys(PolyVector& down, poly::Variable var);
+  /**
+   * Adds all polynomials from another PolyVector. As they are already
+   * factorized, this does not factorize them again.
+   */
+  void addFactorized(const PolyVector& polys);
+};
+
+/**
+ * Caches the (factorized) results of projection operations, keyed by the
+ * polynomials they are computed from.
+ *
+ * Projection results only depend on the input polynomials and not on the
+ * current sample, hence they can be shared between sibling cells and between
+ * subsequent checks. As the results (and the order on polynomials used for the
+ * keys) depend on the variable ordering, the cache must be cleared whenever
+ * the variable ordering changes.
+ */
+class ProjectionCache
+{
+ public:
+  /** Returns the square-free factors of the discriminant of p. */
+  const PolyVector& discriminant(const poly::Polynomial& p);
+  /**
+   * Returns the square-free factors of the resultant of p and q. As the
+   * resultants of (p, q) and (q, p) only differ in their sign, this is
+   * cached for the pair of p and q in increasing order.
+   */
+  const PolyVector& resultant(const poly::Polynomial& p,
+                              const poly::Polynomial& q);
+  /** Removes all cached results. */
+  void clear();
+  /** Returns the number of cached results. */
+  std::size_t size() const;
+
+ private:
+  /** Maps polynomial tuples to the factorized result for the given map. */
+  using Cache = std::map<std::vector<poly::Polynomial>, PolyVector>;
+  /** Cached discriminants, keyed by {p}. */
+  Cache d_discriminants;
+  /** Cached resultants, keyed by (p, q) with p <= q. */
+  Cache d_resultants;
 };
 
 /**
@@ -105,6 +105,22 @@ PropagationResult Candidate::propagate(poly::IntervalAssignment& ia,
   return result;
 }
 
+FloatInterval Candidate::propagateFloat(const FloatBox& box) const
+{
+  FloatInterval res = frhs.evaluate(box);
+  // Remove bounds based on the sign condition, strict bounds are weakened
+  switch (rel)
+  {
+    case poly::SignCondition::LT:
+    case poly::SignCondition::LE: res.lower = FloatInterval().lower; break;
+    case poly::SignCondition::EQ: break;
+    case poly::SignCondition::NE: Assert(false); break;
+    case poly::SignCondition::GT:
+    case poly::SignCondition::GE: res.upper = FloatInterval().upper; break;
+  }
+  return res;
+}
+
 std::ostream& operator<<(std::ostream& os, const Candidate& c)
 {
   os << c.lhs << " " << c.rel << " ";
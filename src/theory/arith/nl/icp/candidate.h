@@ -22,6 +22,7 @@
 #include <poly/polyxx.h>
 
 #include "expr/node.h"
+#include "theory/arith/nl/icp/float_interval.h"
 #include "theory/arith/nl/icp/intersection.h"
 
 namespace cvc5 {
@@ -62,6 +63,8 @@ struct Candidate
   Node origin;
   /** The variable within rhs */
   std::vector<Node> rhsVariables;
+  /** rhsmult*rhs with outward rounded float coefficients */
+  FloatPolynomial frhs;
 
   /**
    * Contract the interval assignment based on this candidate.
@@ -70,6 +73,13 @@ struct Candidate
    */
   PropagationResult propagate(poly::IntervalAssignment& ia,
                               std::size_t size_threshold) const;
+
+  /**
+   * Evaluate rhsmult*rhs over the float box and remove bounds based on rel,
+   * yielding an over-approximation of the interval that propagate() would
+   * intersect the interval of lhs with.
+   */
+  FloatInterval propagateFloat(const FloatBox& box) const;
 };
 
 /** Print a candidate. */
@@ -0,0 +1,244 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Outward rounded floating point intervals for fast ICP-style propagation.
+ */
+
+#include "theory/arith/nl/icp/float_interval.h"
+
+#ifdef CVC5_POLY_IMP
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "base/check.h"
+#include "util/poly_util.h"
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+namespace {
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+/** Round a result of a floating point operation downwards */
+double down(double d) { return std::isinf(d) ? d : std::nextafter(d, -inf); }
+/** Round a result of a floating point operation upwards */
+double up(double d) { return std::isinf(d) ? d : std::nextafter(d, inf); }
+
+/** Lower bound of a * b, where 0 * inf = 0 */
+double mulDown(double a, double b)
+{
+  if (a == 0 || b == 0) return 0;
+  return down(a * b);
+}
+/** Upper bound of a * b, where 0 * inf = 0 */
+double mulUp(double a, double b)
+{
+  if (a == 0 || b == 0) return 0;
+  return up(a * b);
+}
+
+/** Lower bound of d^exp for d >= 0 */
+double powDown(double d, std::size_t exp)
+{
+  double res = 1;
+  for (; exp > 0; --exp)
+  {
+    res = mulDown(res, d);
+  }
+  return std::max(res, 0.0);
+}
+/** Upper bound of d^exp for d >= 0 */
+double powUp(double d, std::size_t exp)
+{
+  double res = 1;
+  for (; exp > 0; --exp)
+  {
+    res = mulUp(res, d);
+  }
+  return res;
+}
+
+/** The smallest float interval containing a double approximation d */
+FloatInterval around(double d)
+{
+  if (std::isinf(d))
+  {
+    // The value is too large to be represented.
+    return d > 0 ? FloatInterval{std::numeric_limits<double>::max(), inf}
+                 : FloatInterval{-inf, -std::numeric_limits<double>::max()};
+  }
+  return FloatInterval{down(d), up(d)};
+}
+
+/** A float interval containing the (finite or infinite) value v */
+FloatInterval toFloatInterval(const poly::Value& v)
+{
+  if (is_minus_infinity(v))
+  {
+    return FloatInterval{-inf, -inf};
+  }
+  if (is_plus_infinity(v))
+  {
+    return FloatInterval{inf, inf};
+  }
+  FloatInterval res = around(lp_value_to_double(v.get_internal()));
+  if (is_algebraic_number(v))
+  {
+    // The double approximation of an algebraic number is only as good as its
+    // isolating interval, hence widen more generously.
+    double eps = 1e-6 * (1 + std::max(std::abs(res.lower), std::abs(res.upper)));
+    res.lower = down(res.lower - eps);
+    res.upper = up(res.upper + eps);
+  }
+  return res;
+}
+
+}  // namespace
+
+FloatInterval operator+(const FloatInterval& a, const FloatInterval& b)
+{
+  return FloatInterval{down(a.lower + b.lower), up(a.upper + b.upper)};
+}
+
+FloatInterval operator*(const FloatInterval& a, const FloatInterval& b)
+{
+  FloatInterval res{inf, -inf};
+  for (double x : {a.lower, a.upper})
+  {
+    for (double y : {b.lower, b.upper})
+    {
+      res.lower = std::min(res.lower, mulDown(x, y));
+      res.upper = std::max(res.upper, mulUp(x, y));
+    }
+  }
+  return res;
+}
+
+FloatInterval pow(const FloatInterval& a, std::size_t exp)
+{
+  if (exp == 0)
+  {
+    return FloatInterval{1, 1};
+  }
+  if (a.lower >= 0)
+  {
+    return FloatInterval{powDown(a.lower, exp), powUp(a.upper, exp)};
+  }
+  if (exp % 2 == 1)
+  {
+    // x^exp is monotone
+    double lower = -powUp(-a.lower, exp);
+    double upper =
+        a.upper >= 0 ? powUp(a.upper, exp) : -powDown(-a.upper, exp);
+    return FloatInterval{lower, upper};
+  }
+  if (a.upper <= 0)
+  {
+    return FloatInterval{powDown(-a.upper, exp), powUp(-a.lower, exp)};
+  }
+  return FloatInterval{0, powUp(std::max(-a.lower, a.upper), exp)};
+}
+
+FloatInterval intersect(const FloatInterval& a, const FloatInterval& b)
+{
+  return FloatInterval{std::max(a.lower, b.lower), std::min(a.upper, b.upper)};
+}
+
+std::ostream& operator<<(std::ostream& os, const FloatInterval& i)
+{
+  return os << "[" << i.lower << " .. " << i.upper << "]";
+}
+
+FloatInterval toFloatInterval(const poly::Rational& r)
+{
+  return around(poly_utils::toRational(r).getDouble());
+}
+
+FloatInterval toFloatInterval(const poly::Integer& i)
+{
+  return around(poly_utils::toRational(i).getDouble());
+}
+
+FloatInterval toFloatInterval(const poly::Interval& i)
+{
+  return FloatInterval{toFloatInterval(get_lower(i)).lower,
+                       toFloatInterval(get_upper(i)).upper};
+}
+
+namespace {
+/**
+ * Callback for lp_polynomial_traverse. Assumes data is actually a vector of
+ * FloatPolynomial::Term and appends the current monomial to it.
+ */
+void collect_float_monomials(const lp_polynomial_context_t* ctx,
+                             lp_monomial_t* m,
+                             void* data)
+{
+  auto* terms = static_cast<std::vector<FloatPolynomial::Term>*>(data);
+  FloatPolynomial::Term term{toFloatInterval(poly::Integer(&m->a)), {}};
+  for (std::size_t i = 0; i < m->n; ++i)
+  {
+    term.d_powers.emplace_back(m->p[i].x, m->p[i].d);
+  }
+  terms->emplace_back(std::move(term));
+}
+}  // namespace
+
+FloatPolynomial::FloatPolynomial(const poly::Polynomial& p,
+                                 const poly::Rational& mult)
+{
+  lp_polynomial_traverse(p.get_internal(), collect_float_monomials, &d_terms);
+  FloatInterval fmult = toFloatInterval(mult);
+  for (auto& t : d_terms)
+  {
+    t.d_coeff = t.d_coeff * fmult;
+    for (const auto& vp : t.d_powers)
+    {
+      d_vars.emplace_back(vp.first);
+    }
+  }
+  std::sort(d_vars.begin(), d_vars.end());
+  d_vars.erase(std::unique(d_vars.begin(), d_vars.end()), d_vars.end());
+}
+
+FloatInterval FloatPolynomial::evaluate(const FloatBox& box) const
+{
+  FloatInterval res{0, 0};
+  for (const auto& t : d_terms)
+  {
+    FloatInterval term = t.d_coeff;
+    for (const auto& vp : t.d_powers)
+    {
+      Assert(vp.first < box.size());
+      term = term * pow(box[vp.first], vp.second);
+    }
+    res = res + term;
+    if (!res.hasLower() && !res.hasUpper())
+    {
+      break;
+    }
+  }
+  return res;
+}
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
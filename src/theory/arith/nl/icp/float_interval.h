@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Outward rounded floating point intervals for fast ICP-style propagation.
+ */
+
+#ifndef CVC5__THEORY__ARITH__ICP__FLOAT_INTERVAL_H
+#define CVC5__THEORY__ARITH__ICP__FLOAT_INTERVAL_H
+
+#include "cvc5_private.h"
+
+#ifdef CVC5_POLY_IMP
+#include <poly/polyxx.h>
+
+#include <cstddef>
+#include <iosfwd>
+#include <limits>
+#include <vector>
+
+namespace cvc5 {
+namespace theory {
+namespace arith {
+namespace nl {
+namespace icp {
+
+/**
+ * A closed interval [lower, upper] with double bounds. All operations round
+ * outwards, hence the result of an operation always contains the exact result
+ * of the same operation over the real numbers. Infinite bounds are allowed,
+ * open bounds are over-approximated by closed ones.
+ */
+struct FloatInterval
+{
+  /** The lower bound */
+  double lower = -std::numeric_limits<double>::infinity();
+  /** The upper bound */
+  double upper = std::numeric_limits<double>::infinity();
+
+  /** Whether this interval is empty */
+  bool isEmpty() const { return lower > upper; }
+  /** Whether the lower bound is finite */
+  bool hasLower() const
+  {
+    return lower != -std::numeric_limits<double>::infinity();
+  }
+  /** Whether the upper bound is finite */
+  bool hasUpper() const
+  {
+    return upper != std::numeric_limits<double>::infinity();
+  }
+  /** The width of this interval, possibly infinite */
+  double width() const { return upper - lower; }
+};
+
+/** Addition of intervals */
+FloatInterval operator+(const FloatInterval& a, const FloatInterval& b);
+/** Multiplication of intervals */
+FloatInterval operator*(const FloatInterval& a, const FloatInterval& b);
+/** The interval of all x^exp for x in a */
+FloatInterval pow(const FloatInterval& a, std::size_t exp);
+/** The intersection of two intervals, possibly empty */
+FloatInterval intersect(const FloatInterval& a, const FloatInterval& b);
+/** Print an interval */
+std::ostream& operator<<(std::ostream& os, const FloatInterval& i);
+
+/** The smallest float interval containing the given rational */
+FloatInterval toFloatInterval(const poly::Rational& r);
+/** The smallest float interval containing the given integer */
+FloatInterval toFloatInterval(const poly::Integer& i);
+/** A float interval containing the given (exact) interval */
+FloatInterval toFloatInterval(const poly::Interval& i);
+
+/**
+ * A float interval for every variable, indexed by the internal id of the
+ * poly::Variable.
+ */
+using FloatBox = std::vector<FloatInterval>;
+
+/**
+ * A polynomial with float interval coefficients that can be evaluated over a
+ * FloatBox. It is obtained from a poly::Polynomial and a rational multiplier
+ * by rounding every coefficient outwards, hence its evaluation always contains
+ * the exact evaluation of the original polynomial.
+ */
+class FloatPolynomial
+{
+ public:
+  /** A monomial coeff * prod_i var_i^exp_i */
+  struct Term
+  {
+    /** The coefficient */
+    FloatInterval d_coeff;
+    /** The variables (indices into a FloatBox) with their exponents */
+    std::vector<std::pair<std::size_t, std::size_t>> d_powers;
+  };
+
+  FloatPolynomial() = default;
+  /** Construct the float polynomial for mult * p */
+  FloatPolynomial(const poly::Polynomial& p, const poly::Rational& mult);
+
+  /**
+   * Evaluate over the given box, which must have an interval for every
+   * variable of this polynomial.
+   */
+  FloatInterval evaluate(const FloatBox& box) const;
+  /** The variables of this polynomial, as indices into a FloatBox */
+  const std::vector<std::size_t>& getVariables() const { return d_vars; }
+
+ private:
+  /** The terms of this polynomial */
+  std::vector<Term> d_terms;
+  /** The variables occurring in d_terms */
+  std::vector<std::size_t> d_vars;
+};
+
+}  // namespace icp
+}  // namespace nl
+}  // namespace arith
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
+
+#endif
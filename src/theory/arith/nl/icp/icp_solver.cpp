@@ -15,11 +15,15 @@
 
 #include "theory/arith/nl/icp/icp_solver.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <queue>
 
 #include "base/check.h"
 #include "base/output.h"
 #include "expr/node_algorithm.h"
+#include "options/arith_options.h"
 #include "theory/arith/arith_msum.h"
 #include "theory/arith/inference_manager.h"
 #include "theory/arith/nl/poly_conversion.h"
@@ -63,6 +67,34 @@ inline std::ostream& operator<<(std::ostream& os, const IAWrapper& iaw)
   }
   return os << " }";
 }
+
+/**
+ * Estimates how much the interval cur is contracted to next, relative to its
+ * size: 1 if next is empty or has a finite bound that is infinite in cur, and
+ * the relative reduction of the width or of the bounds otherwise.
+ */
+double relativeContraction(const FloatInterval& cur, const FloatInterval& next)
+{
+  if (next.isEmpty() || (!cur.hasLower() && next.hasLower())
+      || (!cur.hasUpper() && next.hasUpper()))
+  {
+    return 1;
+  }
+  if (cur.hasLower() && cur.hasUpper())
+  {
+    return cur.width() > 0 ? 1 - next.width() / cur.width() : 0;
+  }
+  // cur is unbounded on one side, compare the finite bound
+  if (cur.hasLower())
+  {
+    return (next.lower - cur.lower) / (1 + std::abs(cur.lower));
+  }
+  if (cur.hasUpper())
+  {
+    return (cur.upper - next.upper) / (1 + std::abs(cur.upper));
+  }
+  return 0;
+}
 }  // namespace
 
 std::vector<Node> ICPSolver::collectVariables(const Node& n) const
@@ -128,7 +160,13 @@ std::vector<Candidate> ICPSolver::constructCandidates(const Node& n)
       {
         rhsmult = poly_utils::toRational(veq_c.getConst<Rational>());
       }
-      Candidate res{lhs, rel, rhs, rhsmult, n, collectVariables(val)};
+      Candidate res{lhs,
+                    rel,
+                    rhs,
+                    rhsmult,
+                    n,
+                    collectVariables(val),
+                    FloatPolynomial(rhs, rhsmult)};
       Trace("nl-icp") << "\tAdded " << res << " from " << n << std::endl;
       result.emplace_back(res);
     }
@@ -153,7 +191,13 @@ std::vector<Candidate> ICPSolver::constructCandidates(const Node& n)
       {
         rhsmult = poly_utils::toRational(veq_c.getConst<Rational>());
       }
-      Candidate res{lhs, rel, rhs, rhsmult, n, collectVariables(val)};
+      Candidate res{lhs,
+                    rel,
+                    rhs,
+                    rhsmult,
+                    n,
+                    collectVariables(val),
+                    FloatPolynomial(rhs, rhsmult)};
       Trace("nl-icp") << "\tAdded " << res << " from " << n << std::endl;
       result.emplace_back(res);
     }
@@ -205,7 +249,34 @@ void ICPSolver::initOrigins()
   }
 }
 
-PropagationResult ICPSolver::doPropagationRound()
+void ICPSolver::initFloatBox()
+{
+  std::size_t size = 0;
+  for (const auto& vars : d_mapper.mVarCVCpoly)
+  {
+    size = std::max(size, vars.second.get_internal() + 1);
+  }
+  d_state.d_box.assign(size, FloatInterval());
+  for (const auto& vars : d_mapper.mVarCVCpoly)
+  {
+    if (d_state.d_assignment.has(vars.second))
+    {
+      d_state.d_box[vars.second.get_internal()] =
+          toFloatInterval(d_state.d_assignment.get(vars.second));
+    }
+  }
+  d_state.d_dependents.assign(size, {});
+  for (std::size_t i = 0, n = d_state.d_candidates.size(); i < n; ++i)
+  {
+    for (std::size_t v : d_state.d_candidates[i].frhs.getVariables())
+    {
+      Assert(v < size);
+      d_state.d_dependents[v].emplace_back(i);
+    }
+  }
+}
+
+PropagationResult ICPSolver::propagate()
 {
   if (d_budget <= 0)
   {
@@ -216,9 +287,33 @@ PropagationResult ICPSolver::doPropagationRound()
   Trace("nl-icp") << "Starting propagation with "
                   << IAWrapper{d_state.d_assignment, d_mapper} << std::endl;
   Trace("nl-icp") << "Current budget: " << d_budget << std::endl;
+  // Candidates to propagate, ordered by the relative contraction that caused
+  // them to be scheduled.
+  std::priority_queue<std::pair<double, std::size_t>> queue;
+  std::vector<bool> queued(d_state.d_candidates.size(), true);
+  for (std::size_t i = 0, n = d_state.d_candidates.size(); i < n; ++i)
+  {
+    queue.emplace(1.0, i);
+  }
   PropagationResult res = PropagationResult::NOT_CHANGED;
-  for (const auto& c : d_state.d_candidates)
+  while (!queue.empty() && d_budget > 0)
   {
+    std::size_t cid = queue.top().second;
+    queue.pop();
+    queued[cid] = false;
+    const Candidate& c = d_state.d_candidates[cid];
+    std::size_t lhs = c.lhs.get_internal();
+    double gain = 1;
+    if (options::nlICPFloat())
+    {
+      FloatInterval cur = d_state.d_box[lhs];
+      gain = relativeContraction(cur,
+                                 intersect(cur, c.propagateFloat(d_state.d_box)));
+      if (gain < options::nlICPMinContraction())
+      {
+        continue;
+      }
+    }
     --d_budget;
     PropagationResult cres = c.propagate(d_state.d_assignment, 100);
     switch (cres)
@@ -239,6 +334,10 @@ PropagationResult ICPSolver::doPropagationRound()
         d_state.d_conflict = d_state.d_origins.getOrigins(d_mapper(c.lhs));
         return PropagationResult::CONFLICT;
     }
+    if (cres == PropagationResult::NOT_CHANGED)
+    {
+      continue;
+    }
     switch (cres)
     {
       case PropagationResult::CONTRACTED_STRONGLY:
@@ -249,6 +348,16 @@ PropagationResult ICPSolver::doPropagationRound()
         break;
       default: break;
     }
+    // Update the float box and schedule the dependent candidates
+    d_state.d_box[lhs] = toFloatInterval(d_state.d_assignment.get(c.lhs));
+    for (std::size_t dep : d_state.d_dependents[lhs])
+    {
+      if (!queued[dep])
+      {
+        queued[dep] = true;
+        queue.emplace(gain, dep);
+      }
+    }
   }
   return res;
 }
@@ -327,36 +436,31 @@ void ICPSolver::check()
 {
   initOrigins();
   d_state.d_assignment = getBounds(d_mapper, d_state.d_bounds);
+  initFloatBox();
   bool did_progress = false;
-  bool progress = false;
-  do
+  switch (propagate())
   {
-    switch (doPropagationRound())
-    {
-      case icp::PropagationResult::NOT_CHANGED: progress = false; break;
-      case icp::PropagationResult::CONTRACTED:
-      case icp::PropagationResult::CONTRACTED_STRONGLY:
-      case icp::PropagationResult::CONTRACTED_WITHOUT_CURRENT:
-      case icp::PropagationResult::CONTRACTED_STRONGLY_WITHOUT_CURRENT:
-        did_progress = true;
-        progress = true;
-        break;
-      case icp::PropagationResult::CONFLICT:
-        Trace("nl-icp") << "Found a conflict: " << d_state.d_conflict
-                        << std::endl;
+    case icp::PropagationResult::NOT_CHANGED: break;
+    case icp::PropagationResult::CONTRACTED:
+    case icp::PropagationResult::CONTRACTED_STRONGLY:
+    case icp::PropagationResult::CONTRACTED_WITHOUT_CURRENT:
+    case icp::PropagationResult::CONTRACTED_STRONGLY_WITHOUT_CURRENT:
+      did_progress = true;
+      break;
+    case icp::PropagationResult::CONFLICT:
+      Trace("nl-icp") << "Found a conflict: " << d_state.d_conflict
+                      << std::endl;
 
-        std::vector<Node> mis;
-        for (const auto& n : d_state.d_conflict)
-        {
-          mis.emplace_back(n.negate());
-        }
-        d_im.addPendingLemma(NodeManager::currentNM()->mkOr(mis),
-                             InferenceId::ARITH_NL_ICP_CONFLICT);
-        did_progress = true;
-        progress = false;
-        break;
-    }
-  } while (progress);
+      std::vector<Node> mis;
+      for (const auto& n : d_state.d_conflict)
+      {
+        mis.emplace_back(n.negate());
+      }
+      d_im.addPendingLemma(NodeManager::currentNM()->mkOr(mis),
+                           InferenceId::ARITH_NL_ICP_CONFLICT);
+      did_progress = true;
+      break;
+  }
   if (did_progress)
   {
     std::vector<Node> lemmas = generateLemmas();
@@ -26,6 +26,7 @@
 #include "theory/arith/bound_inference.h"
 #include "theory/arith/nl/icp/candidate.h"
 #include "theory/arith/nl/icp/contraction_origins.h"
+#include "theory/arith/nl/icp/float_interval.h"
 #include "theory/arith/nl/icp/intersection.h"
 #include "theory/arith/nl/poly_conversion.h"
 
@@ -72,6 +73,13 @@ class ICPSolver
     ContractionOriginManager d_origins;
     /** The conflict, if any way found. Initially empty */
     std::vector<Node> d_conflict;
+    /** Float over-approximation of d_assignment, see FloatBox */
+    FloatBox d_box;
+    /**
+     * Maps every variable (as index into d_box) to the candidates whose right
+     * hand side contains it.
+     */
+    std::vector<std::vector<std::size_t>> d_dependents;
 
     /** Initialized the variable bounds with a variable mapper */
     ICPState(VariableMapper& vm) {}
@@ -84,6 +92,8 @@ class ICPSolver
       d_assignment.clear();
       d_origins = ContractionOriginManager();
       d_conflict.clear();
+      d_box.clear();
+      d_dependents.clear();
     }
   };
 
@@ -109,15 +119,25 @@ class ICPSolver
   void addCandidate(const Node& n);
   /** Initialize the origin manager from the variable bounds */
   void initOrigins();
+  /** Initialize the float box and the dependents from the assignment */
+  void initFloatBox();
 
   /**
-   * Perform one contraction with every candidate.
+   * Propagate the candidates until a fixpoint is reached or the budget is
+   * exhausted, in the style of HC4: candidates are kept in a priority queue,
+   * and after a candidate contracted some variable only the candidates that
+   * depend on this variable are scheduled again, prioritized by the relative
+   * amount of the contraction.
+   * Unless disabled by --nl-icp-float, every candidate is first evaluated
+   * with float interval arithmetic, and only if this indicates a sufficient
+   * contraction (or a conflict) the candidate is propagated exactly. Only the
+   * exact propagations use up the budget.
    * If any candidate yields a conflict stops immediately and returns
    * PropagationResult::CONFLICT. If any candidate yields a contraction returns
    * PropagationResult::CONTRACTED. Otherwise returns
    * PropagationResult::NOT_CHANGED.
    */
-  PropagationResult doPropagationRound();
+  PropagationResult propagate();
 
   /**
    * Construct lemmas for all bounds that have been improved.
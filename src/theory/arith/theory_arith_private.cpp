@@ -167,12 +167,19 @@ TheoryArithPrivate::TheoryArithPrivate(TheoryArith& containing,
       d_approxStats(NULL),
       d_attemptSolveIntTurnedOff(u, 0),
       d_dioSolveResources(0),
+      d_cutGenerator(nullptr),
+      d_tableauCutPool(u),
+      d_tableauCutRounds(0),
       d_solveIntMaybeHelp(0u),
       d_solveIntAttempts(0u),
       d_newFacts(false),
       d_previousStatus(Result::SAT_UNKNOWN),
       d_statistics("theory::arith::")
 {
+  if (options::arithCuts())
+  {
+    d_cutGenerator.reset(new CutGenerator(d_partialModel, d_tableau));
+  }
 }
 
 TheoryArithPrivate::~TheoryArithPrivate(){
@@ -515,6 +522,13 @@ bool TheoryArithPrivate::getDioCuttingResource(){
   }
 }
 
+bool TheoryArithPrivate::getTableauCuttingResource()
+{
+  uint32_t ratio = options::arithCutsRatio();
+  ++d_tableauCutRounds;
+  return ratio > 0 && d_tableauCutRounds % ratio == 0;
+}
+
 /* procedure AssertLower( x_i >= c_i ) */
 bool TheoryArithPrivate::AssertLower(ConstraintP constraint){
   Assert(constraint != NullConstraint);
@@ -1480,6 +1494,56 @@ TrustNode TheoryArithPrivate::dioCutting()
   }
 }
 
+bool TheoryArithPrivate::tableauCutting()
+{
+  Assert(d_cutGenerator != nullptr);
+  std::vector<TableauCut> cuts =
+      d_cutGenerator->generate(options::arithCutsPerRound());
+  NodeManager* nm = NodeManager::currentNM();
+  bool anythingNew = false;
+  for (const TableauCut& cut : cuts)
+  {
+    if (!complexityBelow(cut.d_lhs, options::lemmaRejectCutSize()))
+    {
+      ++(d_statistics.d_cutsRejectedDuringLemmas);
+      continue;
+    }
+    Node sum = toSumNode(d_partialModel, cut.d_lhs);
+    if (sum.isNull())
+    {
+      continue;
+    }
+    Node cutLit = Rewriter::rewrite(
+        nm->mkNode(kind::GEQ, sum, mkRationalNode(cut.d_rhs)));
+    if (cutLit.isConst() || d_tableauCutPool.contains(cutLit))
+    {
+      continue;
+    }
+    d_tableauCutPool.insert(cutLit);
+
+    Node exp = Constraint::externalExplainByAssertions(cut.d_explanation);
+    Node lemma = exp.impNode(cutLit);
+    Debug("arith::cuts") << "tableau cut from row of " << cut.d_basic
+                         << " (multiplier " << cut.d_multiplier
+                         << ", efficacy " << cut.d_efficacy << "): " << lemma
+                         << endl;
+    TrustNode tlem;
+    if (proofsEnabled())
+    {
+      // The cut was checked against its split-cut certificate by the
+      // generator; it is recorded as a trusted integer step.
+      tlem = d_pfGen->mkTrustNode(lemma, PfRule::INT_TRUST, {}, {lemma});
+    }
+    else
+    {
+      tlem = TrustNode::mkTrustLemma(lemma, nullptr);
+    }
+    outputTrustedLemma(tlem, InferenceId::ARITH_TABLEAU_CUT);
+    anythingNew = true;
+  }
+  return anythingNew;
+}
+
 Node TheoryArithPrivate::callDioSolver(){
   while(!d_constantIntegerVariables.empty()){
     ArithVar v = d_constantIntegerVariables.front();
@@ -3400,6 +3464,16 @@ bool TheoryArithPrivate::postCheck(Theory::Effort effortLevel)
       }
     }
 
+    if (!emmittedConflictOrSplit && d_cutGenerator != nullptr
+        && getTableauCuttingResource())
+    {
+      if (tableauCutting())
+      {
+        emmittedConflictOrSplit = true;
+        d_cutCount = d_cutCount + 1;
+      }
+    }
+
     if(!emmittedConflictOrSplit) {
       TrustNode possibleLemma = roundRobinBranch();
       if (!possibleLemma.getNode().isNull())
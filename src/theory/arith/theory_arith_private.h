@@ -34,6 +34,7 @@
 #include "theory/arith/attempt_solution_simplex.h"
 #include "theory/arith/congruence_manager.h"
 #include "theory/arith/constraint.h"
+#include "theory/arith/cut_generator.h"
 #include "theory/arith/delta_rational.h"
 #include "theory/arith/dio_solver.h"
 #include "theory/arith/dual_simplex.h"
@@ -766,6 +767,24 @@ private:
   int32_t d_dioSolveResources;
   bool getDioCuttingResource();
 
+  /** Generates cuts from the rows of the tableau, if --arith-cuts is on. */
+  std::unique_ptr<CutGenerator> d_cutGenerator;
+  /** The tableau cuts that have already been sent as lemmas. */
+  context::CDHashSet<Node, NodeHashFunction> d_tableauCutPool;
+  /** Counts the calls to getTableauCuttingResource(). */
+  uint32_t d_tableauCutRounds;
+  /**
+   * Returns true if this integer-infeasible full effort check should attempt
+   * tableau cuts rather than branching, according to --arith-cuts-ratio.
+   */
+  bool getTableauCuttingResource();
+  /**
+   * Sends the most efficacious Gomory and MIR cuts of the current tableau as
+   * lemmas of the form (=> (and bounds) cut). Returns true if any new lemma
+   * was sent.
+   */
+  bool tableauCutting();
+
   uint32_t d_solveIntMaybeHelp, d_solveIntAttempts;
 
   RationalVector d_farkasBuffer;
@@ -82,6 +82,8 @@ TheoryArrays::TheoryArrays(context::Context* c,
           name + "number of setModelVal splits")),
       d_numSetModelValConflicts(smtStatisticsRegistry().registerInt(
           name + "number of setModelVal conflicts")),
+      d_numWeakEquivLemmas(smtStatisticsRegistry().registerInt(
+          name + "number of weak equivalence lemmas")),
       d_ppEqualityEngine(u, name + "pp", true),
       d_ppFacts(u),
       d_state(c, u, valuation),
@@ -110,7 +112,6 @@ TheoryArrays::TheoryArrays(context::Context* c,
       d_modelConstraints(c),
       d_lemmasSaved(c),
       d_defValues(c),
-      d_readTableContext(new context::Context()),
       d_arrayMerges(c),
       d_inCheckModel(false),
       d_dstrat(new TheoryArraysDecisionStrategy(this)),
@@ -130,11 +131,6 @@ TheoryArrays::TheoryArrays(context::Context* c,
 }
 
 TheoryArrays::~TheoryArrays() {
-  vector<CTNodeList*>::iterator it = d_readBucketAllocations.begin(), iend = d_readBucketAllocations.end();
-  for (; it != iend; ++it) {
-    (*it)->deleteSelf();
-  }
-  delete d_readTableContext;
   CNodeNListMap::iterator it2 = d_constReads.begin();
   for( ; it2 != d_constReads.end(); ++it2 ) {
     it2->second->deleteSelf();
@@ -425,27 +421,76 @@ TNode TheoryArrays::weakEquivGetRep(TNode node) {
   }
 }
 
-TNode TheoryArrays::weakEquivGetRepIndex(TNode node, TNode index) {
+TNode TheoryArrays::weakEquivNextIndex(TNode node, TNode index)
+{
   Assert(!index.isNull());
-  TNode pointer, index2;
-  while (true) {
-    pointer = d_infoMap.getWeakEquivPointer(node);
-    if (pointer.isNull()) {
-      return node;
-    }
-    index2 = d_infoMap.getWeakEquivIndex(node);
-    if (index2.isNull() || !d_equalityEngine->areEqual(index, index2))
+  TNode pointer = d_infoMap.getWeakEquivPointer(node);
+  if (pointer.isNull())
+  {
+    return pointer;
+  }
+  TNode index2 = d_infoMap.getWeakEquivIndex(node);
+  if (index2.isNull() || !d_equalityEngine->areEqual(index, index2))
+  {
+    return pointer;
+  }
+  return d_infoMap.getWeakEquivSecondary(node);
+}
+
+TNode TheoryArrays::weakEquivGetRepIndex(TNode node, TNode index) {
+  TNode next;
+  while (!(next = weakEquivNextIndex(node, index)).isNull())
+  {
+    node = next;
+  }
+  return node;
+}
+
+TNode TheoryArrays::weakEquivGetRepIndex(TNode node,
+                                         TNode index,
+                                         WeakEquivRepIndexCache& cache)
+{
+  TNode indexRep = d_equalityEngine->getRepresentative(index);
+  std::vector<TNode> path;
+  TNode next;
+  while (true)
+  {
+    WeakEquivRepIndexCache::const_iterator it =
+        cache.find(std::make_pair(node, indexRep));
+    if (it != cache.end())
     {
-      node = pointer;
+      node = it->second;
+      break;
     }
-    else {
-      TNode secondary = d_infoMap.getWeakEquivSecondary(node);
-      if (secondary.isNull()) {
-        return node;
-      }
-      node = secondary;
+    path.push_back(node);
+    next = weakEquivNextIndex(node, index);
+    if (next.isNull())
+    {
+      break;
     }
+    node = next;
+  }
+  // all nodes on the path have the same representative
+  for (TNode n : path)
+  {
+    cache[std::make_pair(n, indexRep)] = node;
   }
+  return node;
+}
+
+TNode TheoryArrays::weakEquivGetMeetIndex(TNode a, TNode b, TNode index)
+{
+  std::unordered_set<TNode, TNodeHashFunction> path;
+  for (TNode n = a; !n.isNull(); n = weakEquivNextIndex(n, index))
+  {
+    path.insert(n);
+  }
+  while (path.find(b) == path.end())
+  {
+    b = weakEquivNextIndex(b, index);
+    Assert(!b.isNull());
+  }
+  return b;
 }
 
 void TheoryArrays::visitAllLeaves(TNode reason, vector<TNode>& conjunctions) {
@@ -467,10 +512,14 @@ void TheoryArrays::visitAllLeaves(TNode reason, vector<TNode>& conjunctions) {
   }
 }
 
-void TheoryArrays::weakEquivBuildCond(TNode node, TNode index, vector<TNode>& conjunctions) {
+void TheoryArrays::weakEquivBuildCond(TNode node,
+                                      TNode index,
+                                      vector<TNode>& conjunctions,
+                                      TNode stop)
+{
   Assert(!index.isNull());
   TNode pointer, index2;
-  while (true) {
+  while (node != stop) {
     pointer = d_infoMap.getWeakEquivPointer(node);
     if (pointer.isNull()) {
       return;
@@ -1228,68 +1277,69 @@ void TheoryArrays::postCheck(Effort level)
     checkWeakEquiv(true);
 #endif
 
-    d_readTableContext->push();
-    TNode mayRep, iRep;
-    CTNodeList* bucketList = NULL;
-    CTNodeList::const_iterator i = d_reads.begin(), readsEnd = d_reads.end();
-    for (; i != readsEnd; ++i) {
-      const TNode& r = *i;
-
-      Debug("arrays::weak") << "TheoryArrays::check(): checking read " << r << std::endl;
-
-      // Find the bucket for this read.
-      mayRep = d_mayEqualEqualityEngine.getRepresentative(r[0]);
-      iRep = d_equalityEngine->getRepresentative(r[1]);
-      std::pair<TNode, TNode> key(mayRep, iRep);
-      ReadBucketMap::iterator rbm_it = d_readBucketTable.find(key);
-      if (rbm_it == d_readBucketTable.end())
+    // Two reads r and r2 with equal indices i must be equal if their arrays
+    // have the same i-weak equivalence representative. We index the reads by
+    // this representative and the representative of their index, so that it
+    // suffices to compare each read with the first read of its key. The
+    // representatives are cached for the whole path to them.
+    WeakEquivRepIndexCache cache;
+    // maps keys to their first read, and whether a violated instance of the
+    // key was found already
+    std::unordered_map<std::pair<TNode, TNode>,
+                       std::pair<TNode, bool>,
+                       TNodePairHashFunction>
+        readIndex;
+    std::vector<std::pair<TNode, TNode>> violated;
+    for (const TNode& r : d_reads)
+    {
+      Debug("arrays::weak")
+          << "TheoryArrays::check(): checking read " << r << std::endl;
+      TNode iRep = d_equalityEngine->getRepresentative(r[1]);
+      std::pair<TNode, TNode> key(weakEquivGetRepIndex(r[0], r[1], cache),
+                                  iRep);
+      std::pair<TNode, bool>& entry = readIndex[key];
+      if (entry.first.isNull())
       {
-        bucketList = new(true) CTNodeList(d_readTableContext);
-        d_readBucketAllocations.push_back(bucketList);
-        d_readBucketTable[key] = bucketList;
-      }
-      else {
-        bucketList = rbm_it->second;
+        entry.first = r;
       }
-      CTNodeList::const_iterator ctnl_it = bucketList->begin(),
-                                 ctnl_iend = bucketList->end();
-      for (; ctnl_it != ctnl_iend; ++ctnl_it)
+      else if (!entry.second && !d_equalityEngine->areEqual(r, entry.first))
       {
-        const TNode& r2 = *ctnl_it;
-        Assert(r2.getKind() == kind::SELECT);
-        Assert(mayRep == d_mayEqualEqualityEngine.getRepresentative(r2[0]));
-        Assert(iRep == d_equalityEngine->getRepresentative(r2[1]));
-        if (d_equalityEngine->areEqual(r, r2))
-        {
-          continue;
-        }
-        if (weakEquivGetRepIndex(r[0], r[1]) == weakEquivGetRepIndex(r2[0], r[1])) {
-          // add lemma: r[1] = r2[1] /\ cond(r[0],r2[0]) => r = r2
-          vector<TNode> conjunctions;
-          Assert(d_equalityEngine->areEqual(r, Rewriter::rewrite(r)));
-          Assert(d_equalityEngine->areEqual(r2, Rewriter::rewrite(r2)));
-          Node lemma = Rewriter::rewrite(r).eqNode(Rewriter::rewrite(r2)).negate();
-          d_permRef.push_back(lemma);
-          conjunctions.push_back(lemma);
-          if (r[1] != r2[1]) {
-            d_equalityEngine->explainEquality(r[1], r2[1], true, conjunctions);
-          }
-          // TODO: get smaller lemmas by eliminating shared parts of path
-          weakEquivBuildCond(r[0], r[1], conjunctions);
-          weakEquivBuildCond(r2[0], r[1], conjunctions);
-          lemma = mkAnd(conjunctions, true);
-          // LSH FIXME: which kind of arrays lemma is this
-          Trace("arrays-lem")
-              << "Arrays::addExtLemma (weak-eq) " << lemma << "\n";
-          d_out->lemma(lemma, LemmaProperty::SEND_ATOMS);
-          d_readTableContext->pop();
-          Trace("arrays") << spaces(getSatContext()->getLevel()) << "Arrays::check(): done" << endl;
-          return;
-        }
+        // only one lemma per key, the others are likely implied
+        entry.second = true;
+        violated.push_back(std::make_pair(entry.first, r));
       }
-      bucketList->push_back(r);
     }
-    d_readTableContext->pop();
+    for (const std::pair<TNode, TNode>& v : violated)
+    {
+      TNode r = v.first;
+      TNode r2 = v.second;
+      Assert(r.getKind() == kind::SELECT && r2.getKind() == kind::SELECT);
+      // add lemma: r[1] = r2[1] /\ cond(r[0],r2[0]) => r = r2
+      vector<TNode> conjunctions;
+      Assert(d_equalityEngine->areEqual(r, Rewriter::rewrite(r)));
+      Assert(d_equalityEngine->areEqual(r2, Rewriter::rewrite(r2)));
+      Node lemma = Rewriter::rewrite(r).eqNode(Rewriter::rewrite(r2)).negate();
+      d_permRef.push_back(lemma);
+      conjunctions.push_back(lemma);
+      if (r[1] != r2[1]) {
+        d_equalityEngine->explainEquality(r[1], r2[1], true, conjunctions);
+      }
+      // the paths of r[0] and r2[0] coincide after they meet, so the
+      // conditions are only needed up to there
+      TNode meet = weakEquivGetMeetIndex(r[0], r2[0], r[1]);
+      weakEquivBuildCond(r[0], r[1], conjunctions, meet);
+      weakEquivBuildCond(r2[0], r[1], conjunctions, meet);
+      lemma = mkAnd(conjunctions, true);
+      // LSH FIXME: which kind of arrays lemma is this
+      Trace("arrays-lem") << "Arrays::addExtLemma (weak-eq) " << lemma << "\n";
+      d_out->lemma(lemma, LemmaProperty::SEND_ATOMS);
+      ++d_numWeakEquivLemmas;
+    }
+    if (!violated.empty())
+    {
+      Trace("arrays") << spaces(getSatContext()->getLevel()) << "Arrays::check(): done" << endl;
+      return;
+    }
   }
 
   if (!options::arraysEagerLemmas() && fullEffort(level)
@@ -130,6 +130,8 @@ class TheoryArrays : public Theory {
   IntStat d_numSetModelValSplits;
   /** conflicts in setModelVal */
   IntStat d_numSetModelValConflicts;
+  /** number of lemmas from weak equivalence */
+  IntStat d_numWeakEquivLemmas;
 
  public:
   TheoryArrays(context::Context* c,
@@ -287,10 +289,40 @@ class TheoryArrays : public Theory {
   //--------------------------------- end standard check
 
  private:
+  /**
+   * Cache of weakEquivGetRepIndex during one check, keyed by the node and the
+   * representative of the index.
+   */
+  typedef std::unordered_map<std::pair<TNode, TNode>,
+                             TNode,
+                             TNodePairHashFunction>
+      WeakEquivRepIndexCache;
+
   TNode weakEquivGetRep(TNode node);
+  /** The next node on the path of node to its index-representative */
+  TNode weakEquivNextIndex(TNode node, TNode index);
   TNode weakEquivGetRepIndex(TNode node, TNode index);
+  /**
+   * Same as above, caches the result for all nodes on the path to the
+   * representative.
+   */
+  TNode weakEquivGetRepIndex(TNode node,
+                             TNode index,
+                             WeakEquivRepIndexCache& cache);
+  /**
+   * Get the first node on the path of a to its index-representative that is
+   * also on the path of b.
+   */
+  TNode weakEquivGetMeetIndex(TNode a, TNode b, TNode index);
   void visitAllLeaves(TNode reason, std::vector<TNode>& conjunctions);
-  void weakEquivBuildCond(TNode node, TNode index, std::vector<TNode>& conjunctions);
+  /**
+   * Add the conditions for node being index-weakly equivalent to the nodes on
+   * its path up to stop, or up to its index-representative if stop is null.
+   */
+  void weakEquivBuildCond(TNode node,
+                          TNode index,
+                          std::vector<TNode>& conjunctions,
+                          TNode stop = TNode());
   void weakEquivMakeRep(TNode node);
   void weakEquivMakeRepIndex(TNode node);
   void weakEquivAddSecondary(TNode index, TNode arrayFrom, TNode arrayTo, TNode reason);
@@ -427,11 +459,7 @@ class TheoryArrays : public Theory {
   typedef context::CDHashMap<Node,Node,NodeHashFunction> DefValMap;
   DefValMap d_defValues;
 
-  typedef std::unordered_map<std::pair<TNode, TNode>, CTNodeList*, TNodePairHashFunction> ReadBucketMap;
-  ReadBucketMap d_readBucketTable;
-  context::Context* d_readTableContext;
   context::CDList<Node> d_arrayMerges;
-  std::vector<CTNodeList*> d_readBucketAllocations;
 
   Node getSkolem(TNode ref);
   Node mkAnd(std::vector<TNode>& conjunctions, bool invert = false, unsigned startIndex = 0);
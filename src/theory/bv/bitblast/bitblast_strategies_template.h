@@ -18,10 +18,12 @@
 #ifndef CVC5__THEORY__BV__BITBLAST__BITBLAST_STRATEGIES_TEMPLATE_H
 #define CVC5__THEORY__BV__BITBLAST__BITBLAST_STRATEGIES_TEMPLATE_H
 
+#include <algorithm>
 #include <cmath>
 #include <ostream>
 
 #include "expr/node.h"
+#include "options/bv_options.h"
 #include "theory/bv/bitblast/bitblast_utils.h"
 #include "theory/bv/theory_bv_utils.h"
 #include "theory/rewriter.h"
@@ -357,35 +359,69 @@ void DefaultMultBB (TNode node, std::vector<T>& res, TBitblaster<T>* bb) {
   Debug("bitvector") << "theory::bv:: DefaultMultBB bitblasting "<< node << "\n";
   Assert(res.size() == 0 && node.getKind() == kind::BITVECTOR_MULT);
 
-  // if (node.getNumChildren() == 2) {
-  //   std::vector<T> a;
-  //   std::vector<T> b;
-  //   bb->bbTerm(node[0], a);
-  //   bb->bbTerm(node[1], b);
-  //   unsigned bw = utils::getSize(node);
-  //   unsigned thresh = bw % 2 ? bw/2 : bw/2 - 1;
-  //   bool no_overflow = true; 
-  //   for (unsigned i = thresh; i < bw; ++i) {
-  //     if (a[i] != mkFalse<T> || b[i] != mkFalse<T> ) {
-  //       no_overflow = false; 
-  //     }
-  //   }
-  //   if (no_overflow) {
-  //     shiftAddMultiplier(); 
-  //     return; 
-  //   }
-    
-  // }
-  
-  std::vector<T> newres; 
-  bb->bbTerm(node[0], res); 
-  for(unsigned i = 1; i < node.getNumChildren(); ++i) {
-    std::vector<T> current;
-    bb->bbTerm(node[i], current);
-    newres.clear(); 
-    // constructs a simple shift and add multiplier building the result
-    // in res
-    shiftAddMultiplier(res, current, newres);
+  // With --bv-mult-const, fold the constant factors into a single constant,
+  // which is multiplied with a constant multiplier. With --bv-mult-share,
+  // order the other factors, so that the products of the same factors share
+  // their circuits.
+  unsigned size = utils::getSize(node);
+  BitVector c = BitVector::mkOne(size);
+  std::vector<Node> factors;
+  for (const Node& child : node) {
+    if (options::bvMultConst() && child.isConst()) {
+      c = c * child.getConst<BitVector>();
+    } else {
+      factors.push_back(child);
+    }
+  }
+  if (options::bvMultShare()) {
+    std::sort(factors.begin(), factors.end());
+  }
+
+  if (factors.empty()) {
+    DefaultConstBB(utils::mkConst(c), res, bb);
+    return;
+  }
+
+  bb->bbTerm(factors[0], res);
+  NodeManager* nm = NodeManager::currentNM();
+  for (size_t i = 1; i < factors.size(); ++i) {
+    Node product;
+    if (options::bvMultShare()) {
+      product = nm->mkNode(kind::BITVECTOR_MULT,
+                           std::vector<Node>(factors.begin(),
+                                             factors.begin() + i + 1));
+      if (bb->hasBBProduct(product)) {
+        res.clear();
+        bb->getBBProduct(product, res);
+        continue;
+      }
+    }
+    std::vector<T> current, newres;
+    bb->bbTerm(factors[i], current);
+    switch (options::bvMultiplier()) {
+      case options::BvMultiplierMode::WALLACE:
+        treeMultiplier(res, current, newres, false);
+        break;
+      case options::BvMultiplierMode::DADDA:
+        treeMultiplier(res, current, newres, true);
+        break;
+      case options::BvMultiplierMode::BOOTH:
+        boothMultiplier(res, current, newres);
+        break;
+      default:
+        // constructs a simple shift and add multiplier building the result
+        // in res
+        shiftAddMultiplier(res, current, newres);
+    }
+    res = newres;
+    if (!product.isNull()) {
+      bb->storeBBProduct(product, res);
+    }
+  }
+
+  if (c != BitVector::mkOne(size)) {
+    std::vector<T> newres;
+    constantMultiplier(res, c, newres);
     res = newres;
   }
   if(Debug.isOn("bitvector-bb")) {
@@ -18,8 +18,10 @@
 #ifndef CVC5__THEORY__BV__BITBLAST__BITBLAST_UTILS_H
 #define CVC5__THEORY__BV__BITBLAST__BITBLAST_UTILS_H
 
+#include <algorithm>
 #include <ostream>
 #include "expr/node.h"
+#include "util/bitvector.h"
 
 namespace cvc5 {
 namespace theory {
@@ -218,6 +220,229 @@ inline void shiftAddMultiplier(const std::vector<T>&a, const std::vector<T>&b, s
   }
 }
 
+/**
+ * Full adder.
+ *
+ * @param a, b, c the bits to be added
+ * @param carry the carry-out
+ *
+ * @return the sum bit
+ */
+template <class T>
+T inline fullAdder(T a, T b, T c, T& carry) {
+  T a_xor_b = mkXor(a, b);
+  carry = mkOr(mkAnd(a, b), mkAnd(a_xor_b, c));
+  return mkXor(a_xor_b, c);
+}
+
+/**
+ * Reduces the columns of a multi-operand addition to at most two bits per
+ * column with full and half adders, where cols[i] holds the bits of weight
+ * 2^i. Carries out of the last column are dropped, i.e., the sum is computed
+ * modulo 2^cols.size().
+ *
+ * If dadda is true, every stage reduces the columns only as far as needed to
+ * reach the next height of the Dadda sequence 2, 3, 4, 6, 9, ..., which
+ * minimizes the number of adders. Otherwise, every stage reduces all columns
+ * with more than two bits as far as possible (Wallace tree).
+ */
+template <class T>
+inline void compressColumns(std::vector<std::vector<T>>& cols, bool dadda) {
+  size_t n = cols.size();
+  size_t max_height = 0;
+  for (const std::vector<T>& col : cols) {
+    max_height = std::max(max_height, col.size());
+  }
+
+  if (dadda) {
+    std::vector<size_t> heights(1, 2);
+    while (heights.back() < max_height) {
+      heights.push_back(heights.back() * 3 / 2);
+    }
+    heights.pop_back();
+    for (auto it = heights.rbegin(); it != heights.rend(); ++it) {
+      size_t d = *it;
+      for (size_t c = 0; c < n; ++c) {
+        // The height of cols[c] includes the carries from cols[c-1] of this
+        // stage. New sum bits are queued at the end of the column.
+        std::vector<T>& col = cols[c];
+        size_t i = 0;
+        while (col.size() - i > d) {
+          T carry;
+          if (col.size() - i == d + 1) {
+            carry = mkAnd(col[i], col[i + 1]);
+            col.push_back(mkXor(col[i], col[i + 1]));
+            i += 2;
+          } else {
+            T sum = fullAdder(col[i], col[i + 1], col[i + 2], carry);
+            col.push_back(sum);
+            i += 3;
+          }
+          if (c + 1 < n) {
+            cols[c + 1].push_back(carry);
+          }
+        }
+        col.erase(col.begin(), col.begin() + i);
+      }
+    }
+    return;
+  }
+
+  while (max_height > 2) {
+    std::vector<std::vector<T>> next(n);
+    for (size_t c = 0; c < n; ++c) {
+      const std::vector<T>& col = cols[c];
+      if (col.size() <= 2) {
+        next[c].insert(next[c].end(), col.begin(), col.end());
+        continue;
+      }
+      size_t i = 0;
+      for (; i + 2 < col.size(); i += 3) {
+        T carry;
+        next[c].push_back(fullAdder(col[i], col[i + 1], col[i + 2], carry));
+        if (c + 1 < n) {
+          next[c + 1].push_back(carry);
+        }
+      }
+      if (i + 2 == col.size()) {
+        next[c].push_back(mkXor(col[i], col[i + 1]));
+        if (c + 1 < n) {
+          next[c + 1].push_back(mkAnd(col[i], col[i + 1]));
+        }
+      } else if (i + 1 == col.size()) {
+        next[c].push_back(col[i]);
+      }
+    }
+    cols.swap(next);
+    max_height = 0;
+    for (const std::vector<T>& col : cols) {
+      max_height = std::max(max_height, col.size());
+    }
+  }
+}
+
+/**
+ * Adds up columns of bits as produced by compressColumns() with a final
+ * ripple carry adder, modulo 2^cols.size().
+ */
+template <class T>
+inline void addColumns(std::vector<std::vector<T>>& cols, std::vector<T>& res) {
+  Assert(res.size() == 0);
+  compressColumns(cols, true);
+  std::vector<T> a, b;
+  bool single = true;
+  for (const std::vector<T>& col : cols) {
+    Assert(col.size() <= 2);
+    a.push_back(col.size() > 0 ? col[0] : mkFalse<T>());
+    b.push_back(col.size() > 1 ? col[1] : mkFalse<T>());
+    single = single && col.size() <= 1;
+  }
+  if (single) {
+    res = a;
+    return;
+  }
+  rippleCarryAdder(a, b, res, mkFalse<T>());
+}
+
+/**
+ * Multiplier that adds up all partial products a[j] & b[i] in a Wallace
+ * (dadda = false) or Dadda (dadda = true) tree, see compressColumns().
+ */
+template <class T>
+inline void treeMultiplier(const std::vector<T>& a,
+                           const std::vector<T>& b,
+                           std::vector<T>& res,
+                           bool dadda) {
+  Assert(a.size() == b.size() && res.size() == 0);
+  size_t n = a.size();
+  std::vector<std::vector<T>> cols(n);
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; i + j < n; ++j) {
+      cols[i + j].push_back(mkAnd(a[j], b[i]));
+    }
+  }
+  compressColumns(cols, dadda);
+  addColumns(cols, res);
+}
+
+/**
+ * Multiplier with radix-4 Booth recoding of b, which halves the number of
+ * partial products. Digit k of the recoding is
+ *   -2 * b[2k+1] + b[2k] + b[2k-1]
+ * and selects the partial product 0, a, 2a, -a or -2a, where negative
+ * partial products are encoded in two's complement as the negated bits plus
+ * a correction bit. The partial products are added in a Dadda tree.
+ */
+template <class T>
+inline void boothMultiplier(const std::vector<T>& a,
+                            const std::vector<T>& b,
+                            std::vector<T>& res) {
+  Assert(a.size() == b.size() && res.size() == 0);
+  size_t n = a.size();
+  std::vector<std::vector<T>> cols(n);
+  T prev = mkFalse<T>();
+  for (size_t i = 0; i < n; i += 2) {
+    T cur = b[i];
+    T neg = i + 1 < n ? b[i + 1] : mkFalse<T>();
+    // |digit| = 1 iff b[2k] != b[2k-1], |digit| = 2 iff all three bits of the
+    // digit are 100 or 011
+    T one = mkXor(cur, prev);
+    T two = mkOr(mkAnd(neg, mkAnd(mkNot(cur), mkNot(prev))),
+                 mkAnd(mkNot(neg), mkAnd(cur, prev)));
+    for (size_t j = 0; i + j < n; ++j) {
+      T bit = j == 0 ? mkAnd(one, a[0])
+                     : mkOr(mkAnd(one, a[j]), mkAnd(two, a[j - 1]));
+      cols[i + j].push_back(mkXor(bit, neg));
+    }
+    cols[i].push_back(neg);
+    prev = neg;
+  }
+  addColumns(cols, res);
+}
+
+/**
+ * Multiplier for a constant c, which only adds up the shifted copies of a for
+ * the bits set in c. If -c has fewer bits set than c, computes -(a * -c)
+ * instead.
+ */
+template <class T>
+inline void constantMultiplier(const std::vector<T>& a,
+                               const BitVector& c,
+                               std::vector<T>& res) {
+  Assert(a.size() == c.getSize() && res.size() == 0);
+  size_t n = a.size();
+  auto countBits = [n](const BitVector& v) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+      count += v.isBitSet(i) ? 1 : 0;
+    }
+    return count;
+  };
+  BitVector neg_c = -c;
+  // negating the result costs another adder
+  bool negate = countBits(neg_c) + 1 < countBits(c);
+  const BitVector& m = negate ? neg_c : c;
+
+  std::vector<std::vector<T>> cols(n);
+  for (size_t k = 0; k < n; ++k) {
+    if (!m.isBitSet(k)) {
+      continue;
+    }
+    for (size_t j = 0; j + k < n; ++j) {
+      cols[j + k].push_back(a[j]);
+    }
+  }
+  addColumns(cols, res);
+
+  if (negate) {
+    std::vector<T> not_res, zero, neg_res;
+    negateBits(res, not_res);
+    makeZero(zero, n);
+    rippleCarryAdder(not_res, zero, neg_res, mkTrue<T>());
+    res = neg_res;
+  }
+}
+
 template <class T>
 T inline uLessThanBB(const std::vector<T>&a, const std::vector<T>& b, bool orEqual) {
   Assert(a.size() && b.size());
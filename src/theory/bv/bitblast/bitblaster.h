@@ -61,6 +61,8 @@ class TBitblaster
 
   // caches and mappings
   TermDefMap d_termCache;
+  // circuits of products of non-constant factors for --bv-mult-share
+  TermDefMap d_productCache;
   ModelCache d_modelCache;
   // sat solver used for bitblasting and associated CnfStream
   std::unique_ptr<context::Context> d_nullContext;
@@ -92,6 +94,15 @@ class TBitblaster
   void getBBTerm(TNode node, Bits& bits) const;
   virtual void storeBBTerm(TNode term, const Bits& bits);
 
+  /**
+   * Cache for the circuits of products of non-constant factors, which are
+   * given as BITVECTOR_MULT nodes over the ordered factors. Lets DefaultMultBB
+   * share the circuit of the same factors between multiplications.
+   */
+  bool hasBBProduct(TNode product) const;
+  void getBBProduct(TNode product, Bits& bits) const;
+  void storeBBProduct(TNode product, const Bits& bits);
+
   /**
    * Return a constant representing the value of a in the  model.
    * If fullModel is true set unconstrained bits to 0. If not return
@@ -181,6 +192,7 @@ void TBitblaster<T>::initTermBBStrategies()
 template <class T>
 TBitblaster<T>::TBitblaster()
     : d_termCache(),
+      d_productCache(),
       d_modelCache(),
       d_nullContext(new context::Context()),
       d_cnfStream()
@@ -207,6 +219,25 @@ void TBitblaster<T>::storeBBTerm(TNode node, const Bits& bits)
   d_termCache.insert(std::make_pair(node, bits));
 }
 
+template <class T>
+bool TBitblaster<T>::hasBBProduct(TNode product) const
+{
+  return d_productCache.find(product) != d_productCache.end();
+}
+
+template <class T>
+void TBitblaster<T>::getBBProduct(TNode product, Bits& bits) const
+{
+  Assert(hasBBProduct(product));
+  bits = d_productCache.find(product)->second;
+}
+
+template <class T>
+void TBitblaster<T>::storeBBProduct(TNode product, const Bits& bits)
+{
+  d_productCache.insert(std::make_pair(product, bits));
+}
+
 template <class T>
 void TBitblaster<T>::invalidateModelCache()
 {
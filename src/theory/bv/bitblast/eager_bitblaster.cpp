@@ -19,6 +19,7 @@
 #include "options/bv_options.h"
 #include "options/smt_options.h"
 #include "prop/cnf_stream.h"
+#include "prop/sat_preprocessor.h"
 #include "prop/sat_solver_factory.h"
 #include "smt/smt_engine.h"
 #include "smt/smt_statistics_registry.h"
@@ -69,6 +70,11 @@ EagerBitblaster::EagerBitblaster(BVSolverLazy* theory_bv, context::Context* c)
       break;
     default: Unreachable() << "Unknown SAT solver type";
   }
+  if (options::bvSatPreprocess())
+  {
+    solver = new prop::SatPreprocessor(
+        solver, smtStatisticsRegistry(), "theory::bv::EagerBitblaster::");
+  }
   d_satSolver.reset(solver);
   ResourceManager* rm = smt::currentResourceManager();
   d_cnfStream.reset(new prop::CnfStream(d_satSolver.get(),
@@ -23,6 +23,7 @@
 #include "smt/smt_engine.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/bv/abstraction.h"
+#include "theory/bv/bitblast/shared_bb_cache.h"
 #include "theory/bv/bv_solver_lazy.h"
 #include "theory/bv/theory_bv.h"
 #include "theory/bv/theory_bv_utils.h"
@@ -167,12 +168,30 @@ void TLazyBitblaster::bbAtom(TNode node)
 
   // the bitblasted definition of the atom
   Node normalized = Rewriter::rewrite(node);
-  Node atom_bb =
-      normalized.getKind() != kind::CONST_BOOLEAN
-          ? d_atomBBStrategies[normalized.getKind()](normalized, this)
-          : normalized;
-
-  atom_bb = Rewriter::rewrite(atom_bb);
+  Node atom_bb;
+  if (normalized.getKind() == kind::CONST_BOOLEAN)
+  {
+    atom_bb = normalized;
+  }
+  else if (SharedBBCache::isEnabled()
+           && !(atom_bb = SharedBBCache::getAtom(normalized)).isNull())
+  {
+    // register the variables of the atom
+    for (const Node& child : normalized)
+    {
+      Bits bits;
+      bbTerm(child, bits);
+    }
+  }
+  else
+  {
+    atom_bb = Rewriter::rewrite(
+        d_atomBBStrategies[normalized.getKind()](normalized, this));
+    if (SharedBBCache::isEnabled())
+    {
+      SharedBBCache::storeAtom(normalized, atom_bb);
+    }
+  }
 
   // asserting that the atom is true iff the definition holds
   Node atom_definition = nm->mkNode(kind::EQUAL, node, atom_bb);
@@ -229,7 +248,28 @@ void TLazyBitblaster::bbTerm(TNode node, Bits& bits) {
   Debug("bitvector-bitblast") << "Bitblasting term " << node <<"\n";
   ++d_statistics.d_numTerms;
 
-  d_termBBStrategies[node.getKind()] (node, bits,this);
+  bool shared =
+      SharedBBCache::isEnabled() && !Theory::isLeafOf(node, THEORY_BV);
+  if (shared && SharedBBCache::getTerm(node, bits))
+  {
+    // register the variables below node
+    for (const Node& child : node)
+    {
+      if (child.getType().isBitVector())
+      {
+        Bits cbits;
+        bbTerm(child, cbits);
+      }
+    }
+  }
+  else
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+    if (shared)
+    {
+      SharedBBCache::storeTerm(node, bits);
+    }
+  }
 
   Assert(bits.size() == utils::getSize(node));
 
@@ -557,6 +597,7 @@ void TLazyBitblaster::clearSolver() {
   d_bbAtoms.clear();
   d_variables.clear();
   d_termCache.clear();
+  d_productCache.clear();
 
   invalidateModelCache();
   // recreate sat solver
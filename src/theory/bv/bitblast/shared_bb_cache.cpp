@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Bit-blasting cache shared between bit-blaster instances.
+ */
+
+#include "theory/bv/bitblast/shared_bb_cache.h"
+
+#include "expr/attribute.h"
+#include "options/bv_options.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/**
+ * Maps bit-vector terms to a BITVECTOR_BB_TERM over their bits, and atoms to
+ * their bit-blasted definition.
+ */
+struct SharedBBTermAttributeId
+{
+};
+using SharedBBTermAttribute = expr::Attribute<SharedBBTermAttributeId, Node>;
+struct SharedBBAtomAttributeId
+{
+};
+using SharedBBAtomAttribute = expr::Attribute<SharedBBAtomAttributeId, Node>;
+
+/** The encodings of the cached results for terms and atoms, see encoding(). */
+struct SharedBBTermEncodingAttributeId
+{
+};
+using SharedBBTermEncodingAttribute =
+    expr::Attribute<SharedBBTermEncodingAttributeId, uint64_t>;
+struct SharedBBAtomEncodingAttributeId
+{
+};
+using SharedBBAtomEncodingAttribute =
+    expr::Attribute<SharedBBAtomEncodingAttributeId, uint64_t>;
+
+/**
+ * Returns an identifier of the options that determine the circuits built by
+ * the bit-blaster. Results that were cached with other values of these
+ * options are not reused.
+ */
+uint64_t encoding()
+{
+  uint64_t res = static_cast<uint64_t>(options::bvMultiplier());
+  res = 2 * res + (options::bvMultConst() ? 1 : 0);
+  res = 2 * res + (options::bvMultShare() ? 1 : 0);
+  return res;
+}
+
+}  // namespace
+
+bool SharedBBCache::isEnabled() { return options::bvSharedBBCache(); }
+
+bool SharedBBCache::getTerm(TNode term, std::vector<Node>& bits)
+{
+  Assert(bits.empty());
+  Node bb;
+  if (!term.getAttribute(SharedBBTermAttribute(), bb)
+      || term.getAttribute(SharedBBTermEncodingAttribute()) != encoding())
+  {
+    return false;
+  }
+  Assert(bb.getKind() == kind::BITVECTOR_BB_TERM);
+  bits.insert(bits.end(), bb.begin(), bb.end());
+  return true;
+}
+
+void SharedBBCache::storeTerm(TNode term, const std::vector<Node>& bits)
+{
+  Node bb = NodeManager::currentNM()->mkNode(kind::BITVECTOR_BB_TERM, bits);
+  term.setAttribute(SharedBBTermAttribute(), bb);
+  term.setAttribute(SharedBBTermEncodingAttribute(), encoding());
+}
+
+Node SharedBBCache::getAtom(TNode atom)
+{
+  Node bb;
+  if (!atom.getAttribute(SharedBBAtomAttribute(), bb)
+      || atom.getAttribute(SharedBBAtomEncodingAttribute()) != encoding())
+  {
+    return Node::null();
+  }
+  return bb;
+}
+
+void SharedBBCache::storeAtom(TNode atom, TNode atom_bb)
+{
+  atom.setAttribute(SharedBBAtomAttribute(), atom_bb);
+  atom.setAttribute(SharedBBAtomEncodingAttribute(), encoding());
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Bit-blasting cache shared between bit-blaster instances.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__BV__BITBLAST__SHARED_BB_CACHE_H
+#define CVC5__THEORY__BV__BITBLAST__SHARED_BB_CACHE_H
+
+#include <vector>
+
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+/**
+ * The shared bit-blasting cache stores the bits of bit-blasted terms and the
+ * bit-blasted (and rewritten) definitions of atoms as node attributes. Since
+ * the results of bit-blasting only depend on the structure of a term and on
+ * the options that select the encodings (e.g., --bv-multiplier), they can be
+ * reused by every bit-blaster that uses the same node manager and the same
+ * encodings, i.e., after reset-assertions and in subsolvers. Results of other
+ * encodings are ignored and overwritten. The cached results live as long as
+ * the terms they belong to.
+ *
+ * Bit-blasters only use the cache if --bv-bb-shared-cache is enabled, and
+ * must not store results that are specific to their instance, e.g., the bits
+ * of abstracted terms. When reusing a cached result, a bit-blaster still has
+ * to visit the subterms to register its variables.
+ */
+class SharedBBCache
+{
+ public:
+  /** Returns true if the shared bit-blasting cache is enabled. */
+  static bool isEnabled();
+
+  /** Get the cached bits of term, returns false if there are none. */
+  static bool getTerm(TNode term, std::vector<Node>& bits);
+  /** Cache the bits of term. */
+  static void storeTerm(TNode term, const std::vector<Node>& bits);
+
+  /**
+   * Get the cached bit-blasted definition of the rewritten atom, or the null
+   * node if there is none.
+   */
+  static Node getAtom(TNode atom);
+  /** Cache the bit-blasted definition atom_bb of the rewritten atom. */
+  static void storeAtom(TNode atom, TNode atom_bb);
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
@@ -15,6 +15,10 @@
  */
 #include "theory/bv/bitblast/simple_bitblaster.h"
 
+#include <algorithm>
+
+#include "theory/bv/bitblast/shared_bb_cache.h"
+#include "theory/theory.h"
 #include "theory/theory_model.h"
 #include "theory/theory_state.h"
 
@@ -22,7 +26,10 @@ namespace cvc5 {
 namespace theory {
 namespace bv {
 
-BBSimple::BBSimple(TheoryState* s) : TBitblaster<Node>(), d_state(s) {}
+BBSimple::BBSimple(TheoryState* s)
+    : TBitblaster<Node>(), d_state(s), d_abstract(false), d_abstractMinWidth(0)
+{
+}
 
 void BBSimple::bbAtom(TNode node)
 {
@@ -34,13 +41,32 @@ void BBSimple::bbAtom(TNode node)
   }
 
   Node normalized = Rewriter::rewrite(node);
-  Node atom_bb =
-      normalized.getKind() != kind::CONST_BOOLEAN
-              && normalized.getKind() != kind::BITVECTOR_BITOF
-          ? d_atomBBStrategies[normalized.getKind()](normalized, this)
-          : normalized;
+  if (normalized.getKind() == kind::CONST_BOOLEAN
+      || normalized.getKind() == kind::BITVECTOR_BITOF)
+  {
+    storeBBAtom(node, normalized);
+    return;
+  }
 
-  storeBBAtom(node, Rewriter::rewrite(atom_bb));
+  Node atom_bb;
+  if (useSharedCache())
+  {
+    atom_bb = SharedBBCache::getAtom(normalized);
+  }
+  if (atom_bb.isNull())
+  {
+    atom_bb = Rewriter::rewrite(
+        d_atomBBStrategies[normalized.getKind()](normalized, this));
+    if (useSharedCache())
+    {
+      SharedBBCache::storeAtom(normalized, atom_bb);
+    }
+  }
+  else
+  {
+    bbChildren(normalized);
+  }
+  storeBBAtom(node, atom_bb);
 }
 
 void BBSimple::storeBBAtom(TNode atom, Node atom_bb)
@@ -82,11 +108,102 @@ void BBSimple::bbTerm(TNode node, Bits& bits)
     getBBTerm(node, bits);
     return;
   }
-  d_termBBStrategies[node.getKind()](node, bits, this);
+  if (isAbstracted(node))
+  {
+    for (const Node& child : node)
+    {
+      Bits cbits;
+      bbTerm(child, cbits);
+    }
+    for (unsigned i = 0, size = utils::getSize(node); i < size; ++i)
+    {
+      bits.push_back(utils::mkBitOf(node, i));
+    }
+    d_abstractions.push_back(node);
+  }
+  else if (useSharedCache() && !Theory::isLeafOf(node, THEORY_BV)
+           && SharedBBCache::getTerm(node, bits))
+  {
+    bbChildren(node);
+  }
+  else
+  {
+    d_termBBStrategies[node.getKind()](node, bits, this);
+    if (useSharedCache() && !Theory::isLeafOf(node, THEORY_BV))
+    {
+      SharedBBCache::storeTerm(node, bits);
+    }
+  }
   Assert(bits.size() == utils::getSize(node));
   storeBBTerm(node, bits);
 }
 
+void BBSimple::enableAbstraction(uint32_t minWidth)
+{
+  d_abstract = true;
+  d_abstractMinWidth = minWidth;
+}
+
+bool BBSimple::isAbstracted(TNode node) const
+{
+  if (!d_abstract || utils::getSize(node) < d_abstractMinWidth)
+  {
+    return false;
+  }
+  switch (node.getKind())
+  {
+    case kind::BITVECTOR_MULT:
+    {
+      // Multiplication by a constant is cheap enough to bit-blast.
+      uint32_t nconst = 0;
+      for (const Node& child : node)
+      {
+        nconst += child.isConst() ? 1 : 0;
+      }
+      return node.getNumChildren() - nconst > 1;
+    }
+    case kind::BITVECTOR_UDIV:
+    case kind::BITVECTOR_UREM: return !node[1].isConst();
+    default: return false;
+  }
+}
+
+bool BBSimple::useSharedCache() const
+{
+  return !d_abstract && SharedBBCache::isEnabled();
+}
+
+void BBSimple::bbChildren(TNode node)
+{
+  for (const Node& child : node)
+  {
+    if (child.getType().isBitVector())
+    {
+      Bits bits;
+      bbTerm(child, bits);
+    }
+  }
+}
+
+Node BBSimple::refineAbstraction(TNode node)
+{
+  auto it = std::find(d_abstractions.begin(), d_abstractions.end(), node);
+  Assert(it != d_abstractions.end());
+  d_abstractions.erase(it);
+
+  Bits bits, circuit;
+  getBBTerm(node, bits);
+  d_termBBStrategies[node.getKind()](node, circuit, this);
+  Assert(bits.size() == circuit.size());
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> equalities;
+  for (size_t i = 0, size = bits.size(); i < size; ++i)
+  {
+    equalities.push_back(nm->mkNode(kind::EQUAL, bits[i], circuit[i]));
+  }
+  return nm->mkAnd(equalities);
+}
+
 Node BBSimple::getStoredBBAtom(TNode node)
 {
   bool negated = false;
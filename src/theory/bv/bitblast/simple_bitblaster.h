@@ -61,7 +61,36 @@ class BBSimple : public TBitblaster<Node>
   /** Checks whether node is a variable introduced via `makeVariable`.*/
   bool isVariable(TNode node);
 
+  /**
+   * Enable word-level abstraction of expensive operators: terms of kind
+   * BITVECTOR_MULT, BITVECTOR_UDIV and BITVECTOR_UREM of at least the given
+   * width are bit-blasted to fresh bits instead of their circuits. Their
+   * children are bit-blasted as usual.
+   */
+  void enableAbstraction(uint32_t minWidth);
+  /** Get the terms that were abstracted and not refined yet. */
+  const std::vector<Node>& getAbstractions() const { return d_abstractions; }
+  /**
+   * Bit-blast the circuit of the abstracted term 'node' and return the
+   * formula that equates the abstraction bits with the circuit. The term is
+   * no longer returned by getAbstractions().
+   */
+  Node refineAbstraction(TNode node);
+
  private:
+  /** Returns true if 'node' is abstracted when bit-blasted. */
+  bool isAbstracted(TNode node) const;
+  /**
+   * Returns true if bit-blasting results are shared via SharedBBCache, which
+   * is not the case if abstraction is enabled.
+   */
+  bool useSharedCache() const;
+  /**
+   * Bit-blast the bit-vector children of 'node', whose own result was taken
+   * from the SharedBBCache, to register the variables below 'node'.
+   */
+  void bbChildren(TNode node);
+
   /** Query SAT solver for assignment of node 'a'. */
   Node getModelFromSatSolver(TNode a, bool fullModel) override;
 
@@ -71,6 +100,12 @@ class BBSimple : public TBitblaster<Node>
   std::unordered_map<Node, Node, NodeHashFunction> d_bbAtoms;
   /** Theory state. */
   TheoryState* d_state;
+  /** Whether abstraction is enabled, see enableAbstraction(). */
+  bool d_abstract;
+  /** The minimal width of abstracted terms. */
+  uint32_t d_abstractMinWidth;
+  /** The abstracted terms that were not refined yet. */
+  std::vector<Node> d_abstractions;
 };
 
 }  // namespace bv
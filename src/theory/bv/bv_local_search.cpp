@@ -0,0 +1,711 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Propagation-based local search for bit-vector literals.
+ */
+
+#include "theory/bv/bv_local_search.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "smt/smt_statistics_registry.h"
+#include "theory/bv/theory_bv_utils.h"
+#include "theory/theory.h"
+#include "util/random.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+namespace {
+
+/** Probability of assigning a random value instead of an inverse value. */
+constexpr double s_randomProb = 0.1;
+
+/** The 1-bit value of a Boolean. */
+BitVector mkBool(bool b) { return BitVector(1, b ? 1u : 0u); }
+
+/** The size of term n, 1 for Booleans. */
+unsigned getTermSize(TNode n)
+{
+  return n.getType().isBitVector() ? utils::getSize(n) : 1;
+}
+
+/** Flip the sign bit of v, which maps signed order to unsigned order. */
+BitVector flipSign(const BitVector& v)
+{
+  return v ^ BitVector::mkMinSigned(v.getSize());
+}
+
+}  // namespace
+
+BVLocalSearch::BVLocalSearch() {}
+
+bool BVLocalSearch::isLeaf(TNode n)
+{
+  return n.isConst() || Theory::isLeafOf(n, THEORY_BV);
+}
+
+bool BVLocalSearch::isSupported(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::EQUAL: return n[0].getType().isBitVector();
+    case kind::BITVECTOR_ULT:
+    case kind::BITVECTOR_ULE:
+    case kind::BITVECTOR_UGT:
+    case kind::BITVECTOR_UGE:
+    case kind::BITVECTOR_SLT:
+    case kind::BITVECTOR_SLE:
+    case kind::BITVECTOR_SGT:
+    case kind::BITVECTOR_SGE:
+    case kind::BITVECTOR_COMP:
+    case kind::BITVECTOR_NOT:
+    case kind::BITVECTOR_NEG:
+    case kind::BITVECTOR_AND:
+    case kind::BITVECTOR_OR:
+    case kind::BITVECTOR_XOR:
+    case kind::BITVECTOR_PLUS:
+    case kind::BITVECTOR_SUB:
+    case kind::BITVECTOR_MULT:
+    case kind::BITVECTOR_UDIV:
+    case kind::BITVECTOR_UREM:
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    case kind::BITVECTOR_ASHR:
+    case kind::BITVECTOR_CONCAT:
+    case kind::BITVECTOR_EXTRACT:
+    case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::BITVECTOR_SIGN_EXTEND: return true;
+    default: return false;
+  }
+}
+
+bool BVLocalSearch::collect(const std::vector<Node>& literals)
+{
+  d_roots.clear();
+  d_terms.clear();
+  d_index.clear();
+  d_parents.clear();
+  d_values.clear();
+
+  std::vector<std::pair<TNode, bool>> visit;
+  for (const Node& lit : literals)
+  {
+    bool pol = lit.getKind() != kind::NOT;
+    Node atom = pol ? lit : lit[0];
+    if (atom.getType().isBoolean() && (isLeaf(atom) || !isSupported(atom)))
+    {
+      return false;
+    }
+    d_roots.emplace_back(atom, pol);
+    visit.emplace_back(atom, false);
+  }
+  /* Post-order traversal, yields the terms in topological order. */
+  while (!visit.empty())
+  {
+    TNode cur = visit.back().first;
+    bool processed = visit.back().second;
+    visit.pop_back();
+    if (d_index.find(cur) != d_index.end())
+    {
+      continue;
+    }
+    if (processed || isLeaf(cur))
+    {
+      d_index.emplace(cur, d_terms.size());
+      d_terms.push_back(cur);
+      continue;
+    }
+    if (!isSupported(cur))
+    {
+      Trace("bv-ls") << "unsupported term " << cur << std::endl;
+      return false;
+    }
+    visit.emplace_back(cur, true);
+    for (const Node& child : cur)
+    {
+      std::vector<Node>& parents = d_parents[child];
+      if (std::find(parents.begin(), parents.end(), cur) == parents.end())
+      {
+        parents.push_back(cur);
+      }
+      visit.emplace_back(child, false);
+    }
+  }
+  return true;
+}
+
+BitVector BVLocalSearch::evaluate(TNode n) const
+{
+  if (n.isConst())
+  {
+    return n.getConst<BitVector>();
+  }
+  Kind k = n.getKind();
+  switch (k)
+  {
+    case kind::EQUAL: return mkBool(getValue(n[0]) == getValue(n[1]));
+    case kind::BITVECTOR_ULT: return mkBool(getValue(n[0]) < getValue(n[1]));
+    case kind::BITVECTOR_ULE: return mkBool(getValue(n[0]) <= getValue(n[1]));
+    case kind::BITVECTOR_UGT: return mkBool(getValue(n[0]) > getValue(n[1]));
+    case kind::BITVECTOR_UGE: return mkBool(getValue(n[0]) >= getValue(n[1]));
+    case kind::BITVECTOR_SLT:
+      return mkBool(getValue(n[0]).signedLessThan(getValue(n[1])));
+    case kind::BITVECTOR_SLE:
+      return mkBool(getValue(n[0]).signedLessThanEq(getValue(n[1])));
+    case kind::BITVECTOR_SGT:
+      return mkBool(getValue(n[1]).signedLessThan(getValue(n[0])));
+    case kind::BITVECTOR_SGE:
+      return mkBool(getValue(n[1]).signedLessThanEq(getValue(n[0])));
+    case kind::BITVECTOR_COMP:
+      return mkBool(getValue(n[0]) == getValue(n[1]));
+    case kind::BITVECTOR_NOT: return ~getValue(n[0]);
+    case kind::BITVECTOR_NEG: return -getValue(n[0]);
+    case kind::BITVECTOR_EXTRACT:
+      return getValue(n[0]).extract(utils::getExtractHigh(n),
+                                    utils::getExtractLow(n));
+    case kind::BITVECTOR_ZERO_EXTEND:
+      return getValue(n[0]).zeroExtend(utils::getSize(n)
+                                       - utils::getSize(n[0]));
+    case kind::BITVECTOR_SIGN_EXTEND:
+      return getValue(n[0]).signExtend(utils::getSize(n)
+                                       - utils::getSize(n[0]));
+    default: break;
+  }
+  /* Binary and n-ary operators, folded from left to right. */
+  BitVector res = getValue(n[0]);
+  for (size_t i = 1, size = n.getNumChildren(); i < size; ++i)
+  {
+    const BitVector& v = getValue(n[i]);
+    switch (k)
+    {
+      case kind::BITVECTOR_AND: res = res & v; break;
+      case kind::BITVECTOR_OR: res = res | v; break;
+      case kind::BITVECTOR_XOR: res = res ^ v; break;
+      case kind::BITVECTOR_PLUS: res = res + v; break;
+      case kind::BITVECTOR_SUB: res = res - v; break;
+      case kind::BITVECTOR_MULT: res = res * v; break;
+      case kind::BITVECTOR_UDIV: res = res.unsignedDivTotal(v); break;
+      case kind::BITVECTOR_UREM: res = res.unsignedRemTotal(v); break;
+      case kind::BITVECTOR_SHL: res = res.leftShift(v); break;
+      case kind::BITVECTOR_LSHR: res = res.logicalRightShift(v); break;
+      case kind::BITVECTOR_ASHR: res = res.arithRightShift(v); break;
+      case kind::BITVECTOR_CONCAT: res = res.concat(v); break;
+      default: Unreachable() << "Unsupported kind " << k;
+    }
+  }
+  return res;
+}
+
+void BVLocalSearch::update(TNode leaf, const BitVector& value)
+{
+  d_values[leaf] = value;
+  d_assignment[leaf] = value;
+  /* Collect the cone of influence of leaf and re-evaluate it bottom-up. */
+  std::vector<size_t> cone;
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit{leaf};
+  while (!visit.empty())
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    auto it = d_parents.find(cur);
+    if (it == d_parents.end())
+    {
+      continue;
+    }
+    for (const Node& parent : it->second)
+    {
+      if (visited.insert(parent).second)
+      {
+        cone.push_back(d_index.at(parent));
+        visit.push_back(parent);
+      }
+    }
+  }
+  std::sort(cone.begin(), cone.end());
+  for (size_t i : cone)
+  {
+    d_values[d_terms[i]] = evaluate(d_terms[i]);
+  }
+}
+
+BitVector BVLocalSearch::randomValue(unsigned size)
+{
+  Random& rnd = Random::getRandom();
+  BitVector res(std::min(size, 64u), rnd.rand());
+  while (res.getSize() < size)
+  {
+    unsigned chunk = std::min(size - res.getSize(), 64u);
+    res = BitVector(chunk, rnd.rand()).concat(res);
+  }
+  return res;
+}
+
+BitVector BVLocalSearch::randomBetween(const BitVector& lo,
+                                       const BitVector& hi)
+{
+  Assert(lo <= hi);
+  unsigned size = lo.getSize();
+  BitVector range = hi - lo + BitVector::mkOne(size);
+  BitVector r = randomValue(size);
+  /* range is zero if [lo, hi] covers all values */
+  return range == BitVector::mkZero(size) ? r : lo + r.unsignedRemTotal(range);
+}
+
+bool BVLocalSearch::inversePredicate(
+    Kind k, bool left, bool target, const BitVector& s, BitVector& x)
+{
+  unsigned size = s.getSize();
+  if (k == kind::EQUAL || k == kind::BITVECTOR_COMP)
+  {
+    x = target ? s : randomValue(size);
+    if (!target && x == s)
+    {
+      x = x + BitVector::mkOne(size);
+    }
+    return true;
+  }
+  bool isSigned = k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SLE
+                  || k == kind::BITVECTOR_SGT || k == kind::BITVECTOR_SGE;
+  /* Normalize to x < s, x <= s, x > s or x >= s. */
+  bool less = k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_ULE
+              || k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SLE;
+  bool strict = k == kind::BITVECTOR_ULT || k == kind::BITVECTOR_UGT
+                || k == kind::BITVECTOR_SLT || k == kind::BITVECTOR_SGT;
+  if (!left)
+  {
+    less = !less;
+  }
+  if (!target)
+  {
+    /* not (x < s) iff x >= s, not (x <= s) iff x > s */
+    less = !less;
+    strict = !strict;
+  }
+  /* Compute the bounds in unsigned order, flipping the sign bit if signed. */
+  BitVector fs = isSigned ? flipSign(s) : s;
+  BitVector min = BitVector::mkZero(size);
+  BitVector max = BitVector::mkOnes(size);
+  BitVector one = BitVector::mkOne(size);
+  BitVector lo, hi;
+  if (less)
+  {
+    if (strict && fs == min)
+    {
+      return false;
+    }
+    lo = min;
+    hi = strict ? fs - one : fs;
+  }
+  else
+  {
+    if (strict && fs == max)
+    {
+      return false;
+    }
+    lo = strict ? fs + one : fs;
+    hi = max;
+  }
+  x = randomBetween(lo, hi);
+  if (isSigned)
+  {
+    x = flipSign(x);
+  }
+  return true;
+}
+
+bool BVLocalSearch::inverseMult(const BitVector& s,
+                                const BitVector& t,
+                                BitVector& x)
+{
+  unsigned size = s.getSize();
+  BitVector zero = BitVector::mkZero(size);
+  BitVector one = BitVector::mkOne(size);
+  if (s == zero)
+  {
+    x = randomValue(size);
+    return t == zero;
+  }
+  /* s = s' * 2^k with s' odd, requires t = t' * 2^k */
+  unsigned k = 0;
+  while (!s.isBitSet(k))
+  {
+    ++k;
+  }
+  for (unsigned i = 0; i < k; ++i)
+  {
+    if (t.isBitSet(i))
+    {
+      return false;
+    }
+  }
+  BitVector shift(size, k);
+  BitVector odd = s.logicalRightShift(shift);
+  /* Newton iteration for the inverse of odd modulo 2^size, every iteration
+   * doubles the number of correct bits. */
+  BitVector inv = odd;
+  BitVector two = one + one;
+  while (odd * inv != one)
+  {
+    inv = inv * (two - odd * inv);
+  }
+  x = t.logicalRightShift(shift) * inv;
+  if (k > 0)
+  {
+    /* The upper k bits of x are irrelevant. */
+    x = randomValue(k).concat(x.extract(size - k - 1, 0));
+  }
+  Assert(x * s == t);
+  return true;
+}
+
+bool BVLocalSearch::inverseValue(TNode n,
+                                 size_t i,
+                                 const BitVector& t,
+                                 BitVector& x)
+{
+  Kind k = n.getKind();
+  unsigned size = getTermSize(n[i]);
+  switch (k)
+  {
+    case kind::EQUAL:
+    case kind::BITVECTOR_ULT:
+    case kind::BITVECTOR_ULE:
+    case kind::BITVECTOR_UGT:
+    case kind::BITVECTOR_UGE:
+    case kind::BITVECTOR_SLT:
+    case kind::BITVECTOR_SLE:
+    case kind::BITVECTOR_SGT:
+    case kind::BITVECTOR_SGE:
+    case kind::BITVECTOR_COMP:
+      return inversePredicate(
+          k, i == 0, t.isBitSet(0), getValue(n[1 - i]), x);
+    case kind::BITVECTOR_NOT: x = ~t; return true;
+    case kind::BITVECTOR_NEG: x = -t; return true;
+    case kind::BITVECTOR_EXTRACT:
+    {
+      /* Replace the extracted bits of the current value. */
+      const BitVector& cur = getValue(n[0]);
+      unsigned high = utils::getExtractHigh(n);
+      unsigned low = utils::getExtractLow(n);
+      x = t;
+      if (low > 0)
+      {
+        x = x.concat(cur.extract(low - 1, 0));
+      }
+      if (high + 1 < size)
+      {
+        x = cur.extract(size - 1, high + 1).concat(x);
+      }
+      return true;
+    }
+    case kind::BITVECTOR_ZERO_EXTEND:
+      x = t.extract(size - 1, 0);
+      return x.zeroExtend(t.getSize() - size) == t;
+    case kind::BITVECTOR_SIGN_EXTEND:
+      x = t.extract(size - 1, 0);
+      return x.signExtend(t.getSize() - size) == t;
+    case kind::BITVECTOR_CONCAT:
+    {
+      /* The children are ordered from the most significant bits. */
+      unsigned low = 0;
+      for (size_t j = i + 1, nchildren = n.getNumChildren(); j < nchildren;
+           ++j)
+      {
+        low += utils::getSize(n[j]);
+      }
+      x = t.extract(low + size - 1, low);
+      return true;
+    }
+    default: break;
+  }
+
+  /* Fold the values of the other children of associative operators. */
+  auto foldOthers = [this, &n, i](Kind op) {
+    BitVector s;
+    bool first = true;
+    for (size_t j = 0, nchildren = n.getNumChildren(); j < nchildren; ++j)
+    {
+      if (j == i) continue;
+      const BitVector& v = getValue(n[j]);
+      if (first)
+      {
+        s = v;
+        first = false;
+        continue;
+      }
+      switch (op)
+      {
+        case kind::BITVECTOR_AND: s = s & v; break;
+        case kind::BITVECTOR_OR: s = s | v; break;
+        case kind::BITVECTOR_XOR: s = s ^ v; break;
+        case kind::BITVECTOR_PLUS: s = s + v; break;
+        default:
+          Assert(op == kind::BITVECTOR_MULT);
+          s = s * v;
+      }
+    }
+    return s;
+  };
+
+  switch (k)
+  {
+    case kind::BITVECTOR_AND:
+    {
+      BitVector s = foldOthers(k);
+      /* Bits that are 0 in s must be 0 in t, the others are free. */
+      if ((t & ~s) != BitVector::mkZero(size))
+      {
+        return false;
+      }
+      x = t | (randomValue(size) & ~s);
+      return true;
+    }
+    case kind::BITVECTOR_OR:
+    {
+      BitVector s = foldOthers(k);
+      /* Bits that are 1 in s must be 1 in t, the others are free. */
+      if ((s & ~t) != BitVector::mkZero(size))
+      {
+        return false;
+      }
+      x = (t & ~s) | (randomValue(size) & s);
+      return true;
+    }
+    case kind::BITVECTOR_XOR: x = t ^ foldOthers(k); return true;
+    case kind::BITVECTOR_PLUS: x = t - foldOthers(k); return true;
+    case kind::BITVECTOR_MULT: return inverseMult(foldOthers(k), t, x);
+    default: break;
+  }
+
+  /* Binary operators, s is the value of the other child. */
+  Assert(n.getNumChildren() == 2);
+  const BitVector& s = getValue(n[1 - i]);
+  BitVector zero = BitVector::mkZero(size);
+  BitVector ones = BitVector::mkOnes(size);
+  switch (k)
+  {
+    case kind::BITVECTOR_SUB:
+      x = i == 0 ? t + s : s - t;
+      return true;
+    case kind::BITVECTOR_UDIV:
+      if (i == 0)
+      {
+        /* x / s = t */
+        if (s == zero)
+        {
+          x = randomValue(size);
+          return t == ones;
+        }
+        x = t * s;
+        BitVector rem = randomValue(size).unsignedRemTotal(s);
+        if ((x + rem).unsignedDivTotal(s) == t)
+        {
+          x = x + rem;
+        }
+        return x.unsignedDivTotal(s) == t;
+      }
+      /* s / x = t */
+      if (t == ones)
+      {
+        x = zero;
+        return true;
+      }
+      if (t == zero)
+      {
+        if (s == ones)
+        {
+          return false;
+        }
+        x = randomBetween(s + BitVector::mkOne(size), ones);
+        return true;
+      }
+      x = s.unsignedDivTotal(t);
+      return s.unsignedDivTotal(x) == t;
+    case kind::BITVECTOR_UREM:
+      if (i == 0)
+      {
+        /* x % s = t */
+        x = t;
+        return x.unsignedRemTotal(s) == t;
+      }
+      /* s % x = t */
+      if (s == t)
+      {
+        x = zero;
+        return true;
+      }
+      if (t < s)
+      {
+        x = s - t;
+        return s.unsignedRemTotal(x) == t;
+      }
+      return false;
+    case kind::BITVECTOR_SHL:
+    case kind::BITVECTOR_LSHR:
+    case kind::BITVECTOR_ASHR:
+    {
+      auto shift = [k](const BitVector& a, const BitVector& b) {
+        return k == kind::BITVECTOR_SHL
+                   ? a.leftShift(b)
+                   : (k == kind::BITVECTOR_LSHR ? a.logicalRightShift(b)
+                                                : a.arithRightShift(b));
+      };
+      if (i == 0)
+      {
+        /* x << s = t, x >> s = t */
+        x = k == kind::BITVECTOR_SHL ? t.logicalRightShift(s) : t.leftShift(s);
+        return shift(x, s) == t;
+      }
+      /* s << x = t, s >> x = t: try all relevant shift amounts */
+      for (unsigned a = 0; a <= size; ++a)
+      {
+        x = BitVector(size, a);
+        if (shift(s, x) == t)
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+    default: Unreachable() << "Unsupported kind " << k;
+  }
+  return false;
+}
+
+bool BVLocalSearch::selectMove(TNode root,
+                               const BitVector& target,
+                               Node& leaf,
+                               BitVector& value)
+{
+  Random& rnd = Random::getRandom();
+  TNode cur = root;
+  BitVector t = target;
+  while (!isLeaf(cur))
+  {
+    std::vector<size_t> candidates;
+    std::vector<std::pair<size_t, BitVector>> inverses;
+    for (size_t i = 0, size = cur.getNumChildren(); i < size; ++i)
+    {
+      if (cur[i].isConst())
+      {
+        continue;
+      }
+      candidates.push_back(i);
+      BitVector x;
+      if (inverseValue(cur, i, t, x) && x != getValue(cur[i]))
+      {
+        inverses.emplace_back(i, x);
+      }
+    }
+    if (candidates.empty())
+    {
+      return false;
+    }
+    if (!inverses.empty() && !rnd.pickWithProb(s_randomProb))
+    {
+      const auto& inv = inverses[rnd.pick(0, inverses.size() - 1)];
+      cur = cur[inv.first];
+      t = inv.second;
+    }
+    else
+    {
+      cur = cur[candidates[rnd.pick(0, candidates.size() - 1)]];
+      t = randomValue(getTermSize(cur));
+    }
+  }
+  if (cur.isConst())
+  {
+    return false;
+  }
+  leaf = cur;
+  value = t;
+  return true;
+}
+
+bool BVLocalSearch::solve(const std::vector<Node>& literals, uint64_t maxMoves)
+{
+  ++d_statistics.d_numCalls;
+  if (!collect(literals))
+  {
+    ++d_statistics.d_numUnsupported;
+    return false;
+  }
+  for (const Node& n : d_terms)
+  {
+    if (n.isConst() || !isLeaf(n))
+    {
+      d_values.emplace(n, evaluate(n));
+      continue;
+    }
+    auto it = d_assignment.find(n);
+    if (it == d_assignment.end())
+    {
+      it = d_assignment.emplace(n, BitVector::mkZero(utils::getSize(n))).first;
+    }
+    d_values.emplace(n, it->second);
+  }
+
+  Random& rnd = Random::getRandom();
+  std::vector<size_t> unsat;
+  for (uint64_t moves = 0;; ++moves)
+  {
+    unsat.clear();
+    for (size_t i = 0, size = d_roots.size(); i < size; ++i)
+    {
+      if (getValue(d_roots[i].first).isBitSet(0) != d_roots[i].second)
+      {
+        unsat.push_back(i);
+      }
+    }
+    if (unsat.empty())
+    {
+      Trace("bv-ls") << "solved after " << moves << " moves" << std::endl;
+      ++d_statistics.d_numSolved;
+      return true;
+    }
+    if (moves >= maxMoves)
+    {
+      break;
+    }
+    ++d_statistics.d_numMoves;
+    const auto& root = d_roots[unsat[rnd.pick(0, unsat.size() - 1)]];
+    Node leaf;
+    BitVector value;
+    if (selectMove(root.first, mkBool(root.second), leaf, value))
+    {
+      Trace("bv-ls") << "move " << leaf << " := " << value << std::endl;
+      update(leaf, value);
+    }
+  }
+  Trace("bv-ls") << "gave up with " << unsat.size() << " unsatisfied literals"
+                 << std::endl;
+  return false;
+}
+
+BVLocalSearch::Statistics::Statistics()
+    : d_numCalls(smtStatisticsRegistry().registerInt(
+        "theory::bv::BVLocalSearch::numCalls")),
+      d_numSolved(smtStatisticsRegistry().registerInt(
+          "theory::bv::BVLocalSearch::numSolved")),
+      d_numMoves(smtStatisticsRegistry().registerInt(
+          "theory::bv::BVLocalSearch::numMoves")),
+      d_numUnsupported(smtStatisticsRegistry().registerInt(
+          "theory::bv::BVLocalSearch::numUnsupported"))
+{
+}
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
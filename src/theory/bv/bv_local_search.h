@@ -0,0 +1,141 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Propagation-based local search for bit-vector literals.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__BV__BV_LOCAL_SEARCH_H
+#define CVC5__THEORY__BV__BV_LOCAL_SEARCH_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/bitvector.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace theory {
+namespace bv {
+
+/**
+ * Word-level propagation-based local search in the style of Niemetz, Preiner
+ * and Biere, "Propagation based local search for bit-precise reasoning".
+ *
+ * Given a set of bit-vector literals, the search maintains a complete
+ * assignment of the leaves (variables and other theories' terms) and the
+ * values of all terms under it. A move picks an unsatisfied literal and
+ * propagates its target value down a path to some leaf: at every operator, a
+ * child is selected and assigned an inverse value, i.e., a value that
+ * produces the target value of the operator given the current values of the
+ * other children. If no child has an inverse value, a random value is used.
+ * The leaf at the end of the path is assigned its target value.
+ *
+ * The assignment of the leaves is kept between calls to solve(), so that the
+ * search continues from the last assignment in subsequent checks.
+ */
+class BVLocalSearch
+{
+ public:
+  BVLocalSearch();
+
+  /**
+   * Search for an assignment of the leaves of the given literals that
+   * satisfies all of them, with at most maxMoves moves. Returns true if such
+   * an assignment was found, see getAssignment(). Returns false immediately
+   * if the literals contain operators that are not supported.
+   */
+  bool solve(const std::vector<Node>& literals, uint64_t maxMoves);
+
+  /** Get the assignment of the leaves of the last call to solve(). */
+  const std::unordered_map<Node, BitVector, NodeHashFunction>& getAssignment()
+      const
+  {
+    return d_assignment;
+  }
+
+ private:
+  /**
+   * Collect the terms of the given literals in topological order, and their
+   * parents. Returns false if some term is not supported.
+   */
+  bool collect(const std::vector<Node>& literals);
+  /** Returns true if the operator of n is supported. */
+  static bool isSupported(TNode n);
+  /** Returns true if n is a leaf, i.e., a constant or a foreign term. */
+  static bool isLeaf(TNode n);
+  /** Evaluate n under the current values of its children. */
+  BitVector evaluate(TNode n) const;
+  /** Assign value to leaf and update the values of its parents. */
+  void update(TNode leaf, const BitVector& value);
+  /**
+   * Propagate the target value of root down to a leaf. Returns false if no
+   * leaf could be reached.
+   */
+  bool selectMove(TNode root,
+                  const BitVector& target,
+                  Node& leaf,
+                  BitVector& value);
+  /**
+   * Compute an inverse value x for the i-th child of n, such that n evaluates
+   * to t when the i-th child is x and all other children keep their current
+   * values. Returns false if there is no such value.
+   */
+  bool inverseValue(TNode n, size_t i, const BitVector& t, BitVector& x);
+  /** Inverse value for the predicates EQUAL and BITVECTOR_U/S{LT,LE,GT,GE}. */
+  bool inversePredicate(Kind k,
+                        bool left,
+                        bool target,
+                        const BitVector& s,
+                        BitVector& x);
+  /** Inverse value x with x * s = t. */
+  bool inverseMult(const BitVector& s, const BitVector& t, BitVector& x);
+
+  /** Get a random value of the given size. */
+  static BitVector randomValue(unsigned size);
+  /** Get a random value between lo and hi (inclusive, unsigned). */
+  static BitVector randomBetween(const BitVector& lo, const BitVector& hi);
+  /** The value of the term n, a 1-bit value for predicates. */
+  const BitVector& getValue(TNode n) const { return d_values.at(n); }
+
+  /** The literals of the current call, as pairs of atom and target value. */
+  std::vector<std::pair<Node, bool>> d_roots;
+  /** The terms of the current call, in topological order. */
+  std::vector<Node> d_terms;
+  /** Maps the terms of the current call to their index in d_terms. */
+  std::unordered_map<Node, size_t, NodeHashFunction> d_index;
+  /** Maps the terms of the current call to their parents. */
+  std::unordered_map<Node, std::vector<Node>, NodeHashFunction> d_parents;
+  /** The current values of all terms of the current call. */
+  std::unordered_map<Node, BitVector, NodeHashFunction> d_values;
+  /** The assignment of the leaves, kept between calls. */
+  std::unordered_map<Node, BitVector, NodeHashFunction> d_assignment;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numCalls;
+    IntStat d_numSolved;
+    IntStat d_numMoves;
+    IntStat d_numUnsupported;
+    Statistics();
+  };
+
+  Statistics d_statistics;
+};
+
+}  // namespace bv
+}  // namespace theory
+}  // namespace cvc5
+
+#endif
@@ -41,7 +41,9 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
                 : nullptr),
       d_factLiteralCache(s->getSatContext()),
       d_literalFactCache(s->getSatContext()),
-      d_propagate(options::bitvectorPropagate())
+      d_propagate(options::bitvectorPropagate()),
+      d_abstract(options::bvSolver() == options::BVSolver::ABSTRACT),
+      d_localSearch(options::bvLocalSearch())
 {
   if (pnm != nullptr)
   {
@@ -63,6 +65,10 @@ BVSolverBitblast::BVSolverBitblast(TheoryState* s,
                                         d_nullContext.get(),
                                         nullptr,
                                         smt::currentResourceManager()));
+  if (d_abstract)
+  {
+    d_bitblaster->enableAbstraction(options::bvAbstractionMinWidth());
+  }
 }
 
 void BVSolverBitblast::postCheck(Theory::Effort level)
@@ -98,7 +104,22 @@ void BVSolverBitblast::postCheck(Theory::Effort level)
   d_invalidateModelCache.set(true);
   std::vector<prop::SatLiteral> assumptions(d_assumptions.begin(),
                                             d_assumptions.end());
-  prop::SatValue val = d_satSolver->solve(assumptions);
+  prop::SatValue val;
+  if (d_localSearch && level == Theory::Effort::EFFORT_FULL
+      && checkLocalSearch(assumptions))
+  {
+    val = prop::SatValue::SAT_VALUE_TRUE;
+  }
+  else
+  {
+    val = d_satSolver->solve(assumptions);
+  }
+  /* Refine abstracted operators until the model is consistent with them. */
+  while (d_abstract && level == Theory::Effort::EFFORT_FULL
+         && val == prop::SatValue::SAT_VALUE_TRUE && refineAbstractions())
+  {
+    val = d_satSolver->solve(assumptions);
+  }
   d_inSatMode = val == prop::SatValue::SAT_VALUE_TRUE;
   Debug("bv-bitblast") << "d_inSatMode: " << d_inSatMode << std::endl;
 
@@ -208,6 +229,123 @@ Node BVSolverBitblast::getValueFromSatSolver(TNode node, bool initialize)
   return utils::mkConst(bits.size(), value);
 }
 
+bool BVSolverBitblast::refineAbstractions()
+{
+  ++d_statistics.d_numAbstractionChecks;
+  NodeManager* nm = NodeManager::currentNM();
+  /* Copy, since refining a term removes it from the abstractions. */
+  std::vector<Node> abstractions = d_bitblaster->getAbstractions();
+  bool refined = false;
+  for (const Node& term : abstractions)
+  {
+    std::vector<Node> values;
+    for (const Node& child : term)
+    {
+      values.push_back(getValueFromSatSolver(child, true));
+    }
+    Node abstractValue = getValueFromSatSolver(term, true);
+    Node value = Rewriter::rewrite(nm->mkNode(term.getKind(), values));
+    Assert(value.isConst());
+    if (value == abstractValue)
+    {
+      continue;
+    }
+    Debug("bv-bitblast") << "abstraction violated: " << term << " is "
+                         << abstractValue << " instead of " << value
+                         << std::endl;
+    refined = true;
+    uint32_t& numLemmas = d_numValueLemmas[term];
+    Node refinement;
+    if (numLemmas < options::bvAbstractionValueLemmas())
+    {
+      ++numLemmas;
+      ++d_statistics.d_numValueLemmas;
+      std::vector<Node> premises;
+      for (size_t i = 0, size = term.getNumChildren(); i < size; ++i)
+      {
+        std::vector<Node> bits;
+        d_bitblaster->getBBTerm(term[i], bits);
+        premises.push_back(mkBitsEqual(bits, values[i]));
+      }
+      std::vector<Node> bits;
+      d_bitblaster->getBBTerm(term, bits);
+      refinement = nm->mkNode(
+          kind::IMPLIES, nm->mkAnd(premises), mkBitsEqual(bits, value));
+    }
+    else
+    {
+      ++d_statistics.d_numRefinedTerms;
+      refinement = d_bitblaster->refineAbstraction(term);
+    }
+    d_cnfStream->convertAndAssert(refinement, false, false);
+  }
+  return refined;
+}
+
+bool BVSolverBitblast::checkLocalSearch(
+    const std::vector<prop::SatLiteral>& assumptions)
+{
+  std::vector<Node> facts;
+  for (const prop::SatLiteral& lit : assumptions)
+  {
+    facts.push_back(d_literalFactCache[lit]);
+  }
+  if (!d_localSearchEngine.solve(facts, options::bvLocalSearchMoves()))
+  {
+    return false;
+  }
+  /* Fix the bits of the leaves to the assignment found by local search. */
+  std::vector<prop::SatLiteral> fixed(assumptions);
+  for (const auto& p : d_localSearchEngine.getAssignment())
+  {
+    if (!d_bitblaster->hasBBTerm(p.first))
+    {
+      continue;
+    }
+    std::vector<Node> bits;
+    d_bitblaster->getBBTerm(p.first, bits);
+    for (size_t i = 0, size = bits.size(); i < size; ++i)
+    {
+      if (d_cnfStream->hasLiteral(bits[i]))
+      {
+        prop::SatLiteral lit = d_cnfStream->getLiteral(bits[i]);
+        fixed.push_back(p.second.isBitSet(i) ? lit : ~lit);
+      }
+    }
+  }
+  if (d_satSolver->solve(fixed) != prop::SatValue::SAT_VALUE_TRUE)
+  {
+    Debug("bv-bitblast") << "local search model rejected" << std::endl;
+    return false;
+  }
+  ++d_statistics.d_numLocalSearchModels;
+  return true;
+}
+
+Node BVSolverBitblast::mkBitsEqual(const std::vector<Node>& bits, TNode value)
+{
+  const BitVector& bv = value.getConst<BitVector>();
+  Assert(bits.size() == bv.getSize());
+  std::vector<Node> lits;
+  for (size_t i = 0, size = bits.size(); i < size; ++i)
+  {
+    lits.push_back(bv.isBitSet(i) ? bits[i] : bits[i].notNode());
+  }
+  return NodeManager::currentNM()->mkAnd(lits);
+}
+
+BVSolverBitblast::Statistics::Statistics()
+    : d_numAbstractionChecks(smtStatisticsRegistry().registerInt(
+        "theory::bv::BVSolverBitblast::numAbstractionChecks")),
+      d_numValueLemmas(smtStatisticsRegistry().registerInt(
+          "theory::bv::BVSolverBitblast::numAbstractionValueLemmas")),
+      d_numRefinedTerms(smtStatisticsRegistry().registerInt(
+          "theory::bv::BVSolverBitblast::numAbstractionRefinedTerms")),
+      d_numLocalSearchModels(smtStatisticsRegistry().registerInt(
+          "theory::bv::BVSolverBitblast::numLocalSearchModels"))
+{
+}
+
 Node BVSolverBitblast::getValue(TNode node)
 {
   if (d_invalidateModelCache.get())
@@ -24,9 +24,11 @@
 #include "prop/cnf_stream.h"
 #include "prop/sat_solver.h"
 #include "theory/bv/bitblast/simple_bitblaster.h"
+#include "theory/bv/bv_local_search.h"
 #include "theory/bv/bv_solver.h"
 #include "theory/bv/proof_checker.h"
 #include "theory/eager_proof_generator.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
@@ -81,6 +83,37 @@ class BVSolverBitblast : public BVSolver
    */
   Node getValue(TNode node);
 
+  /**
+   * Check the abstracted terms of the bit-blaster (see
+   * BBSimple::enableAbstraction()) against the current model of the SAT
+   * solver and refine the violated ones. A violated term is refined with a
+   * value-based lemma
+   *   (children = model values) => (term = evaluation on model values)
+   * for the first --bv-abstraction-value-lemmas times, and by bit-blasting
+   * its circuit afterwards. Refinements are added permanently to the SAT
+   * solver, since they are valid.
+   *
+   * Returns true if any term was refined.
+   */
+  bool refineAbstractions();
+
+  /**
+   * Run local search (see BVLocalSearch) on the currently asserted facts. If
+   * it finds a satisfying assignment, the SAT solver is called with the bits
+   * of the leaves fixed to this assignment in addition to `assumptions`,
+   * which confirms the assignment without search.
+   *
+   * Returns true if the SAT solver confirmed the assignment, in which case
+   * the SAT solver holds a model of `assumptions`.
+   */
+  bool checkLocalSearch(const std::vector<prop::SatLiteral>& assumptions);
+
+  /**
+   * Get the formula over `bits` that holds iff `bits` represent the constant
+   * `value`.
+   */
+  Node mkBitsEqual(const std::vector<Node>& bits, TNode value);
+
   /**
    * Cache for getValue() calls.
    *
@@ -132,6 +165,30 @@ class BVSolverBitblast : public BVSolver
 
   /** Option to enable/disable bit-level propagation. */
   bool d_propagate;
+
+  /** Whether expensive operators are abstracted, see refineAbstractions(). */
+  bool d_abstract;
+
+  /** Whether local search is run before solving, see checkLocalSearch(). */
+  bool d_localSearch;
+
+  /** The local search engine used by checkLocalSearch(). */
+  BVLocalSearch d_localSearchEngine;
+
+  /** Number of value-based lemmas added for each abstracted term. */
+  std::unordered_map<Node, uint32_t, NodeHashFunction> d_numValueLemmas;
+
+  class Statistics
+  {
+   public:
+    IntStat d_numAbstractionChecks;
+    IntStat d_numValueLemmas;
+    IntStat d_numRefinedTerms;
+    IntStat d_numLocalSearchModels;
+    Statistics();
+  };
+
+  Statistics d_statistics;
 };
 
 }  // namespace bv
@@ -48,6 +48,7 @@ TheoryBV::TheoryBV(context::Context* c,
   switch (options::bvSolver())
   {
     case options::BVSolver::BITBLAST:
+    case options::BVSolver::ABSTRACT:
       d_internal.reset(new BVSolverBitblast(&d_state, d_im, pnm));
       break;
 
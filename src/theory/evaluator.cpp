@@ -502,12 +502,21 @@ EvalResult Evaluator::evalInternal(
 
         case kind::STRING_CONCAT:
         {
-          String res = results[currNode[0]].d_str;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+          // concatenate the code points at once, instead of building the
+          // intermediate strings
+          size_t len = 0;
+          for (const Node& cn : currNode)
           {
-            res = res.concat(results[currNode[i]].d_str);
+            len += results[cn].d_str.size();
           }
-          results[currNode] = EvalResult(res);
+          std::vector<unsigned> vec;
+          vec.reserve(len);
+          for (const Node& cn : currNode)
+          {
+            const std::vector<unsigned>& cvec = results[cn].d_str.getVec();
+            vec.insert(vec.end(), cvec.begin(), cvec.end());
+          }
+          results[currNode] = EvalResult(String(std::move(vec)));
           break;
         }
 
@@ -622,14 +631,7 @@ EvalResult Evaluator::evalInternal(
         {
           const String& t = results[currNode[0]].d_str;
           const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.prefix(t.size()) == t);
-          }
+          results[currNode] = EvalResult(s.hasPrefix(t));
           break;
         }
 
@@ -637,14 +639,7 @@ EvalResult Evaluator::evalInternal(
         {
           const String& t = results[currNode[0]].d_str;
           const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.suffix(t.size()) == t);
-          }
+          results[currNode] = EvalResult(s.hasSuffix(t));
           break;
         }
 
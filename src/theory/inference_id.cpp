@@ -39,6 +39,7 @@ const char* toString(InferenceId i)
     case InferenceId::ARITH_BB_LEMMA: return "ARITH_BB_LEMMA";
     case InferenceId::ARITH_DIO_CUT: return "ARITH_DIO_CUT";
     case InferenceId::ARITH_DIO_DECOMPOSITION: return "ARITH_DIO_DECOMPOSITION";
+    case InferenceId::ARITH_TABLEAU_CUT: return "ARITH_TABLEAU_CUT";
     case InferenceId::ARITH_SPLIT_FOR_NL_MODEL:
       return "ARITH_SPLIT_FOR_NL_MODEL";
     case InferenceId::ARITH_PP_ELIM_OPERATORS: return "ARITH_PP_ELIM_OPERATORS";
@@ -333,6 +334,7 @@ const char* toString(InferenceId i)
     case InferenceId::STRINGS_RE_DELTA: return "STRINGS_RE_DELTA";
     case InferenceId::STRINGS_RE_DELTA_CONF: return "STRINGS_RE_DELTA_CONF";
     case InferenceId::STRINGS_RE_DERIVE: return "STRINGS_RE_DERIVE";
+    case InferenceId::STRINGS_RE_LENGTH_ABS: return "STRINGS_RE_LENGTH_ABS";
     case InferenceId::STRINGS_EXTF: return "STRINGS_EXTF";
     case InferenceId::STRINGS_EXTF_N: return "STRINGS_EXTF_N";
     case InferenceId::STRINGS_EXTF_D: return "STRINGS_EXTF_D";
@@ -344,6 +346,13 @@ const char* toString(InferenceId i)
     case InferenceId::STRINGS_CTN_POS: return "STRINGS_CTN_POS";
     case InferenceId::STRINGS_REDUCTION: return "STRINGS_REDUCTION";
     case InferenceId::STRINGS_PREFIX_CONFLICT: return "STRINGS_PREFIX_CONFLICT";
+    case InferenceId::STRINGS_ARRAY_NTH_CONCAT:
+      return "STRINGS_ARRAY_NTH_CONCAT";
+    case InferenceId::STRINGS_ARRAY_NTH_UNIT: return "STRINGS_ARRAY_NTH_UNIT";
+    case InferenceId::STRINGS_ARRAY_NTH_UPDATE:
+      return "STRINGS_ARRAY_NTH_UPDATE";
+    case InferenceId::STRINGS_ARRAY_UPDATE_LEN:
+      return "STRINGS_ARRAY_UPDATE_LEN";
     case InferenceId::STRINGS_REGISTER_TERM_ATOMIC:
       return "STRINGS_REGISTER_TERM_ATOMIC";
     case InferenceId::STRINGS_REGISTER_TERM: return "STRINGS_REGISTER_TERM";
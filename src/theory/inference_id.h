@@ -67,6 +67,8 @@ enum class InferenceId
   ARITH_BB_LEMMA,
   ARITH_DIO_CUT,
   ARITH_DIO_DECOMPOSITION,
+  // a Gomory or MIR cut derived from a row of the simplex tableau
+  ARITH_TABLEAU_CUT,
   ARITH_SPLIT_FOR_NL_MODEL,
   //-------------------- preprocessing
   // equivalence of term and its preprocessed form
@@ -617,6 +619,11 @@ enum class InferenceId
   STRINGS_RE_DELTA_CONF,
   // regular expression derive ???
   STRINGS_RE_DERIVE,
+  // regular expression length abstraction
+  //   (x in R) => F(len(x))
+  // where F is a linear constraint satisfied by the lengths of the words in R
+  // (bounds and a congruence).
+  STRINGS_RE_LENGTH_ABS,
   //-------------------- extended function solver
   // Standard extended function inferences from context-dependent rewriting
   // produced by constant substitutions. See Reynolds et al CAV 2017. These are
@@ -665,6 +672,19 @@ enum class InferenceId
   //-------------------- prefix conflict
   // prefix conflict (coarse-grained)
   STRINGS_PREFIX_CONFLICT,
+  //-------------------- sequences array solver
+  // nth over the first component of a normal form
+  //   s = x ++ y => (0 <= i < len(x) => nth(s, i) = nth(x, i)) ^
+  //                 (len(x) <= i < len(s) => nth(s, i) = nth(y, i - len(x)))
+  STRINGS_ARRAY_NTH_CONCAT,
+  // nth over a unit
+  //   s = unit(e) => (i = 0 => nth(s, i) = e)
+  STRINGS_ARRAY_NTH_UNIT,
+  // nth over update, see ArraySolver
+  STRINGS_ARRAY_NTH_UPDATE,
+  // update preserves lengths
+  //   len(update(s, j, t)) = len(s)
+  STRINGS_ARRAY_UPDATE_LEN,
   //-------------------- other
   // a lemma added during term registration for an atomic term
   STRINGS_REGISTER_TERM_ATOMIC,
@@ -0,0 +1,356 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of code trees for matching compiled trigger patterns.
+ */
+
+#include "theory/quantifiers/ematching/code_tree.h"
+
+#include <limits>
+#include <queue>
+
+#include "options/quantifiers_options.h"
+#include "options/uf_options.h"
+#include "theory/quantifiers/ematching/trigger_term_info.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
+#include "theory/quantifiers/term_util.h"
+#include "theory/uf/equality_engine.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+CodeTree::CodeTree(QuantifiersState& qs, TermRegistry& tr)
+    : d_qstate(qs),
+      d_treg(tr),
+      d_numMatched(0),
+      d_lastMatched(qs.getSatContext(), 0)
+{
+}
+
+CodeTree::~CodeTree() {}
+
+bool CodeTree::addTrigger(Trigger* t, Node q, Node pat)
+{
+  // higher-order triggers extend the matches of their match generator
+  if (options::ufHo() || !isCompilableApp(pat) || TermUtil::getInstConstAttr(pat) != q)
+  {
+    return false;
+  }
+  std::vector<Instruction> code;
+  Yield yield{t, q[0].getNumChildren(), {}};
+  size_t numRegs = 1;
+  if (!compile(q, pat, code, yield.d_slotVars, numRegs))
+  {
+    return false;
+  }
+  code.push_back(Instruction{Opcode::YIELD, 0, 0, 0, Node::null()});
+  Node op = d_treg.getTermDatabase()->getMatchOperator(pat);
+  Trace("code-tree") << "Compiled " << pat << " for " << q << " into "
+                     << code.size() << " instructions" << std::endl;
+
+  // merge the code into the tree of op
+  OperatorCode& oc = d_code[op];
+  oc.d_numRegs = std::max(oc.d_numRegs, numRegs);
+  oc.d_numSlots = std::max(oc.d_numSlots, yield.d_slotVars.size());
+  std::vector<std::unique_ptr<CodeNode>>* children = &oc.d_children;
+  CodeNode* node = nullptr;
+  for (const Instruction& inst : code)
+  {
+    node = nullptr;
+    for (std::unique_ptr<CodeNode>& child : *children)
+    {
+      if (child->d_inst == inst)
+      {
+        node = child.get();
+        break;
+      }
+    }
+    if (node == nullptr)
+    {
+      children->emplace_back(new CodeNode{inst, {}, {}});
+      node = children->back().get();
+    }
+    children = &node->d_children;
+  }
+  node->d_yields.push_back(std::move(yield));
+  oc.d_triggers.push_back(t);
+  for (const Instruction& inst : code)
+  {
+    oc.d_hasChoose = oc.d_hasChoose || inst.d_opcode == Opcode::CHOOSE;
+  }
+  d_triggerOp[t] = op;
+  d_epoch[t] = 0;
+  return true;
+}
+
+bool CodeTree::compile(Node q,
+                       Node pat,
+                       std::vector<Instruction>& code,
+                       std::vector<uint64_t>& slotVars,
+                       size_t& numRegs)
+{
+  TermDb* tdb = d_treg.getTermDatabase();
+  std::map<uint64_t, size_t> slots;
+  std::queue<std::pair<size_t, Node>> toCompile;
+  toCompile.emplace(0, pat);
+  while (!toCompile.empty())
+  {
+    size_t reg = toCompile.front().first;
+    Node cur = toCompile.front().second;
+    toCompile.pop();
+    // the arguments that are matched against subpatterns, after all others
+    std::vector<size_t> subpatterns;
+    for (size_t i = 0, nchild = cur.getNumChildren(); i < nchild; ++i)
+    {
+      Node c = cur[i];
+      if (c.getKind() == INST_CONSTANT)
+      {
+        if (TermUtil::getInstConstAttr(c) != q)
+        {
+          return false;
+        }
+        uint64_t v = c.getAttribute(InstVarNumAttribute());
+        std::map<uint64_t, size_t>::iterator it = slots.find(v);
+        if (it == slots.end())
+        {
+          slots[v] = slotVars.size();
+          code.push_back(
+              Instruction{Opcode::BIND, reg, i, slotVars.size(), Node::null()});
+          slotVars.push_back(v);
+        }
+        else
+        {
+          code.push_back(
+              Instruction{Opcode::COMPARE, reg, i, it->second, Node::null()});
+        }
+      }
+      else if (!TermUtil::hasInstConstAttr(c))
+      {
+        code.push_back(Instruction{Opcode::CHECK, reg, i, 0, c});
+      }
+      else if (isCompilableApp(c) && TermUtil::getInstConstAttr(c) == q)
+      {
+        subpatterns.push_back(i);
+      }
+      else
+      {
+        return false;
+      }
+    }
+    for (size_t i : subpatterns)
+    {
+      Node op = tdb->getMatchOperator(cur[i]);
+      code.push_back(Instruction{Opcode::CHOOSE, reg, i, numRegs, op});
+      toCompile.emplace(numRegs, cur[i]);
+      numRegs++;
+    }
+  }
+  return true;
+}
+
+bool CodeTree::isCompilableApp(Node pat) const
+{
+  Kind k = pat.getKind();
+  return TriggerTermInfo::isAtomicTrigger(pat) && k != APPLY_SELECTOR
+         && k != APPLY_CONSTRUCTOR
+         && !d_treg.getTermDatabase()->getMatchOperator(pat).isNull();
+}
+
+bool CodeTree::isLegalCandidate(Node n) const
+{
+  return d_treg.getTermDatabase()->isTermActive(n)
+         && (!options::cegqi() || !TermUtil::hasInstConstAttr(n));
+}
+
+void CodeTree::resetRound()
+{
+  d_matches.clear();
+  for (std::pair<const Node, OperatorCode>& oc : d_code)
+  {
+    oc.second.d_matched = false;
+  }
+}
+
+const std::vector<std::vector<Node>>& CodeTree::getMatches(Trigger* t)
+{
+  Assert(d_triggerOp.find(t) != d_triggerOp.end());
+  Node op = d_triggerOp[t];
+  OperatorCode& oc = d_code[op];
+  if (!oc.d_matched)
+  {
+    oc.d_matched = true;
+    // The classes only grow until we backtrack past the last matching. The
+    // relevant terms may change without merges.
+    if (d_lastMatched.get() != d_numMatched
+        || options::termDbMode() != options::TermDbMode::ALL)
+    {
+      Trace("code-tree") << "Report all matches" << std::endl;
+      for (std::pair<Trigger* const, uint64_t>& e : d_epoch)
+      {
+        e.second = 0;
+      }
+    }
+    d_numMatched++;
+    d_lastMatched = d_numMatched;
+    oc.d_time = d_qstate.getEqualityEngine()->getModificationTime();
+    uint64_t minEpoch = oc.d_time;
+    for (Trigger* ot : oc.d_triggers)
+    {
+      minEpoch = std::min(minEpoch, d_epoch[ot]);
+    }
+    TermDb* tdb = d_treg.getTermDatabase();
+    d_regs.assign(oc.d_numRegs, Node::null());
+    d_slots.assign(oc.d_numSlots, Node::null());
+    size_t nskipped = 0;
+    for (size_t i = 0, nterms = tdb->getNumGroundTerms(op); i < nterms; ++i)
+    {
+      Node n = tdb->getGroundTerm(op, i);
+      if (!isLegalCandidate(n) || !tdb->hasTermCurrent(n))
+      {
+        continue;
+      }
+      uint64_t time = getModificationTime(n);
+      if (!oc.d_hasChoose)
+      {
+        // without CHOOSE, only the classes of n and its arguments are
+        // inspected
+        for (const Node& nc : n)
+        {
+          time = std::max(time, getModificationTime(nc));
+        }
+        if (time <= minEpoch)
+        {
+          nskipped++;
+          continue;
+        }
+      }
+      d_regs[0] = n;
+      execute(oc.d_children, time);
+    }
+    Trace("code-tree") << "Matched terms of " << op << ", skipped " << nskipped
+                       << " unchanged terms" << std::endl;
+  }
+  return d_matches[t];
+}
+
+void CodeTree::setMatchesSent(Trigger* t)
+{
+  Assert(d_triggerOp.find(t) != d_triggerOp.end());
+  const OperatorCode& oc = d_code[d_triggerOp[t]];
+  Assert(oc.d_matched);
+  d_epoch[t] = oc.d_time;
+}
+
+uint64_t CodeTree::getModificationTime(Node n) const
+{
+  eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
+  return ee->hasTerm(n) ? ee->getModificationTime(n)
+                        : std::numeric_limits<uint64_t>::max();
+}
+
+void CodeTree::execute(const std::vector<std::unique_ptr<CodeNode>>& nodes,
+                       uint64_t time)
+{
+  for (const std::unique_ptr<CodeNode>& node : nodes)
+  {
+    execute(*node, time);
+  }
+}
+
+void CodeTree::execute(const CodeNode& node, uint64_t time)
+{
+  const Instruction& inst = node.d_inst;
+  switch (inst.d_opcode)
+  {
+    case Opcode::BIND:
+      d_slots[inst.d_index] = d_regs[inst.d_reg][inst.d_arg];
+      execute(node.d_children, time);
+      break;
+    case Opcode::COMPARE:
+    {
+      Node arg = d_regs[inst.d_reg][inst.d_arg];
+      if (d_qstate.areEqual(d_slots[inst.d_index], arg))
+      {
+        execute(node.d_children, std::max(time, getModificationTime(arg)));
+      }
+      break;
+    }
+    case Opcode::CHECK:
+    {
+      Node arg = d_regs[inst.d_reg][inst.d_arg];
+      if (d_qstate.areEqual(inst.d_node, arg))
+      {
+        execute(node.d_children, std::max(time, getModificationTime(arg)));
+      }
+      break;
+    }
+    case Opcode::CHOOSE:
+    {
+      // the candidates are the terms with the operator in the equivalence
+      // class of the argument, see CandidateGeneratorQE
+      TermDb* tdb = d_treg.getTermDatabase();
+      Node arg = d_regs[inst.d_reg][inst.d_arg];
+      eq::EqualityEngine* ee = d_qstate.getEqualityEngine();
+      std::vector<Node> candidates;
+      time = std::max(time, getModificationTime(arg));
+      if (!ee->hasTerm(arg))
+      {
+        candidates.push_back(arg);
+      }
+      else if (tdb->getTermArgTrie(arg, inst.d_node) != nullptr)
+      {
+        eq::EqClassIterator eqc(ee->getRepresentative(arg), ee);
+        for (; !eqc.isFinished(); ++eqc)
+        {
+          candidates.push_back(*eqc);
+        }
+      }
+      for (const Node& c : candidates)
+      {
+        if (c.hasOperator() && isLegalCandidate(c)
+            && tdb->getMatchOperator(c) == inst.d_node)
+        {
+          d_regs[inst.d_index] = c;
+          execute(node.d_children, time);
+        }
+      }
+      break;
+    }
+    case Opcode::YIELD:
+      for (const Yield& y : node.d_yields)
+      {
+        if (time <= d_epoch[y.d_trigger])
+        {
+          // sent in a previous round
+          continue;
+        }
+        std::vector<Node> m(y.d_numVars);
+        for (size_t i = 0, nslots = y.d_slotVars.size(); i < nslots; ++i)
+        {
+          m[y.d_slotVars[i]] = d_slots[i];
+        }
+        d_matches[y.d_trigger].push_back(std::move(m));
+      }
+      Assert(node.d_children.empty());
+      break;
+  }
+}
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
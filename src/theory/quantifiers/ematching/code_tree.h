@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Code trees for matching compiled trigger patterns.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__EMATCHING__CODE_TREE_H
+#define CVC5__THEORY__QUANTIFIERS__EMATCHING__CODE_TREE_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "context/cdo.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+class TermRegistry;
+
+namespace inst {
+
+class Trigger;
+
+/**
+ * Code trees in the style of "Efficient E-matching for SMT solvers" (de Moura
+ * and Bjorner, CADE 2007).
+ *
+ * A pattern f(t1, ..., tn) is compiled into a sequence of instructions that
+ * match a candidate term against it, using registers that hold the current
+ * candidate subterms (register 0 holds the candidate for the top-level
+ * pattern):
+ *
+ * - BIND r i s : store argument i of register r in variable slot s,
+ * - COMPARE r i s : check that argument i of register r is equal to slot s,
+ * - CHECK r i g : check that argument i of register r is equal to the ground
+ *   term g,
+ * - CHOOSE r i op r' : for every term with operator op in the equivalence
+ *   class of argument i of register r, store it in register r' and continue,
+ * - YIELD : report a match for the triggers of the pattern.
+ *
+ * Variables are numbered by their first occurrence, so that the patterns of
+ * different quantified formulas with a common structure compile to common
+ * instruction prefixes. The sequences of all patterns with the same top-level
+ * operator are merged into a tree that shares these prefixes, and the tree is
+ * executed once per instantiation round for every candidate term, computing
+ * the matches of all its patterns at once.
+ *
+ * Matching is incremental: a match is only reported for a trigger if one of
+ * the equivalence classes that were inspected to find it (via COMPARE, CHECK
+ * or CHOOSE, or the class of the candidate term) was created or merged into
+ * since the last round in which the trigger took its matches, according to
+ * the modification times of the equality engine. All other matches were
+ * reported before. For trees without CHOOSE instructions, candidate terms
+ * whose class and argument classes are unchanged are skipped altogether.
+ * After backtracking past the last round, or if the term database uses
+ * relevance, all matches are reported again.
+ */
+class CodeTree
+{
+ public:
+  CodeTree(QuantifiersState& qs, TermRegistry& tr);
+  ~CodeTree();
+  /**
+   * Compile pattern pat of trigger t, for quantified formula q. Returns false
+   * if pat cannot be compiled, in which case the trigger must use its own
+   * match generator.
+   */
+  bool addTrigger(Trigger* t, Node q, Node pat);
+  /** Reset the matches, called at the beginning of an instantiation round. */
+  void resetRound();
+  /**
+   * Get the matches of trigger t in the current round, which are computed for
+   * all triggers with the same top-level operator on the first call. Only
+   * matches that may be new since the last call to setMatchesSent for t are
+   * returned.
+   */
+  const std::vector<std::vector<Node>>& getMatches(Trigger* t);
+  /**
+   * Notify that all matches returned by getMatches for t in the current round
+   * were sent. The matches that t would get again in a later round are then
+   * no longer reported. This should not be called if the caller stopped
+   * sending matches early.
+   */
+  void setMatchesSent(Trigger* t);
+
+ private:
+  enum class Opcode
+  {
+    BIND,
+    COMPARE,
+    CHECK,
+    CHOOSE,
+    YIELD
+  };
+  /** An instruction, see the class comment */
+  struct Instruction
+  {
+    bool operator==(const Instruction& i) const
+    {
+      return d_opcode == i.d_opcode && d_reg == i.d_reg && d_arg == i.d_arg
+             && d_index == i.d_index && d_node == i.d_node;
+    }
+    Opcode d_opcode;
+    /** The register */
+    size_t d_reg;
+    /** The argument of the register */
+    size_t d_arg;
+    /** The variable slot (BIND, COMPARE) or the new register (CHOOSE) */
+    size_t d_index;
+    /** The ground term (CHECK) or the operator (CHOOSE) */
+    Node d_node;
+  };
+  /** A trigger whose pattern ends in a YIELD instruction */
+  struct Yield
+  {
+    Trigger* d_trigger;
+    /** The number of variables of the quantified formula */
+    size_t d_numVars;
+    /** The variable number of each slot */
+    std::vector<uint64_t> d_slotVars;
+  };
+  /** A node of the code tree */
+  struct CodeNode
+  {
+    Instruction d_inst;
+    std::vector<std::unique_ptr<CodeNode>> d_children;
+    /** For YIELD nodes, the triggers of the pattern */
+    std::vector<Yield> d_yields;
+  };
+  /** The code of a top-level operator */
+  struct OperatorCode
+  {
+    std::vector<std::unique_ptr<CodeNode>> d_children;
+    /** The triggers whose patterns are compiled in this tree */
+    std::vector<Trigger*> d_triggers;
+    size_t d_numRegs = 1;
+    size_t d_numSlots = 0;
+    /** Whether the tree contains CHOOSE instructions */
+    bool d_hasChoose = false;
+    /** The modification time at which the matches of this round were made */
+    uint64_t d_time = 0;
+    /** Whether the matches of the current round were computed */
+    bool d_matched = false;
+  };
+  /**
+   * Compile pat into code. Returns false if some subterm of pat is not
+   * supported.
+   */
+  bool compile(Node q,
+               Node pat,
+               std::vector<Instruction>& code,
+               std::vector<uint64_t>& slotVars,
+               size_t& numRegs);
+  /** Returns true if pat is an application that can be compiled */
+  bool isCompilableApp(Node pat) const;
+  /** Returns true if n is a candidate term for matching */
+  bool isLegalCandidate(Node n) const;
+  /**
+   * Get the modification time of the equivalence class of n, which is
+   * maximal if n is not in the equality engine.
+   */
+  uint64_t getModificationTime(Node n) const;
+  /**
+   * Execute the children of a code node, where time is the maximal
+   * modification time of the classes inspected so far.
+   */
+  void execute(const std::vector<std::unique_ptr<CodeNode>>& nodes,
+               uint64_t time);
+  /** Execute a code node */
+  void execute(const CodeNode& node, uint64_t time);
+
+  /** Reference to the quantifiers state */
+  QuantifiersState& d_qstate;
+  /** Reference to the term registry */
+  TermRegistry& d_treg;
+  /** The code for each top-level match operator */
+  std::map<Node, OperatorCode> d_code;
+  /** The match operator of the triggers */
+  std::map<Trigger*, Node> d_triggerOp;
+  /**
+   * The modification time up to which the matches of the triggers were
+   * sent, see setMatchesSent.
+   */
+  std::map<Trigger*, uint64_t> d_epoch;
+  /** The number of times matches were made */
+  uint64_t d_numMatched;
+  /**
+   * The value of d_numMatched when matches were last made in the current SAT
+   * context, which differs from d_numMatched after backtracking.
+   */
+  context::CDO<uint64_t> d_lastMatched;
+  /** The matches of the triggers in the current round */
+  std::map<Trigger*, std::vector<std::vector<Node>>> d_matches;
+  /** The registers and variable slots during execution */
+  std::vector<Node> d_regs;
+  std::vector<Node> d_slots;
+};
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__QUANTIFIERS__EMATCHING__CODE_TREE_H */
@@ -38,10 +38,11 @@ HigherOrderTrigger::HigherOrderTrigger(
     QuantifiersInferenceManager& qim,
     QuantifiersRegistry& qr,
     TermRegistry& tr,
+    TriggerDatabase& tdb,
     Node q,
     std::vector<Node>& nodes,
     std::map<Node, std::vector<Node> >& ho_apps)
-    : Trigger(qs, qim, qr, tr, q, nodes), d_ho_var_apps(ho_apps)
+    : Trigger(qs, qim, qr, tr, tdb, q, nodes), d_ho_var_apps(ho_apps)
 {
   NodeManager* nm = NodeManager::currentNM();
   // process the higher-order variable applications
@@ -96,6 +96,7 @@ class HigherOrderTrigger : public Trigger
                      QuantifiersInferenceManager& qim,
                      QuantifiersRegistry& qr,
                      TermRegistry& tr,
+                     TriggerDatabase& tdb,
                      Node q,
                      std::vector<Node>& nodes,
                      std::map<Node, std::vector<Node> >& ho_apps);
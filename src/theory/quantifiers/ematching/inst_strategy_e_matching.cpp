@@ -87,11 +87,10 @@ void InstStrategyAutoGenTriggers::processResetInstantiationRound( Theory::Effort
   Trace("inst-alg-debug") << "reset auto-gen triggers" << std::endl;
   //reset triggers
   for( unsigned r=0; r<2; r++ ){
-    std::map<Node, std::map<inst::Trigger*, bool> >& agts =
-        d_auto_gen_trigger[r];
-    for (std::pair<const Node, std::map<inst::Trigger*, bool> >& agt : agts)
+    std::map<Node, TriggerMap>& agts = d_auto_gen_trigger[r];
+    for (std::pair<const Node, TriggerMap>& agt : agts)
     {
-      for (std::map<inst::Trigger*, bool>::iterator it = agt.second.begin();
+      for (TriggerMap::iterator it = agt.second.begin();
            it != agt.second.end();
            ++it)
       {
@@ -151,8 +150,8 @@ InstStrategyStatus InstStrategyAutoGenTriggers::process(Node f,
   {
     int max_score = -1;
     Trigger* max_trigger = nullptr;
-    std::map<Trigger*, bool>& agt = d_auto_gen_trigger[0][f];
-    for (std::map<Trigger*, bool>::iterator it = agt.begin(); it != agt.end();
+    TriggerMap& agt = d_auto_gen_trigger[0][f];
+    for (TriggerMap::iterator it = agt.begin(); it != agt.end();
          ++it)
     {
       Trigger* t = it->first;
@@ -184,8 +183,8 @@ InstStrategyStatus InstStrategyAutoGenTriggers::process(Node f,
   bool hasInst = false;
   for (unsigned r = 0; r < 2; r++)
   {
-    std::map<Trigger*, bool>& agt = d_auto_gen_trigger[r][f];
-    for (std::map<Trigger*, bool>::iterator it = agt.begin(); it != agt.end();
+    TriggerMap& agt = d_auto_gen_trigger[r][f];
+    for (TriggerMap::iterator it = agt.begin(); it != agt.end();
          ++it)
     {
       Trigger* tr = it->first;
@@ -632,8 +631,8 @@ void InstStrategyAutoGenTriggers::addTrigger( inst::Trigger * tr, Node q ) {
   if (tr->isMultiTrigger())
   {
     // disable all other multi triggers
-    std::map<Trigger*, bool>& agt = d_auto_gen_trigger[1][q];
-    for (std::map<Trigger*, bool>::iterator it = agt.begin(); it != agt.end();
+    TriggerMap& agt = d_auto_gen_trigger[1][q];
+    for (TriggerMap::iterator it = agt.begin(); it != agt.end();
          ++it)
     {
       agt[it->first] = false;
@@ -645,7 +644,7 @@ void InstStrategyAutoGenTriggers::addTrigger( inst::Trigger * tr, Node q ) {
     tindex = 0;
   }
   // making it during an instantiation round, so must reset
-  std::map<Trigger*, bool>& agt = d_auto_gen_trigger[tindex][q];
+  TriggerMap& agt = d_auto_gen_trigger[tindex][q];
   if (agt.find(tr) == agt.end())
   {
     tr->resetInstantiationRound();
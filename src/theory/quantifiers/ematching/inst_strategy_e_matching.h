@@ -46,8 +46,22 @@ class InstStrategyAutoGenTriggers : public InstStrategy
   /** regeneration */
   bool d_regenerate;
   int d_regenerate_frequency;
+  /** Orders triggers by their id, i.e., in the order they were created. */
+  struct TriggerIdLess
+  {
+    bool operator()(inst::Trigger* a, inst::Trigger* b) const
+    {
+      Assert(a != nullptr && b != nullptr);
+      return a->getId() < b->getId();
+    }
+  };
+  /**
+   * Maps triggers to whether they are active. The triggers are ordered by id
+   * so that they are processed in a deterministic order.
+   */
+  typedef std::map<inst::Trigger*, bool, TriggerIdLess> TriggerMap;
   /** (single,multi) triggers for each quantifier */
-  std::map<Node, std::map<inst::Trigger*, bool> > d_auto_gen_trigger[2];
+  std::map<Node, TriggerMap> d_auto_gen_trigger[2];
   std::map<Node, int> d_counter;
   /** single, multi triggers for each quantifier */
   std::map<Node, std::vector<Node> > d_patTerms[2];
@@ -124,6 +124,7 @@ bool InstantiationEngine::needsCheck( Theory::Effort e ){
 }
 
 void InstantiationEngine::reset_round( Theory::Effort e ){
+  d_trdb.resetRound();
   //if not, proceed to instantiation round
   //reset the instantiation strategies
   for( unsigned i=0; i<d_instStrategies.size(); ++i ){
@@ -23,6 +23,7 @@
 #include "theory/quantifiers/ematching/inst_match_generator_multi_linear.h"
 #include "theory/quantifiers/ematching/inst_match_generator_simple.h"
 #include "theory/quantifiers/ematching/pattern_term_selector.h"
+#include "theory/quantifiers/ematching/trigger_database.h"
 #include "theory/quantifiers/ematching/trigger_trie.h"
 #include "theory/quantifiers/inst_match.h"
 #include "theory/quantifiers/instantiate.h"
@@ -45,9 +46,17 @@ Trigger::Trigger(QuantifiersState& qs,
                  QuantifiersInferenceManager& qim,
                  QuantifiersRegistry& qr,
                  TermRegistry& tr,
+                 TriggerDatabase& tdb,
                  Node q,
                  std::vector<Node>& nodes)
-    : d_qstate(qs), d_qim(qim), d_qreg(qr), d_treg(tr), d_quant(q)
+    : d_qstate(qs),
+      d_qim(qim),
+      d_qreg(qr),
+      d_treg(tr),
+      d_tdb(tdb),
+      d_id(tdb.newTriggerId()),
+      d_quant(q),
+      d_useCodeTree(false)
 {
   // We must ensure that the ground subterms of the trigger have been
   // preprocessed.
@@ -76,6 +85,10 @@ Trigger::Trigger(QuantifiersState& qs,
     }else{
       d_mg = InstMatchGenerator::mkInstMatchGenerator(this, q, d_nodes[0]);
       ++(stats.d_simple_triggers);
+      if (options::ematchCodeTree())
+      {
+        d_useCodeTree = d_tdb.getCodeTree().addTrigger(this, q, d_nodes[0]);
+      }
     }
   }else{
     if( options::multiTriggerCache() ){
@@ -134,7 +147,35 @@ uint64_t Trigger::addInstantiations()
       }
     }
   }
-  uint64_t addedLemmas = d_mg->addInstantiations(d_quant);
+  uint64_t addedLemmas = 0;
+  if (d_useCodeTree)
+  {
+    // copy the matches, since sending an instantiation may add terms
+    std::vector<std::vector<Node>> matches =
+        d_tdb.getCodeTree().getMatches(this);
+    bool sentAll = true;
+    for (std::vector<Node>& m : matches)
+    {
+      if (sendInstantiation(m, InferenceId::QUANTIFIERS_INST_E_MATCHING))
+      {
+        addedLemmas++;
+        if (d_qstate.isInConflict())
+        {
+          sentAll = false;
+          break;
+        }
+      }
+    }
+    // only matches that were sent may be skipped in later rounds
+    if (sentAll)
+    {
+      d_tdb.getCodeTree().setMatchesSent(this);
+    }
+  }
+  else
+  {
+    addedLemmas = d_mg->addInstantiations(d_quant);
+  }
   if (Debug.isOn("inst-trigger"))
   {
     if (addedLemmas > 0)
@@ -148,6 +189,13 @@ uint64_t Trigger::addInstantiations()
 
 bool Trigger::sendInstantiation(std::vector<Node>& m, InferenceId id)
 {
+  // The triggers of a quantified formula often produce the same match in an
+  // instantiation round. Since the outcome of sending a match does not change
+  // within a round, each match is sent at most once per round.
+  if (!d_tdb.addRoundMatch(d_quant, m))
+  {
+    return false;
+  }
   return d_qim.getInstantiate()->addInstantiation(d_quant, m, id);
 }
 
@@ -37,6 +37,7 @@ class InstMatch;
 namespace inst {
 
 class IMGenerator;
+class TriggerDatabase;
 class InstMatchGenerator;
 /** A collection of nodes representing a trigger.
  *
@@ -104,6 +105,7 @@ class Trigger {
           QuantifiersInferenceManager& qim,
           QuantifiersRegistry& qr,
           TermRegistry& tr,
+          TriggerDatabase& tdb,
           Node q,
           std::vector<Node>& nodes);
   virtual ~Trigger();
@@ -132,6 +134,11 @@ class Trigger {
   virtual uint64_t addInstantiations();
   /** Return whether this is a multi-trigger. */
   bool isMultiTrigger() const;
+  /**
+   * Get the id of this trigger, triggers are numbered in the order in which
+   * they are created by the trigger database.
+   */
+  size_t getId() const { return d_id; }
   /** Get instantiation pattern list associated with this trigger.
    *
   * An instantiation pattern list is the node representation of a trigger, in
@@ -203,6 +210,10 @@ class Trigger {
   QuantifiersRegistry& d_qreg;
   /** Reference to the term registry */
   TermRegistry& d_treg;
+  /** The trigger database that created this trigger */
+  TriggerDatabase& d_tdb;
+  /** The id of this trigger */
+  size_t d_id;
   /** The quantified formula this trigger is for. */
   Node d_quant;
   /** match generator
@@ -211,6 +222,11 @@ class Trigger {
   * algorithm associated with this trigger.
   */
   IMGenerator* d_mg;
+  /**
+   * Whether the matches of this trigger are computed by the code tree of the
+   * trigger database instead of d_mg.
+   */
+  bool d_useCodeTree;
 }; /* class Trigger */
 
 }  // namespace inst
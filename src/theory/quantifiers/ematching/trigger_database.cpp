@@ -28,11 +28,27 @@ TriggerDatabase::TriggerDatabase(QuantifiersState& qs,
                                  QuantifiersInferenceManager& qim,
                                  QuantifiersRegistry& qr,
                                  TermRegistry& tr)
-    : d_qs(qs), d_qim(qim), d_qreg(qr), d_treg(tr)
+    : d_qs(qs),
+      d_qim(qim),
+      d_qreg(qr),
+      d_treg(tr),
+      d_numTriggers(0),
+      d_codeTree(qs, tr)
 {
 }
 TriggerDatabase::~TriggerDatabase() {}
 
+void TriggerDatabase::resetRound()
+{
+  d_roundMatches.clear();
+  d_codeTree.resetRound();
+}
+
+bool TriggerDatabase::addRoundMatch(Node q, const std::vector<Node>& m)
+{
+  return d_roundMatches[q].addInstMatch(d_qs, q, m);
+}
+
 Trigger* TriggerDatabase::mkTrigger(Node q,
                                     const std::vector<Node>& nodes,
                                     bool keepAll,
@@ -78,11 +94,12 @@ Trigger* TriggerDatabase::mkTrigger(Node q,
   Trigger* t;
   if (!hoApps.empty())
   {
-    t = new HigherOrderTrigger(d_qs, d_qim, d_qreg, d_treg, q, trNodes, hoApps);
+    t = new HigherOrderTrigger(
+        d_qs, d_qim, d_qreg, d_treg, *this, q, trNodes, hoApps);
   }
   else
   {
-    t = new Trigger(d_qs, d_qim, d_qreg, d_treg, q, trNodes);
+    t = new Trigger(d_qs, d_qim, d_qreg, d_treg, *this, q, trNodes);
   }
   d_trie.addTrigger(trNodes, t);
   return t;
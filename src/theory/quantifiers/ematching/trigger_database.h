@@ -21,7 +21,9 @@
 #include <vector>
 
 #include "expr/node.h"
+#include "theory/quantifiers/ematching/code_tree.h"
 #include "theory/quantifiers/ematching/trigger_trie.h"
+#include "theory/quantifiers/inst_match_trie.h"
 
 namespace cvc5 {
 namespace theory {
@@ -90,6 +92,18 @@ class TriggerDatabase
                              size_t nvars,
                              std::vector<Node>& trNodes);
 
+  /** Get a new trigger id, called when a trigger is constructed. */
+  size_t newTriggerId() { return d_numTriggers++; }
+  /** Reset the matches of the current instantiation round. */
+  void resetRound();
+  /**
+   * Record that a trigger for q produced match m in the current instantiation
+   * round. Returns false if some trigger for q produced m before.
+   */
+  bool addRoundMatch(Node q, const std::vector<Node>& m);
+  /** Get the code tree of the triggers that are matched via compiled code. */
+  CodeTree& getCodeTree() { return d_codeTree; }
+
  private:
   /** The trigger trie, containing the triggers */
   TriggerTrie d_trie;
@@ -101,6 +115,12 @@ class TriggerDatabase
   QuantifiersRegistry& d_qreg;
   /** Reference to the term registry */
   TermRegistry& d_treg;
+  /** The number of triggers created so far */
+  size_t d_numTriggers;
+  /** The matches of the current instantiation round, per quantified formula */
+  std::map<Node, InstMatchTrie> d_roundMatches;
+  /** The code tree */
+  CodeTree d_codeTree;
 };
 
 }  // namespace inst
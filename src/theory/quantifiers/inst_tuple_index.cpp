@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of the hash-based index of instantiations.
+ */
+
+#include "theory/quantifiers/inst_tuple_index.h"
+
+#include <algorithm>
+
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/uf/equality_engine_iterator.h"
+#include "util/hash.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+namespace {
+
+/** The hash of the empty tuple */
+const uint64_t s_emptyHash = 14695981039346656037U;
+
+/** Returns the hash of the tuple extended by n, given the hash h of it */
+uint64_t extendHash(uint64_t h, TNode n)
+{
+  return fnv1a::fnv1a_64(NodeHashFunction()(n), h);
+}
+
+/** Add the hashes of the proper prefixes of m to prefixes */
+void addPrefixes(std::unordered_set<uint64_t>& prefixes,
+                 const std::vector<Node>& m)
+{
+  uint64_t h = s_emptyHash;
+  for (size_t i = 0, nprefixes = m.empty() ? 0 : m.size() - 1; i < nprefixes;
+       i++)
+  {
+    h = extendHash(h, m[i]);
+    prefixes.insert(h);
+  }
+}
+
+/**
+ * Returns true if exists(cur) holds for a tuple cur that agrees with the
+ * current tuple cur up to index i, and whose terms from index i are equal to
+ * those of m in the equality engine of qs. The hash of the prefix of cur up to
+ * index i is h, and only extensions whose hashes are in prefixes are
+ * considered.
+ */
+template <class Exists>
+bool existsModEqRec(QuantifiersState& qs,
+                    const std::vector<Node>& m,
+                    const std::unordered_set<uint64_t>& prefixes,
+                    Exists exists,
+                    std::vector<Node>& cur,
+                    size_t i,
+                    uint64_t h)
+{
+  std::vector<Node> cands;
+  cands.push_back(m[i]);
+  if (!m[i].isNull() && qs.hasTerm(m[i]))
+  {
+    eq::EqClassIterator eqc(qs.getRepresentative(m[i]),
+                            qs.getEqualityEngine());
+    while (!eqc.isFinished())
+    {
+      Node en = (*eqc);
+      if (en != m[i])
+      {
+        cands.push_back(en);
+      }
+      ++eqc;
+    }
+  }
+  bool last = (i + 1 == m.size());
+  for (const Node& c : cands)
+  {
+    cur[i] = c;
+    if (last)
+    {
+      if (exists(cur))
+      {
+        return true;
+      }
+      continue;
+    }
+    uint64_t hc = extendHash(h, c);
+    if (prefixes.find(hc) != prefixes.end()
+        && existsModEqRec(qs, m, prefixes, exists, cur, i + 1, hc))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Returns true if a tuple equal to m position-wise satisfies exists */
+template <class Exists>
+bool existsTupleModEq(QuantifiersState& qs,
+                      const std::vector<Node>& m,
+                      const std::unordered_set<uint64_t>& prefixes,
+                      Exists exists)
+{
+  if (exists(m))
+  {
+    return true;
+  }
+  if (m.empty())
+  {
+    return false;
+  }
+  std::vector<Node> cur(m.size());
+  return existsModEqRec(qs, m, prefixes, exists, cur, 0, s_emptyHash);
+}
+
+}  // namespace
+
+size_t InstTupleHashFunction::operator()(const std::vector<Node>& m) const
+{
+  uint64_t h = s_emptyHash;
+  for (const Node& n : m)
+  {
+    h = extendHash(h, n);
+  }
+  return static_cast<size_t>(h);
+}
+
+InstTupleIndex::InstTupleIndex() : d_hasPrefixes(false) {}
+
+bool InstTupleIndex::add(const std::vector<Node>& m)
+{
+  if (!d_tuples.insert(m).second)
+  {
+    return false;
+  }
+  if (d_hasPrefixes)
+  {
+    addPrefixes(d_prefixes, m);
+  }
+  return true;
+}
+
+bool InstTupleIndex::exists(const std::vector<Node>& m) const
+{
+  return d_tuples.find(m) != d_tuples.end();
+}
+
+bool InstTupleIndex::existsModEq(QuantifiersState& qs,
+                                 const std::vector<Node>& m)
+{
+  if (!d_hasPrefixes)
+  {
+    for (const std::vector<Node>& t : d_tuples)
+    {
+      addPrefixes(d_prefixes, t);
+    }
+    d_hasPrefixes = true;
+  }
+  return existsTupleModEq(
+      qs, m, d_prefixes, [this](const std::vector<Node>& t) {
+        return exists(t);
+      });
+}
+
+bool InstTupleIndex::remove(const std::vector<Node>& m)
+{
+  return d_tuples.erase(m) > 0;
+}
+
+void InstTupleIndex::getInstantiations(
+    std::vector<std::vector<Node>>& insts) const
+{
+  size_t start = insts.size();
+  insts.insert(insts.end(), d_tuples.begin(), d_tuples.end());
+  std::sort(insts.begin() + start, insts.end());
+}
+
+size_t InstTupleIndex::size() const { return d_tuples.size(); }
+
+void InstTupleIndex::clear()
+{
+  d_tuples.clear();
+  d_prefixes.clear();
+  d_hasPrefixes = false;
+}
+
+CDInstTupleIndex::CDInstTupleIndex(context::Context* c)
+    : d_tuples(c), d_hasPrefixes(false)
+{
+}
+
+bool CDInstTupleIndex::add(const std::vector<Node>& m)
+{
+  context::CDHashMap<std::vector<Node>, bool, InstTupleHashFunction>::
+      const_iterator it = d_tuples.find(m);
+  if (it != d_tuples.end() && (*it).second)
+  {
+    return false;
+  }
+  d_tuples.insert(m, true);
+  if (d_hasPrefixes)
+  {
+    addPrefixes(d_prefixes, m);
+  }
+  return true;
+}
+
+bool CDInstTupleIndex::exists(const std::vector<Node>& m) const
+{
+  context::CDHashMap<std::vector<Node>, bool, InstTupleHashFunction>::
+      const_iterator it = d_tuples.find(m);
+  return it != d_tuples.end() && (*it).second;
+}
+
+bool CDInstTupleIndex::existsModEq(QuantifiersState& qs,
+                                   const std::vector<Node>& m)
+{
+  if (!d_hasPrefixes)
+  {
+    for (const auto& t : d_tuples)
+    {
+      addPrefixes(d_prefixes, t.first);
+    }
+    d_hasPrefixes = true;
+  }
+  return existsTupleModEq(
+      qs, m, d_prefixes, [this](const std::vector<Node>& t) {
+        return exists(t);
+      });
+}
+
+bool CDInstTupleIndex::remove(const std::vector<Node>& m)
+{
+  if (!exists(m))
+  {
+    return false;
+  }
+  d_tuples.insert(m, false);
+  return true;
+}
+
+void CDInstTupleIndex::getInstantiations(
+    std::vector<std::vector<Node>>& insts) const
+{
+  size_t start = insts.size();
+  for (const auto& t : d_tuples)
+  {
+    if (t.second)
+    {
+      insts.push_back(t.first);
+    }
+  }
+  std::sort(insts.begin() + start, insts.end());
+}
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,136 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Hash-based index of the instantiations of a quantified formula.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__INST_TUPLE_INDEX_H
+#define CVC5__THEORY__QUANTIFIERS__INST_TUPLE_INDEX_H
+
+#include <unordered_set>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "expr/node.h"
+
+namespace cvc5 {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+
+/** Hash function for tuples of terms */
+struct InstTupleHashFunction
+{
+  size_t operator()(const std::vector<Node>& m) const;
+};
+
+/**
+ * Set of the tuples of terms that a quantified formula was instantiated with.
+ *
+ * Unlike InstMatchTrie, which stores a tuple as a path of std::map nodes, a
+ * tuple is stored here as a single entry of a hash set, so that checking and
+ * adding a tuple of k terms takes O(k) expected time and one allocation.
+ *
+ * Checking for a tuple modulo equality enumerates the tuples of terms that are
+ * equal to the given ones position-wise. To prune this enumeration, the
+ * hashes of the proper prefixes of the stored tuples are kept in a separate
+ * set, which is only built once a check modulo equality is made. Since it is
+ * only used for pruning, collisions and stale prefixes of removed tuples are
+ * harmless.
+ */
+class InstTupleIndex
+{
+ public:
+  InstTupleIndex();
+  /**
+   * Add m to this index, returns true if and only if m did not already occur
+   * in it.
+   */
+  bool add(const std::vector<Node>& m);
+  /** Returns true if m occurs in this index */
+  bool exists(const std::vector<Node>& m) const;
+  /**
+   * Returns true if a tuple that is equal to m position-wise in the equality
+   * engine of qs occurs in this index.
+   */
+  bool existsModEq(QuantifiersState& qs, const std::vector<Node>& m);
+  /** Remove m from this index, returns true if it occurred in it */
+  bool remove(const std::vector<Node>& m);
+  /**
+   * Adds the tuples of this index into insts, in lexicographic order of their
+   * terms.
+   */
+  void getInstantiations(std::vector<std::vector<Node>>& insts) const;
+  /** The number of tuples in this index */
+  size_t size() const;
+  /** Clear this index */
+  void clear();
+
+ private:
+  /** The tuples */
+  std::unordered_set<std::vector<Node>, InstTupleHashFunction> d_tuples;
+  /** The hashes of the proper prefixes of the tuples */
+  std::unordered_set<uint64_t> d_prefixes;
+  /** Whether d_prefixes is maintained */
+  bool d_hasPrefixes;
+};
+
+/**
+ * Context-dependent version of the above class, where tuples are removed from
+ * the index when the context in which they were added is popped.
+ */
+class CDInstTupleIndex
+{
+ public:
+  CDInstTupleIndex(context::Context* c);
+  /**
+   * Add m to this index, returns true if and only if m did not already occur
+   * in it.
+   */
+  bool add(const std::vector<Node>& m);
+  /** Returns true if m occurs in this index */
+  bool exists(const std::vector<Node>& m) const;
+  /**
+   * Returns true if a tuple that is equal to m position-wise in the equality
+   * engine of qs occurs in this index.
+   */
+  bool existsModEq(QuantifiersState& qs, const std::vector<Node>& m);
+  /** Remove m from this index, returns true if it occurred in it */
+  bool remove(const std::vector<Node>& m);
+  /**
+   * Adds the tuples of this index into insts, in lexicographic order of their
+   * terms.
+   */
+  void getInstantiations(std::vector<std::vector<Node>>& insts) const;
+
+ private:
+  /**
+   * The tuples, mapped to false if they were removed. Since context-dependent
+   * maps do not support erasing, removed tuples are kept with value false.
+   */
+  context::CDHashMap<std::vector<Node>, bool, InstTupleHashFunction> d_tuples;
+  /**
+   * The hashes of the proper prefixes of the tuples. This set is not
+   * context-dependent, which is harmless since it is only used for pruning.
+   */
+  std::unordered_set<uint64_t> d_prefixes;
+  /** Whether d_prefixes is maintained */
+  bool d_hasPrefixes;
+};
+
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__QUANTIFIERS__INST_TUPLE_INDEX_H */
@@ -52,19 +52,12 @@ Instantiate::Instantiate(QuantifiersState& qs,
       d_treg(tr),
       d_pnm(pnm),
       d_insts(qs.getUserContext()),
-      d_c_inst_match_trie_dom(qs.getUserContext()),
+      d_c_inst_index_dom(qs.getUserContext()),
       d_pfInst(pnm ? new CDProof(pnm) : nullptr)
 {
 }
 
-Instantiate::~Instantiate()
-{
-  for (std::pair<const Node, CDInstMatchTrie*>& t : d_c_inst_match_trie)
-  {
-    delete t.second;
-  }
-  d_c_inst_match_trie.clear();
-}
+Instantiate::~Instantiate() {}
 
 bool Instantiate::reset(Theory::Effort e)
 {
@@ -495,18 +488,23 @@ bool Instantiate::existsInstantiation(Node q,
 {
   if (options::incrementalSolving())
   {
-    std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
-    if (it != d_c_inst_match_trie.end())
+    std::unordered_map<Node,
+                       std::unique_ptr<CDInstTupleIndex>,
+                       NodeHashFunction>::iterator it = d_c_inst_index.find(q);
+    if (it != d_c_inst_index.end())
     {
-      return it->second->existsInstMatch(d_qstate, q, terms, modEq);
+      return modEq ? it->second->existsModEq(d_qstate, terms)
+                   : it->second->exists(terms);
     }
   }
   else
   {
-    std::map<Node, InstMatchTrie>::iterator it = d_inst_match_trie.find(q);
-    if (it != d_inst_match_trie.end())
+    std::unordered_map<Node, InstTupleIndex, NodeHashFunction>::iterator it =
+        d_inst_index.find(q);
+    if (it != d_inst_index.end())
     {
-      return it->second.existsInstMatch(d_qstate, q, terms, modEq);
+      return modEq ? it->second.existsModEq(d_qstate, terms)
+                   : it->second.exists(terms);
     }
   }
   return false;
@@ -568,38 +566,50 @@ bool Instantiate::recordInstantiationInternal(Node q,
   if (options::incrementalSolving())
   {
     Trace("inst-add-debug")
-        << "Adding into context-dependent inst trie, modEq = " << modEq
+        << "Adding into context-dependent inst index, modEq = " << modEq
         << std::endl;
-    CDInstMatchTrie* imt;
-    std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
-    if (it != d_c_inst_match_trie.end())
+    std::unique_ptr<CDInstTupleIndex>& imt = d_c_inst_index[q];
+    if (imt == nullptr)
     {
-      imt = it->second;
+      imt.reset(new CDInstTupleIndex(d_qstate.getUserContext()));
     }
-    else
+    d_c_inst_index_dom.insert(q);
+    if (modEq && imt->existsModEq(d_qstate, terms))
     {
-      imt = new CDInstMatchTrie(d_qstate.getUserContext());
-      d_c_inst_match_trie[q] = imt;
+      return false;
     }
-    d_c_inst_match_trie_dom.insert(q);
-    return imt->addInstMatch(d_qstate, q, terms, modEq);
+    return imt->add(terms);
   }
-  Trace("inst-add-debug") << "Adding into inst trie" << std::endl;
-  return d_inst_match_trie[q].addInstMatch(d_qstate, q, terms, modEq);
+  Trace("inst-add-debug") << "Adding into inst index, modEq = " << modEq
+                          << std::endl;
+  InstTupleIndex& imt = d_inst_index[q];
+  if (modEq && imt.existsModEq(d_qstate, terms))
+  {
+    return false;
+  }
+  return imt.add(terms);
 }
 
 bool Instantiate::removeInstantiationInternal(Node q, std::vector<Node>& terms)
 {
   if (options::incrementalSolving())
   {
-    std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
-    if (it != d_c_inst_match_trie.end())
+    std::unordered_map<Node,
+                       std::unique_ptr<CDInstTupleIndex>,
+                       NodeHashFunction>::iterator it = d_c_inst_index.find(q);
+    if (it != d_c_inst_index.end())
     {
-      return it->second->removeInstMatch(q, terms);
+      return it->second->remove(terms);
     }
     return false;
   }
-  return d_inst_match_trie[q].removeInstMatch(q, terms);
+  std::unordered_map<Node, InstTupleIndex, NodeHashFunction>::iterator it =
+      d_inst_index.find(q);
+  if (it != d_inst_index.end())
+  {
+    return it->second.remove(terms);
+  }
+  return false;
 }
 
 void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs) const
@@ -618,20 +628,22 @@ void Instantiate::getInstantiationTermVectors(
 
   if (options::incrementalSolving())
   {
-    std::map<Node, CDInstMatchTrie*>::const_iterator it =
-        d_c_inst_match_trie.find(q);
-    if (it != d_c_inst_match_trie.end())
+    std::unordered_map<Node,
+                       std::unique_ptr<CDInstTupleIndex>,
+                       NodeHashFunction>::const_iterator it =
+        d_c_inst_index.find(q);
+    if (it != d_c_inst_index.end())
     {
-      it->second->getInstantiations(q, tvecs);
+      it->second->getInstantiations(tvecs);
     }
   }
   else
   {
-    std::map<Node, InstMatchTrie>::const_iterator it =
-        d_inst_match_trie.find(q);
-    if (it != d_inst_match_trie.end())
+    std::unordered_map<Node, InstTupleIndex, NodeHashFunction>::const_iterator
+        it = d_inst_index.find(q);
+    if (it != d_inst_index.end())
     {
-      it->second.getInstantiations(q, tvecs);
+      it->second.getInstantiations(tvecs);
     }
   }
 }
@@ -641,14 +653,14 @@ void Instantiate::getInstantiationTermVectors(
 {
   if (options::incrementalSolving())
   {
-    for (const auto& t : d_c_inst_match_trie)
+    for (const auto& t : d_c_inst_index)
     {
       getInstantiationTermVectors(t.first, insts[t.first]);
     }
   }
   else
   {
-    for (const auto& t : d_inst_match_trie)
+    for (const auto& t : d_inst_index)
     {
       getInstantiationTermVectors(t.first, insts[t.first]);
     }
@@ -19,12 +19,14 @@
 #define CVC5__THEORY__QUANTIFIERS__INSTANTIATE_H
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 
 #include "context/cdhashset.h"
 #include "expr/node.h"
 #include "expr/proof.h"
 #include "theory/inference_id.h"
-#include "theory/quantifiers/inst_match_trie.h"
+#include "theory/quantifiers/inst_tuple_index.h"
 #include "theory/quantifiers/quant_util.h"
 #include "util/statistics_stats.h"
 
@@ -82,9 +84,9 @@ class InstLemmaList
 /** Instantiate
  *
  * This class is used for generating instantiation lemmas.  It maintains an
- * instantiation trie, which is represented by a different data structure
- * depending on whether incremental solving is enabled (see d_inst_match_trie
- * and d_c_inst_match_trie).
+ * index of instantiations, which is represented by a different data structure
+ * depending on whether incremental solving is enabled (see d_inst_index
+ * and d_c_inst_index).
  *
  * Below, we say an instantiation lemma for q = forall x. F under substitution
  * { x -> t } is the formula:
@@ -344,15 +346,16 @@ class Instantiate : public QuantifiersUtil
   /** list of all instantiations produced for each quantifier
    *
    * We store context (dependent, independent) versions. If incremental solving
-   * is disabled, we use d_inst_match_trie for performance reasons.
+   * is disabled, we use d_inst_index for performance reasons.
    */
-  std::map<Node, InstMatchTrie> d_inst_match_trie;
-  std::map<Node, CDInstMatchTrie*> d_c_inst_match_trie;
+  std::unordered_map<Node, InstTupleIndex, NodeHashFunction> d_inst_index;
+  std::unordered_map<Node, std::unique_ptr<CDInstTupleIndex>, NodeHashFunction>
+      d_c_inst_index;
   /**
-   * The list of quantified formulas for which the domain of d_c_inst_match_trie
+   * The list of quantified formulas for which the domain of d_c_inst_index
    * is valid.
    */
-  context::CDHashSet<Node, NodeHashFunction> d_c_inst_match_trie_dom;
+  context::CDHashSet<Node, NodeHashFunction> d_c_inst_index_dom;
   /**
    * A CDProof storing instantiation steps.
    */
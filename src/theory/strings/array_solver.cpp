@@ -0,0 +1,177 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Array-style reasoning about sequence indexing and update.
+ */
+
+#include "theory/strings/array_solver.h"
+
+#include <unordered_set>
+
+#include "theory/strings/theory_strings_utils.h"
+
+using namespace cvc5::context;
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+ArraySolver::ArraySolver(SolverState& s,
+                         InferenceManager& im,
+                         BaseSolver& bs,
+                         CoreSolver& cs,
+                         ExtTheory& et)
+    : d_state(s),
+      d_im(im),
+      d_bsolver(bs),
+      d_csolver(cs),
+      d_extt(et),
+      d_lemmas(s.getUserContext())
+{
+  NodeManager* nm = NodeManager::currentNM();
+  d_zero = nm->mkConst(Rational(0));
+}
+
+void ArraySolver::checkArrayTerms()
+{
+  NodeManager* nm = NodeManager::currentNM();
+  // the update terms in each equivalence class
+  std::map<Node, std::vector<Node>> updates;
+  for (const Node& u : d_extt.getActive(STRING_UPDATE))
+  {
+    // the update does not change the length
+    Node lenu = nm->mkNode(STRING_LENGTH, u);
+    Node lens = nm->mkNode(STRING_LENGTH, u[0]);
+    if (!d_state.areEqual(lenu, lens))
+    {
+      std::vector<Node> exp;
+      sendLemma(
+          exp, lenu.eqNode(lens), InferenceId::STRINGS_ARRAY_UPDATE_LEN);
+    }
+    updates[d_state.getRepresentative(u)].push_back(u);
+  }
+  std::vector<Node> nths = d_extt.getActive(SEQ_NTH);
+  if (nths.empty())
+  {
+    return;
+  }
+  const std::vector<Node>& eqcs = d_bsolver.getStringEqc();
+  std::unordered_set<Node, NodeHashFunction> eqcSet(eqcs.begin(), eqcs.end());
+  for (const Node& t : nths)
+  {
+    if (d_state.isInConflict())
+    {
+      return;
+    }
+    Node r = d_state.getRepresentative(t[0]);
+    if (eqcSet.find(r) == eqcSet.end())
+    {
+      // the normal form of r was not computed
+      continue;
+    }
+    checkNth(t, updates);
+  }
+}
+
+void ArraySolver::checkNth(Node t,
+                           const std::map<Node, std::vector<Node>>& updates)
+{
+  Assert(t.getKind() == SEQ_NTH);
+  NodeManager* nm = NodeManager::currentNM();
+  Node s = t[0];
+  Node i = t[1];
+  Node r = d_state.getRepresentative(s);
+  Trace("seq-array-debug") << "Check " << t << std::endl;
+  NormalForm& nf = d_csolver.getNormalForm(r);
+  std::vector<Node> exp(nf.d_exp.begin(), nf.d_exp.end());
+  if (s != nf.d_base)
+  {
+    exp.push_back(s.eqNode(nf.d_base));
+  }
+  if (nf.d_nf.size() >= 2)
+  {
+    // split on whether i is an index of the first component
+    Node x = nf.d_nf[0];
+    std::vector<Node> rest(nf.d_nf.begin() + 1, nf.d_nf.end());
+    Node y = utils::mkConcat(rest, s.getType());
+    Node lenx = nm->mkNode(STRING_LENGTH, x);
+    Node lens = nm->mkNode(STRING_LENGTH, s);
+    Node inx =
+        nm->mkNode(AND, nm->mkNode(GEQ, i, d_zero), nm->mkNode(LT, i, lenx));
+    Node iny =
+        nm->mkNode(AND, nm->mkNode(GEQ, i, lenx), nm->mkNode(LT, i, lens));
+    Node nthx = nm->mkNode(SEQ_NTH, x, i);
+    Node nthy = nm->mkNode(SEQ_NTH, y, nm->mkNode(MINUS, i, lenx));
+    Node conc = nm->mkNode(AND,
+                           nm->mkNode(IMPLIES, inx, t.eqNode(nthx)),
+                           nm->mkNode(IMPLIES, iny, t.eqNode(nthy)));
+    sendLemma(exp, conc, InferenceId::STRINGS_ARRAY_NTH_CONCAT);
+  }
+  else if (nf.d_nf.size() == 1 && nf.d_nf[0].getKind() == SEQ_UNIT)
+  {
+    Node conc =
+        nm->mkNode(IMPLIES, i.eqNode(d_zero), t.eqNode(nf.d_nf[0][0]));
+    sendLemma(exp, conc, InferenceId::STRINGS_ARRAY_NTH_UNIT);
+  }
+  // read over the updates that are equal to s
+  std::map<Node, std::vector<Node>>::const_iterator it = updates.find(r);
+  if (it == updates.end())
+  {
+    return;
+  }
+  for (const Node& u : it->second)
+  {
+    std::vector<Node> uexp;
+    if (s != u)
+    {
+      uexp.push_back(s.eqNode(u));
+    }
+    Node j = u[1];
+    Node lens = nm->mkNode(STRING_LENGTH, u[0]);
+    Node lenr = nm->mkNode(STRING_LENGTH, u[2]);
+    Node inUpdate = nm->mkNode(AND,
+                               nm->mkNode(GEQ, j, d_zero),
+                               nm->mkNode(LEQ, j, i),
+                               nm->mkNode(LT, i, nm->mkNode(PLUS, j, lenr)),
+                               nm->mkNode(LT, i, lens));
+    Node inBounds =
+        nm->mkNode(AND, nm->mkNode(GEQ, i, d_zero), nm->mkNode(LT, i, lens));
+    Node nthr = nm->mkNode(SEQ_NTH, u[2], nm->mkNode(MINUS, i, j));
+    Node nths = nm->mkNode(SEQ_NTH, u[0], i);
+    Node conc = nm->mkNode(
+        AND,
+        nm->mkNode(IMPLIES, inUpdate, t.eqNode(nthr)),
+        nm->mkNode(IMPLIES,
+                   nm->mkNode(AND, inBounds, inUpdate.negate()),
+                   t.eqNode(nths)));
+    sendLemma(uexp, conc, InferenceId::STRINGS_ARRAY_NTH_UPDATE);
+  }
+}
+
+void ArraySolver::sendLemma(const std::vector<Node>& exp,
+                            Node conc,
+                            InferenceId id)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node lem = nm->mkNode(IMPLIES, utils::mkAnd(exp), conc);
+  if (d_lemmas.find(lem) != d_lemmas.end())
+  {
+    return;
+  }
+  d_lemmas.insert(lem);
+  Trace("seq-array") << "ArraySolver: " << id << " : " << lem << std::endl;
+  d_im.sendInference(exp, conc, id, false, true);
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Array-style reasoning about sequence indexing and update.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__STRINGS__ARRAY_SOLVER_H
+#define CVC5__THEORY__STRINGS__ARRAY_SOLVER_H
+
+#include <map>
+#include <vector>
+
+#include "context/cdhashset.h"
+#include "expr/node.h"
+#include "theory/ext_theory.h"
+#include "theory/strings/base_solver.h"
+#include "theory/strings/core_solver.h"
+#include "theory/strings/inference_manager.h"
+#include "theory/strings/solver_state.h"
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+/**
+ * Reasons about applications of seq.nth and seq.update like an array solver
+ * reasons about reads and writes, where the length of the sequence bounds the
+ * indices. For each term (seq.nth s i) in the current context, it sends the
+ * following lemmas:
+ *
+ * - if s = unit(e) by its normal form:
+ *     i = 0 => (seq.nth s i) = e
+ * - if s = x ++ y by its normal form, where x is the first component:
+ *     0 <= i < len(x) => (seq.nth s i) = (seq.nth x i)
+ *     len(x) <= i < len(s) => (seq.nth s i) = (seq.nth y (i - len(x)))
+ * - if s = (seq.update s' j t):
+ *     0 <= j <= i < j + len(t) ^ i < len(s) =>
+ *       (seq.nth s i) = (seq.nth t (i - j))
+ *     0 <= i < len(s) ^ ~(0 <= j <= i < j + len(t)) =>
+ *       (seq.nth s i) = (seq.nth s' i)
+ *
+ * and for each term (seq.update s j t), that its length is len(s).
+ *
+ * These lemmas do not introduce word equations. When this solver is enabled,
+ * the reductions of seq.nth and seq.update, which introduce word equations,
+ * are only sent once no other inference applies (see
+ * ExtfSolver::doReduction).
+ */
+class ArraySolver
+{
+  typedef context::CDHashSet<Node, NodeHashFunction> NodeSet;
+
+ public:
+  ArraySolver(SolverState& s,
+              InferenceManager& im,
+              BaseSolver& bs,
+              CoreSolver& cs,
+              ExtTheory& et);
+  ~ArraySolver() {}
+
+  /**
+   * Send the lemmas above for the seq.nth and seq.update terms of the current
+   * context. This requires that the normal forms of all equivalence classes
+   * were computed.
+   */
+  void checkArrayTerms();
+
+ private:
+  /** Send the lemmas for (seq.nth s i), see the class comment */
+  void checkNth(Node t, const std::map<Node, std::vector<Node>>& updates);
+  /**
+   * Send the lemma (exp => conc) if it was not sent before in the current
+   * user context.
+   */
+  void sendLemma(const std::vector<Node>& exp, Node conc, InferenceId id);
+
+  /** The solver state object */
+  SolverState& d_state;
+  /** The (custom) output channel of the theory of strings */
+  InferenceManager& d_im;
+  /** reference to the base solver, used for the equivalence classes */
+  BaseSolver& d_bsolver;
+  /** reference to the core solver, used for the normal forms */
+  CoreSolver& d_csolver;
+  /** the extended theory object for the theory of strings */
+  ExtTheory& d_extt;
+  /** The lemmas sent by this solver */
+  NodeSet d_lemmas;
+  /** Common constants */
+  Node d_zero;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__STRINGS__ARRAY_SOLVER_H */
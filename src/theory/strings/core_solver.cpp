@@ -42,6 +42,9 @@ CoreSolver::CoreSolver(SolverState& s,
       d_im(im),
       d_termReg(tr),
       d_bsolver(bs),
+      d_nfVersionCount(0),
+      d_nfCacheEpochCount(0),
+      d_nfCacheEpoch(s.getSatContext(), 0),
       d_nfPairs(s.getSatContext())
 {
   d_zero = NodeManager::currentNM()->mkConst( Rational( 0 ) );
@@ -541,6 +544,14 @@ void CoreSolver::checkNormalFormsEq()
   // calculate normal forms for each equivalence class, possibly adding
   // splitting lemmas
   d_normal_form.clear();
+  d_nfVersion.clear();
+  if (d_nfCacheEpoch.get() != d_nfCacheEpochCount)
+  {
+    // we backtracked since the cache was last filled
+    d_nfCache.clear();
+  }
+  d_nfCacheEpochCount++;
+  d_nfCacheEpoch = d_nfCacheEpochCount;
   std::map<Node, Node> nf_to_eqc;
   std::map<Node, Node> eqc_to_nf;
   std::map<Node, Node> eqc_to_exp;
@@ -618,11 +629,20 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
     //do nothing
     Trace("strings-process-debug") << "Return process equivalence class " << eqc << " : empty." << std::endl;
     d_normal_form[eqc].init(emp);
+    // the normal form of the empty class does not depend on anything else
+    d_nfVersion[eqc] = 0;
   }
   else
   {
     // should not have computed the normal form of this equivalence class yet
     Assert(d_normal_form.find(eqc) == d_normal_form.end());
+    if (options::stringNfCache() && getCachedNormalForm(eqc))
+    {
+      Trace("strings-process-debug")
+          << "Return process equivalence class " << eqc
+          << " : cached = " << d_normal_form[eqc].d_nf << std::endl;
+      return;
+    }
     // Normal forms for the relevant terms in the equivalence class of eqc
     std::vector<NormalForm> normal_forms;
     // map each term to its index in the above vector
@@ -652,12 +672,101 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc, TypeNode stype)
       nf_index = it->second;
     }
     d_normal_form[eqc] = normal_forms[nf_index];
+    if (options::stringNfCache())
+    {
+      cacheNormalForm(eqc, normal_forms);
+    }
     Trace("strings-process-debug")
         << "Return process equivalence class " << eqc
         << " : returned = " << d_normal_form[eqc].d_nf << std::endl;
   }
 }
 
+bool CoreSolver::getCachedNormalForm(Node eqc)
+{
+  std::map<Node, NormalFormCacheEntry>::iterator it = d_nfCache.find(eqc);
+  if (it == d_nfCache.end())
+  {
+    return false;
+  }
+  eq::EqualityEngine* ee = d_state.getEqualityEngine();
+  NormalFormCacheEntry& ce = it->second;
+  if (ee->getModificationTime(eqc) != ce.d_time)
+  {
+    return false;
+  }
+  // the arguments determine which terms of the class are congruent
+  for (const std::pair<Node, uint64_t>& at : ce.d_argTimes)
+  {
+    if (ee->getModificationTime(at.first) != at.second)
+    {
+      return false;
+    }
+  }
+  for (const std::pair<Node, uint64_t>& nv : ce.d_nfVersions)
+  {
+    std::map<Node, uint64_t>::iterator itv = d_nfVersion.find(nv.first);
+    if (itv == d_nfVersion.end() || itv->second != nv.second)
+    {
+      return false;
+    }
+  }
+  d_normal_form[eqc] = ce.d_nf;
+  d_nfVersion[eqc] = ce.d_version;
+  return true;
+}
+
+void CoreSolver::cacheNormalForm(Node eqc,
+                                 const std::vector<NormalForm>& normal_forms)
+{
+  NormalForm& nf = d_normal_form[eqc];
+  for (const NormalForm& nfo : normal_forms)
+  {
+    if (nfo.d_nf != nf.d_nf)
+    {
+      d_nfCache.erase(eqc);
+      d_nfVersion[eqc] = ++d_nfVersionCount;
+      return;
+    }
+  }
+  eq::EqualityEngine* ee = d_state.getEqualityEngine();
+  NormalFormCacheEntry& ce = d_nfCache[eqc];
+  ce.d_time = ee->getModificationTime(eqc);
+  ce.d_version = ++d_nfVersionCount;
+  ce.d_argTimes.clear();
+  ce.d_nfVersions.clear();
+  ce.d_nf = nf;
+  eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, ee);
+  while (!eqc_i.isFinished())
+  {
+    Node n = *eqc_i;
+    bool isConcat = n.getKind() == STRING_CONCAT;
+    for (const Node& nc : n)
+    {
+      if (!ee->hasTerm(nc))
+      {
+        continue;
+      }
+      ce.d_argTimes.emplace_back(nc, ee->getModificationTime(nc));
+      if (isConcat)
+      {
+        Node ncr = ee->getRepresentative(nc);
+        std::map<Node, uint64_t>::iterator itv = d_nfVersion.find(ncr);
+        if (itv == d_nfVersion.end())
+        {
+          // a component of a congruent term that was not normalized yet
+          d_nfCache.erase(eqc);
+          d_nfVersion[eqc] = ++d_nfVersionCount;
+          return;
+        }
+        ce.d_nfVersions.emplace_back(ncr, itv->second);
+      }
+    }
+    ++eqc_i;
+  }
+  d_nfVersion[eqc] = ce.d_version;
+}
+
 NormalForm& CoreSolver::getNormalForm(Node n)
 {
   std::map<Node, NormalForm>::iterator itn = d_normal_form.find(n);
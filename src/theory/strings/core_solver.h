@@ -21,6 +21,7 @@
 
 #include "context/cdhashset.h"
 #include "context/cdlist.h"
+#include "context/cdo.h"
 #include "theory/strings/base_solver.h"
 #include "theory/strings/infer_info.h"
 #include "theory/strings/inference_manager.h"
@@ -334,6 +335,22 @@ class CoreSolver
                       std::vector<NormalForm>& normal_forms,
                       std::map<Node, unsigned>& term_to_nf_index,
                       TypeNode stype);
+  /**
+   * If the normal form of eqc computed in a previous call to
+   * checkNormalFormsEq is still valid, store it in d_normal_form and return
+   * true. It is valid if the equivalence class of eqc, the classes of the
+   * arguments of its terms and the normal forms of the components of its
+   * concatenation terms have not changed since then.
+   */
+  bool getCachedNormalForm(Node eqc);
+  /**
+   * Cache the normal form of eqc, which was computed from normal_forms
+   * without any inferences, for use in later calls to checkNormalFormsEq.
+   * The normal form is only cached if all normal_forms are identical, since
+   * otherwise it depends on the normal form pairs and the lengths in the
+   * current context.
+   */
+  void cacheNormalForm(Node eqc, const std::vector<NormalForm>& normal_forms);
   /** process normalize equivalence class
    *
    * This is called when an equivalence class eqc contains a set of terms that
@@ -492,6 +509,40 @@ class CoreSolver
   std::vector<Node> d_strings_eqc;
   /** map from terms to their normal forms */
   std::map<Node, NormalForm> d_normal_form;
+  /** A normal form computed in a previous call to checkNormalFormsEq */
+  struct NormalFormCacheEntry
+  {
+    /** The modification time of the equivalence class */
+    uint64_t d_time;
+    /** The version of the normal form, unique among all versions */
+    uint64_t d_version;
+    /** The arguments of the terms of the class and their modification times */
+    std::vector<std::pair<Node, uint64_t>> d_argTimes;
+    /** The components of concatenations and their normal form versions */
+    std::vector<std::pair<Node, uint64_t>> d_nfVersions;
+    /** The normal form */
+    NormalForm d_nf;
+  };
+  /**
+   * Map from equivalence classes to their cached normal forms, which is only
+   * used if options::stringNfCache() is true. Since the modification times of
+   * the equality engine are not restored on backtracking, this map is cleared
+   * whenever we backtracked since the last call to checkNormalFormsEq, which
+   * is detected via d_nfCacheEpoch.
+   */
+  std::map<Node, NormalFormCacheEntry> d_nfCache;
+  /** The version of the normal form of each eqc in d_normal_form */
+  std::map<Node, uint64_t> d_nfVersion;
+  /** The number of normal form versions */
+  uint64_t d_nfVersionCount;
+  /** The number of calls to checkNormalFormsEq */
+  uint64_t d_nfCacheEpochCount;
+  /**
+   * The value of d_nfCacheEpochCount at the last call to checkNormalFormsEq
+   * in the current context, which differs from d_nfCacheEpochCount after
+   * backtracking.
+   */
+  context::CDO<uint64_t> d_nfCacheEpoch;
   /**
    * In certain cases, we know that two terms are equivalent despite
    * not having to verify their normal forms are identical. For example,
@@ -153,6 +153,11 @@ bool ExtfSolver::doReduction(int effort, Node n)
     // never necessary to reduce seq.unit
     return false;
   }
+  else if ((k == SEQ_NTH || k == STRING_UPDATE) && options::seqArray())
+  {
+    // handled by the array solver, reduce only as a last resort
+    r_effort = 3;
+  }
   else if (k != STRING_IN_REGEXP)
   {
     r_effort = 2;
@@ -0,0 +1,521 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Automata for constant regular expressions.
+ */
+
+#include "theory/strings/regexp_automaton.h"
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <unordered_set>
+
+#include "theory/strings/regexp_entail.h"
+#include "theory/strings/theory_strings_utils.h"
+
+using namespace cvc5::kind;
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+namespace {
+/** The maximal number of nondeterministic states of an automaton */
+const size_t s_maxStates = 10000;
+/** The maximal number of product states explored by checkEmpty */
+const size_t s_maxProductStates = 10000;
+}  // namespace
+
+RegExpAutomaton::RegExpAutomaton(Node r)
+    : d_compiled(true), d_numStates(0), d_root(0)
+{
+  Assert(r.getType().isRegExp());
+  d_root = compileFormula(r);
+  Trace("re-automaton") << "Compile " << r << ": "
+                        << (d_compiled ? "success" : "fail") << ", "
+                        << d_leaves.size() << " leaves, " << d_numStates
+                        << " states" << std::endl;
+}
+
+size_t RegExpAutomaton::compileFormula(Node r)
+{
+  Formula f;
+  Kind k = r.getKind();
+  if (k == REGEXP_INTER || k == REGEXP_DIFF
+      || (k == REGEXP_UNION && hasBooleanStructure(r)))
+  {
+    f.d_kind = k == REGEXP_UNION ? Formula::OR : Formula::AND;
+    for (const Node& rc : r)
+    {
+      f.d_children.push_back(compileFormula(rc));
+    }
+    if (k == REGEXP_DIFF)
+    {
+      // r1 \ r2 is r1 /\ ~r2
+      Formula fn;
+      fn.d_kind = Formula::NOT;
+      fn.d_children.push_back(f.d_children[1]);
+      d_formulas.push_back(fn);
+      f.d_children[1] = d_formulas.size() - 1;
+    }
+  }
+  else if (k == REGEXP_COMPLEMENT)
+  {
+    f.d_kind = Formula::NOT;
+    f.d_children.push_back(compileFormula(r[0]));
+  }
+  else
+  {
+    f.d_kind = Formula::LEAF;
+    f.d_leaf = d_leaves.size();
+    d_leaves.emplace_back();
+    if (hasBooleanStructure(r))
+    {
+      Trace("re-automaton") << "...unsupported Boolean structure in " << r
+                            << std::endl;
+      d_compiled = false;
+    }
+    else
+    {
+      Leaf& l = d_leaves.back();
+      if (!compileLeaf(l, r, l.d_start, l.d_final))
+      {
+        d_compiled = false;
+      }
+      else
+      {
+        // the dead state, i.e. the empty set of states, is state 0
+        std::vector<uint32_t> dead;
+        getDState(l, dead);
+      }
+    }
+  }
+  d_formulas.push_back(f);
+  return d_formulas.size() - 1;
+}
+
+bool RegExpAutomaton::hasBooleanStructure(TNode r)
+{
+  std::unordered_set<TNode, TNodeHashFunction> visited;
+  std::vector<TNode> visit;
+  visit.push_back(r);
+  do
+  {
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (visited.find(cur) == visited.end())
+    {
+      visited.insert(cur);
+      Kind k = cur.getKind();
+      if (k == REGEXP_INTER || k == REGEXP_DIFF || k == REGEXP_COMPLEMENT)
+      {
+        return true;
+      }
+      if (cur.getType().isRegExp())
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+      }
+    }
+  } while (!visit.empty());
+  return false;
+}
+
+uint32_t RegExpAutomaton::newState(Leaf& l)
+{
+  d_numStates++;
+  l.d_eps.emplace_back();
+  l.d_trans.emplace_back();
+  return l.d_eps.size() - 1;
+}
+
+bool RegExpAutomaton::compileLeaf(Leaf& l,
+                                  TNode r,
+                                  uint32_t& start,
+                                  uint32_t& final)
+{
+  if (d_numStates > s_maxStates)
+  {
+    Trace("re-automaton") << "...too many states" << std::endl;
+    return false;
+  }
+  Kind k = r.getKind();
+  switch (k)
+  {
+    case STRING_TO_REGEXP:
+    {
+      if (!r[0].isConst())
+      {
+        return false;
+      }
+      start = newState(l);
+      final = start;
+      for (unsigned c : r[0].getConst<String>().getVec())
+      {
+        uint32_t next = newState(l);
+        l.d_trans[final].push_back({c, c, next});
+        final = next;
+      }
+      return true;
+    }
+    case REGEXP_SIGMA:
+    case REGEXP_RANGE:
+    {
+      uint32_t lo = 0;
+      uint32_t hi = String::num_codes() - 1;
+      if (k == REGEXP_RANGE)
+      {
+        for (size_t i = 0; i < 2; i++)
+        {
+          if (!r[i].isConst() || r[i].getConst<String>().size() != 1)
+          {
+            return false;
+          }
+        }
+        lo = r[0].getConst<String>().front();
+        hi = r[1].getConst<String>().front();
+      }
+      start = newState(l);
+      final = newState(l);
+      if (lo <= hi)
+      {
+        l.d_trans[start].push_back({lo, hi, final});
+      }
+      return true;
+    }
+    case REGEXP_EMPTY:
+    {
+      start = newState(l);
+      final = newState(l);
+      return true;
+    }
+    case REGEXP_CONCAT:
+    case REGEXP_REPEAT:
+    case REGEXP_LOOP:
+    {
+      // the number of mandatory and optional copies of the children
+      size_t min = 1;
+      size_t max = 1;
+      if (k == REGEXP_REPEAT)
+      {
+        min = utils::getRepeatAmount(r);
+        max = min;
+      }
+      else if (k == REGEXP_LOOP)
+      {
+        min = utils::getLoopMinOccurrences(r);
+        max = utils::getLoopMaxOccurrences(r);
+        if (max < min)
+        {
+          return false;
+        }
+      }
+      start = newState(l);
+      final = start;
+      for (size_t i = 0; i < max; i++)
+      {
+        uint32_t copyStart = final;
+        for (const Node& rc : r)
+        {
+          uint32_t cs, cf;
+          if (!compileLeaf(l, rc, cs, cf))
+          {
+            return false;
+          }
+          l.d_eps[final].push_back(cs);
+          final = cf;
+        }
+        if (i >= min)
+        {
+          // optional copy
+          l.d_eps[copyStart].push_back(final);
+        }
+      }
+      return true;
+    }
+    case REGEXP_UNION:
+    {
+      start = newState(l);
+      final = newState(l);
+      for (const Node& rc : r)
+      {
+        uint32_t cs, cf;
+        if (!compileLeaf(l, rc, cs, cf))
+        {
+          return false;
+        }
+        l.d_eps[start].push_back(cs);
+        l.d_eps[cf].push_back(final);
+      }
+      return true;
+    }
+    case REGEXP_STAR:
+    case REGEXP_PLUS:
+    case REGEXP_OPT:
+    {
+      uint32_t cs, cf;
+      start = newState(l);
+      if (!compileLeaf(l, r[0], cs, cf))
+      {
+        return false;
+      }
+      final = newState(l);
+      l.d_eps[start].push_back(cs);
+      l.d_eps[cf].push_back(final);
+      if (k != REGEXP_PLUS)
+      {
+        l.d_eps[start].push_back(final);
+      }
+      if (k != REGEXP_OPT)
+      {
+        l.d_eps[cf].push_back(cs);
+      }
+      return true;
+    }
+    default:
+    {
+      // variables, REGEXP_RV
+      Trace("re-automaton") << "...unsupported " << r << std::endl;
+      return false;
+    }
+  }
+}
+
+uint32_t RegExpAutomaton::getDState(Leaf& l, std::vector<uint32_t>& states)
+{
+  // compute the epsilon closure
+  std::vector<bool> inSet(l.d_eps.size(), false);
+  std::vector<uint32_t> visit;
+  for (uint32_t s : states)
+  {
+    if (!inSet[s])
+    {
+      inSet[s] = true;
+      visit.push_back(s);
+    }
+  }
+  states.clear();
+  while (!visit.empty())
+  {
+    uint32_t s = visit.back();
+    visit.pop_back();
+    states.push_back(s);
+    for (uint32_t t : l.d_eps[s])
+    {
+      if (!inSet[t])
+      {
+        inSet[t] = true;
+        visit.push_back(t);
+      }
+    }
+  }
+  std::sort(states.begin(), states.end());
+  std::map<std::vector<uint32_t>, uint32_t>::iterator it =
+      l.d_dstateIds.find(states);
+  if (it != l.d_dstateIds.end())
+  {
+    return it->second;
+  }
+  uint32_t id = l.d_dstates.size();
+  l.d_dstateIds[states] = id;
+  l.d_dstates.push_back(states);
+  l.d_dtrans.emplace_back();
+  l.d_dfinal.push_back(inSet[l.d_final]);
+  return id;
+}
+
+const std::vector<RegExpAutomaton::Transition>&
+RegExpAutomaton::getDTransitions(Leaf& l, uint32_t s)
+{
+  if (!l.d_dtrans[s].empty())
+  {
+    return l.d_dtrans[s];
+  }
+  // the boundaries of the ranges that partition the alphabet
+  std::vector<uint32_t> bounds;
+  bounds.push_back(0);
+  bounds.push_back(String::num_codes());
+  for (uint32_t ns : l.d_dstates[s])
+  {
+    for (const Transition& t : l.d_trans[ns])
+    {
+      bounds.push_back(t.d_lo);
+      bounds.push_back(t.d_hi + 1);
+    }
+  }
+  std::sort(bounds.begin(), bounds.end());
+  bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+  std::vector<Transition> dtrans;
+  for (size_t i = 0, nbounds = bounds.size(); i + 1 < nbounds; i++)
+  {
+    std::vector<uint32_t> targets;
+    for (uint32_t ns : l.d_dstates[s])
+    {
+      for (const Transition& t : l.d_trans[ns])
+      {
+        if (t.d_lo <= bounds[i] && bounds[i] <= t.d_hi)
+        {
+          targets.push_back(t.d_target);
+        }
+      }
+    }
+    uint32_t target = getDState(l, targets);
+    if (!dtrans.empty() && dtrans.back().d_target == target)
+    {
+      dtrans.back().d_hi = bounds[i + 1] - 1;
+    }
+    else
+    {
+      dtrans.push_back({bounds[i], bounds[i + 1] - 1, target});
+    }
+  }
+  // getDState may have resized d_dtrans, so we assign it only now
+  l.d_dtrans[s] = dtrans;
+  return l.d_dtrans[s];
+}
+
+uint32_t RegExpAutomaton::step(Leaf& l, uint32_t s, uint32_t c)
+{
+  const std::vector<Transition>& trans = getDTransitions(l, s);
+  // find the first range whose upper bound is at least c
+  std::vector<Transition>::const_iterator it = std::lower_bound(
+      trans.begin(), trans.end(), c, [](const Transition& t, uint32_t cc) {
+        return t.d_hi < cc;
+      });
+  Assert(it != trans.end() && it->d_lo <= c);
+  return it->d_target;
+}
+
+bool RegExpAutomaton::evaluate(size_t f,
+                               const std::vector<uint32_t>& states) const
+{
+  const Formula& form = d_formulas[f];
+  switch (form.d_kind)
+  {
+    case Formula::LEAF:
+      return d_leaves[form.d_leaf].d_dfinal[states[form.d_leaf]];
+    case Formula::NOT: return !evaluate(form.d_children[0], states);
+    case Formula::AND:
+      for (size_t c : form.d_children)
+      {
+        if (!evaluate(c, states))
+        {
+          return false;
+        }
+      }
+      return true;
+    case Formula::OR:
+      for (size_t c : form.d_children)
+      {
+        if (evaluate(c, states))
+        {
+          return true;
+        }
+      }
+      return false;
+  }
+  return false;
+}
+
+bool RegExpAutomaton::accepts(const String& s)
+{
+  Assert(d_compiled);
+  std::vector<uint32_t> states;
+  for (Leaf& l : d_leaves)
+  {
+    std::vector<uint32_t> start;
+    start.push_back(l.d_start);
+    states.push_back(getDState(l, start));
+  }
+  for (unsigned c : s.getVec())
+  {
+    for (size_t i = 0, nleaves = d_leaves.size(); i < nleaves; i++)
+    {
+      states[i] = step(d_leaves[i], states[i], c);
+    }
+  }
+  return evaluate(d_root, states);
+}
+
+bool RegExpAutomaton::checkEmpty(bool& isEmpty)
+{
+  Assert(d_compiled);
+  // breadth-first search of the product of the deterministic automata for an
+  // accepting state
+  std::vector<uint32_t> init;
+  for (Leaf& l : d_leaves)
+  {
+    std::vector<uint32_t> start;
+    start.push_back(l.d_start);
+    init.push_back(getDState(l, start));
+  }
+  std::set<std::vector<uint32_t>> visited;
+  std::deque<std::vector<uint32_t>> visit;
+  visited.insert(init);
+  visit.push_back(init);
+  while (!visit.empty())
+  {
+    std::vector<uint32_t> cur = visit.front();
+    visit.pop_front();
+    if (evaluate(d_root, cur))
+    {
+      isEmpty = false;
+      return true;
+    }
+    // the characters on which some automaton changes its transition
+    std::vector<uint32_t> bounds;
+    for (size_t i = 0, nleaves = d_leaves.size(); i < nleaves; i++)
+    {
+      for (const Transition& t : getDTransitions(d_leaves[i], cur[i]))
+      {
+        bounds.push_back(t.d_lo);
+      }
+    }
+    std::sort(bounds.begin(), bounds.end());
+    bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+    for (uint32_t c : bounds)
+    {
+      std::vector<uint32_t> next;
+      for (size_t i = 0, nleaves = d_leaves.size(); i < nleaves; i++)
+      {
+        next.push_back(step(d_leaves[i], cur[i], c));
+      }
+      if (visited.insert(next).second)
+      {
+        if (visited.size() > s_maxProductStates)
+        {
+          Trace("re-automaton") << "...too many product states" << std::endl;
+          return false;
+        }
+        visit.push_back(next);
+      }
+    }
+  }
+  isEmpty = true;
+  return true;
+}
+
+bool RegExpAutomaton::checkIncludes(Node r1, Node r2, bool& includes)
+{
+  if (!RegExpEntail::isConstRegExp(r1) || !RegExpEntail::isConstRegExp(r2))
+  {
+    return false;
+  }
+  // r1 includes r2 iff r2 /\ ~r1 is empty
+  NodeManager* nm = NodeManager::currentNM();
+  Node diff = nm->mkNode(REGEXP_INTER, r2, nm->mkNode(REGEXP_COMPLEMENT, r1));
+  RegExpAutomaton a(diff);
+  return a.isCompiled() && a.checkEmpty(includes);
+}
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
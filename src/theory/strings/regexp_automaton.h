@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Automata for constant regular expressions.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__STRINGS__REGEXP_AUTOMATON_H
+#define CVC5__THEORY__STRINGS__REGEXP_AUTOMATON_H
+
+#include <map>
+#include <vector>
+
+#include "expr/node.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace theory {
+namespace strings {
+
+/**
+ * An automaton for a constant regular expression r.
+ *
+ * The intersections, complements and differences at the top of r form a
+ * Boolean combination of the remaining subexpressions, each of which is
+ * compiled into a nondeterministic automaton whose transitions are labeled
+ * with character ranges (Thompson's construction). These automata are
+ * determinized lazily by the subset construction: a deterministic state is
+ * only created when it is reached, and its transitions are computed on the
+ * first step out of it, as ranges that partition the alphabet.
+ *
+ * Membership of constant strings takes time linear in the length of the
+ * string, in contrast to the backtracking of
+ * RegExpEntail::testConstStringInRegExp. Emptiness (and hence inclusion, via
+ * the emptiness of r2 /\ ~r1) is decided by exploring the product of the
+ * deterministic automata, up to a bound on the number of product states.
+ *
+ * Regular expressions with intersections or complements below a
+ * concatenation, star, union or loop are not supported, nor are expressions
+ * whose nondeterministic automata exceed a size bound.
+ */
+class RegExpAutomaton
+{
+ public:
+  /** Compile r, which must be a constant regular expression. */
+  RegExpAutomaton(Node r);
+  /** Returns true if r could be compiled. */
+  bool isCompiled() const { return d_compiled; }
+  /** Returns true if s is in the language of r. Requires isCompiled(). */
+  bool accepts(const String& s);
+  /**
+   * Check whether the language of r is empty. Returns false if this could
+   * not be decided within the bound on the number of states explored,
+   * otherwise returns true and sets isEmpty. Requires isCompiled().
+   */
+  bool checkEmpty(bool& isEmpty);
+  /**
+   * Check whether the language of r1 includes the language of r2, where
+   * both are constant regular expressions. Returns false if this could not
+   * be decided, otherwise returns true and sets includes.
+   */
+  static bool checkIncludes(Node r1, Node r2, bool& includes);
+
+ private:
+  /** A transition on the characters lo...hi */
+  struct Transition
+  {
+    uint32_t d_lo;
+    uint32_t d_hi;
+    uint32_t d_target;
+  };
+  /** A lazily determinized automaton for a subexpression of r */
+  struct Leaf
+  {
+    /** The epsilon transitions of the nondeterministic states */
+    std::vector<std::vector<uint32_t>> d_eps;
+    /** The character transitions of the nondeterministic states */
+    std::vector<std::vector<Transition>> d_trans;
+    uint32_t d_start;
+    uint32_t d_final;
+    /** The sets of nondeterministic states of the deterministic states */
+    std::vector<std::vector<uint32_t>> d_dstates;
+    std::map<std::vector<uint32_t>, uint32_t> d_dstateIds;
+    /**
+     * The transitions of the deterministic states, ordered by character and
+     * covering the alphabet, computed on the first step out of the state.
+     */
+    std::vector<std::vector<Transition>> d_dtrans;
+    std::vector<bool> d_dfinal;
+  };
+  /** A node of the Boolean combination of the leaves */
+  struct Formula
+  {
+    enum
+    {
+      LEAF,
+      AND,
+      OR,
+      NOT
+    } d_kind;
+    /** The leaf, for LEAF */
+    size_t d_leaf;
+    /** The children, for the others */
+    std::vector<size_t> d_children;
+  };
+  /** Compile the Boolean structure of r, returns the formula index */
+  size_t compileFormula(Node r);
+  /** Returns true if r contains intersections or complements */
+  static bool hasBooleanStructure(TNode r);
+  /** Add a nondeterministic state to leaf l */
+  uint32_t newState(Leaf& l);
+  /**
+   * Compile r into leaf l, returns false if unsupported. Sets start and final
+   * to the states of the fragment for r.
+   */
+  bool compileLeaf(Leaf& l, TNode r, uint32_t& start, uint32_t& final);
+  /** Get the deterministic state for a set of nondeterministic states */
+  uint32_t getDState(Leaf& l, std::vector<uint32_t>& states);
+  /** Get the transitions of deterministic state s of leaf l */
+  const std::vector<Transition>& getDTransitions(Leaf& l, uint32_t s);
+  /** Step from deterministic state s of leaf l on character c */
+  uint32_t step(Leaf& l, uint32_t s, uint32_t c);
+  /** Evaluate formula f, given the deterministic state of each leaf */
+  bool evaluate(size_t f, const std::vector<uint32_t>& states) const;
+
+  /** Whether the compilation succeeded */
+  bool d_compiled;
+  /** The total number of nondeterministic states */
+  size_t d_numStates;
+  std::vector<Leaf> d_leaves;
+  std::vector<Formula> d_formulas;
+  /** The top-level formula */
+  size_t d_root;
+};
+
+}  // namespace strings
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__STRINGS__REGEXP_AUTOMATON_H */
@@ -760,6 +760,257 @@ bool RegExpEntail::regExpIncludes(Node r1, Node r2)
   return result;
 }
 
+RegExpEntail::LengthAbs::LengthAbs()
+    : d_empty(false), d_min(0), d_hasMax(false), d_max(0), d_mod(1), d_rem(0)
+{
+}
+
+RegExpEntail::LengthAbs RegExpEntail::LengthAbs::mkExact(const Integer& l)
+{
+  LengthAbs ret;
+  ret.d_mod = Integer(0);
+  ret.d_rem = l;
+  ret.normalize();
+  return ret;
+}
+
+RegExpEntail::LengthAbs RegExpEntail::LengthAbs::mkEmpty()
+{
+  LengthAbs ret;
+  ret.d_empty = true;
+  return ret;
+}
+
+void RegExpEntail::LengthAbs::normalize()
+{
+  if (d_empty)
+  {
+    return;
+  }
+  if (d_mod.isZero())
+  {
+    // a single length, which must be within the bounds
+    if (d_rem < d_min || (d_hasMax && d_rem > d_max))
+    {
+      d_empty = true;
+      return;
+    }
+    d_min = d_rem;
+    d_hasMax = true;
+    d_max = d_rem;
+    return;
+  }
+  d_rem = d_rem.euclidianDivideRemainder(d_mod);
+  if (d_hasMax && d_min > d_max)
+  {
+    d_empty = true;
+  }
+}
+
+RegExpEntail::LengthAbs RegExpEntail::concatLengthAbs(const LengthAbs& a,
+                                                      const LengthAbs& b)
+{
+  if (a.d_empty || b.d_empty)
+  {
+    return LengthAbs::mkEmpty();
+  }
+  LengthAbs ret;
+  ret.d_min = a.d_min + b.d_min;
+  ret.d_hasMax = a.d_hasMax && b.d_hasMax;
+  if (ret.d_hasMax)
+  {
+    ret.d_max = a.d_max + b.d_max;
+  }
+  ret.d_mod = a.d_mod.gcd(b.d_mod);
+  ret.d_rem = a.d_rem + b.d_rem;
+  ret.normalize();
+  return ret;
+}
+
+RegExpEntail::LengthAbs RegExpEntail::unionLengthAbs(const LengthAbs& a,
+                                                     const LengthAbs& b)
+{
+  if (a.d_empty)
+  {
+    return b;
+  }
+  else if (b.d_empty)
+  {
+    return a;
+  }
+  LengthAbs ret;
+  ret.d_min = a.d_min < b.d_min ? a.d_min : b.d_min;
+  ret.d_hasMax = a.d_hasMax && b.d_hasMax;
+  if (ret.d_hasMax)
+  {
+    ret.d_max = a.d_max > b.d_max ? a.d_max : b.d_max;
+  }
+  ret.d_mod = a.d_mod.gcd(b.d_mod).gcd((a.d_rem - b.d_rem).abs());
+  ret.d_rem = a.d_rem;
+  ret.normalize();
+  return ret;
+}
+
+RegExpEntail::LengthAbs RegExpEntail::loopLengthAbs(const LengthAbs& a,
+                                                    const Integer& lo,
+                                                    bool hasHi,
+                                                    const Integer& hi)
+{
+  if (a.d_empty || (hasHi && hi.isZero()))
+  {
+    return lo.isZero() ? LengthAbs::mkExact(Integer(0)) : LengthAbs::mkEmpty();
+  }
+  LengthAbs ret;
+  ret.d_min = lo * a.d_min;
+  ret.d_hasMax = hasHi && a.d_hasMax;
+  if (ret.d_hasMax)
+  {
+    ret.d_max = hi * a.d_max;
+  }
+  else if (a.d_hasMax && a.d_max.isZero())
+  {
+    // any number of copies of the empty word
+    ret.d_hasMax = true;
+  }
+  if (hasHi && lo == hi)
+  {
+    ret.d_mod = a.d_mod;
+  }
+  else
+  {
+    // k copies have lengths k*rem modulo mod, for all k in [lo, hi]
+    ret.d_mod = a.d_mod.gcd(a.d_rem);
+  }
+  ret.d_rem = lo * a.d_rem;
+  ret.normalize();
+  return ret;
+}
+
+RegExpEntail::LengthAbs RegExpEntail::computeLengthAbs(Node n)
+{
+  Kind k = n.getKind();
+  switch (k)
+  {
+    case STRING_TO_REGEXP:
+    {
+      if (n[0].isConst())
+      {
+        return LengthAbs::mkExact(Integer(Word::getLength(n[0])));
+      }
+      break;
+    }
+    case REGEXP_SIGMA:
+    // ranges are non-empty by their type rule
+    case REGEXP_RANGE: return LengthAbs::mkExact(Integer(1));
+    case REGEXP_EMPTY: return LengthAbs::mkEmpty();
+    case REGEXP_CONCAT:
+    {
+      LengthAbs ret = LengthAbs::mkExact(Integer(0));
+      for (const Node& nc : n)
+      {
+        ret = concatLengthAbs(ret, computeLengthAbs(nc));
+      }
+      return ret;
+    }
+    case REGEXP_UNION:
+    {
+      LengthAbs ret = LengthAbs::mkEmpty();
+      for (const Node& nc : n)
+      {
+        ret = unionLengthAbs(ret, computeLengthAbs(nc));
+      }
+      return ret;
+    }
+    case REGEXP_INTER:
+    {
+      // intersect the bounds, and keep an exact length if there is one
+      LengthAbs ret = computeLengthAbs(n[0]);
+      for (size_t i = 1, nchild = n.getNumChildren(); i < nchild; i++)
+      {
+        LengthAbs c = computeLengthAbs(n[i]);
+        if (ret.d_empty || c.d_empty)
+        {
+          return LengthAbs::mkEmpty();
+        }
+        ret.d_min = ret.d_min > c.d_min ? ret.d_min : c.d_min;
+        if (c.d_hasMax && (!ret.d_hasMax || c.d_max < ret.d_max))
+        {
+          ret.d_hasMax = true;
+          ret.d_max = c.d_max;
+        }
+        if (c.d_mod.isZero())
+        {
+          ret.d_mod = c.d_mod;
+          ret.d_rem = c.d_rem;
+        }
+        ret.normalize();
+      }
+      return ret;
+    }
+    case REGEXP_DIFF: return computeLengthAbs(n[0]);
+    case REGEXP_STAR:
+      return loopLengthAbs(
+          computeLengthAbs(n[0]), Integer(0), false, Integer(0));
+    case REGEXP_PLUS:
+      return loopLengthAbs(
+          computeLengthAbs(n[0]), Integer(1), false, Integer(0));
+    case REGEXP_OPT:
+      return unionLengthAbs(computeLengthAbs(n[0]),
+                            LengthAbs::mkExact(Integer(0)));
+    case REGEXP_LOOP:
+    {
+      Integer lo(utils::getLoopMinOccurrences(n));
+      Integer hi(utils::getLoopMaxOccurrences(n));
+      return loopLengthAbs(computeLengthAbs(n[0]), lo, true, hi);
+    }
+    case REGEXP_REPEAT:
+    {
+      Integer amount(utils::getRepeatAmount(n));
+      return loopLengthAbs(computeLengthAbs(n[0]), amount, true, amount);
+    }
+    default: break;
+  }
+  // no information, e.g. for complements
+  return LengthAbs();
+}
+
+Node RegExpEntail::getLengthAbstraction(Node n, Node lenx)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  LengthAbs la = computeLengthAbs(n);
+  if (la.d_empty)
+  {
+    return nm->mkConst(false);
+  }
+  std::vector<Node> conj;
+  if (la.d_mod.isZero())
+  {
+    conj.push_back(lenx.eqNode(nm->mkConst(Rational(la.d_rem))));
+  }
+  else
+  {
+    if (la.d_min.strictlyPositive())
+    {
+      conj.push_back(nm->mkNode(GEQ, lenx, nm->mkConst(Rational(la.d_min))));
+    }
+    if (la.d_hasMax)
+    {
+      conj.push_back(nm->mkNode(LEQ, lenx, nm->mkConst(Rational(la.d_max))));
+    }
+    if (la.d_mod > Integer(1))
+    {
+      Node m = nm->mkNode(
+          INTS_MODULUS_TOTAL, lenx, nm->mkConst(Rational(la.d_mod)));
+      conj.push_back(m.eqNode(nm->mkConst(Rational(la.d_rem))));
+    }
+  }
+  if (conj.empty())
+  {
+    return Node::null();
+  }
+  return conj.size() == 1 ? conj[0] : nm->mkNode(AND, conj);
+}
+
 }  // namespace strings
 }  // namespace theory
 }  // namespace cvc5
@@ -26,6 +26,7 @@
 #include "theory/strings/rewrites.h"
 #include "theory/theory_rewriter.h"
 #include "theory/type_enumerator.h"
+#include "util/integer.h"
 
 namespace cvc5 {
 namespace theory {
@@ -124,6 +125,56 @@ class RegExpEntail
    * @return True if the inclusion can be shown, false otherwise
    */
   static bool regExpIncludes(Node r1, Node r2);
+
+  /**
+   * Get the length abstraction of regular expression n, applied to the
+   * integer term lenx. If this method returns a non-null formula F, then
+   * x in n entails F[len(x)/lenx].
+   *
+   * F is a conjunction of bounds on lenx and of a congruence of lenx modulo
+   * some constant, which over-approximates the lengths of the words in n.
+   * Returns the null node if the abstraction is trivial.
+   */
+  static Node getLengthAbstraction(Node n, Node lenx);
+
+ private:
+  /**
+   * The lengths min <= l <= max such that l is congruent to rem modulo mod,
+   * or l = rem if mod is zero. The maximum is infinite if d_hasMax is false.
+   */
+  struct LengthAbs
+  {
+    LengthAbs();
+    /** Make the abstraction of the lengths {l} */
+    static LengthAbs mkExact(const Integer& l);
+    /** Make the abstraction of the empty set of lengths */
+    static LengthAbs mkEmpty();
+    /**
+     * Reduce rem modulo mod, and mark the abstraction as empty if it has no
+     * lengths.
+     */
+    void normalize();
+    bool d_empty;
+    Integer d_min;
+    bool d_hasMax;
+    Integer d_max;
+    Integer d_mod;
+    Integer d_rem;
+  };
+  /** Compute the length abstraction of n */
+  static LengthAbs computeLengthAbs(Node n);
+  /** The length abstraction of the concatenation of a and b */
+  static LengthAbs concatLengthAbs(const LengthAbs& a, const LengthAbs& b);
+  /** The length abstraction of the union of a and b */
+  static LengthAbs unionLengthAbs(const LengthAbs& a, const LengthAbs& b);
+  /**
+   * The length abstraction of the concatenations of lo to hi copies of a, or
+   * of any number of copies if hasHi is false.
+   */
+  static LengthAbs loopLengthAbs(const LengthAbs& a,
+                                 const Integer& lo,
+                                 bool hasHi,
+                                 const Integer& hi);
 };
 
 }  // namespace strings
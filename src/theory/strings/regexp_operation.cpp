@@ -20,6 +20,7 @@
 #include "expr/node_algorithm.h"
 #include "options/strings_options.h"
 #include "theory/rewriter.h"
+#include "theory/strings/regexp_automaton.h"
 #include "theory/strings/regexp_entail.h"
 #include "theory/strings/theory_strings_utils.h"
 #include "theory/strings/word.h"
@@ -1570,10 +1571,57 @@ bool RegExpOpr::regExpIncludes(Node r1, Node r2)
     return (*it).second;
   }
   bool result = RegExpEntail::regExpIncludes(r1, r2);
+  if (!result && options::stringRegExpAutomata())
+  {
+    bool includes = false;
+    result = RegExpAutomaton::checkIncludes(r1, r2, includes) && includes;
+  }
   d_inclusionCache[std::make_pair(r1, r2)] = result;
   return result;
 }
 
+bool RegExpOpr::isIntersectEmpty(Node r1, Node r2)
+{
+  if (!options::stringRegExpAutomata())
+  {
+    return false;
+  }
+  const auto& it = d_interEmptyCache.find(std::make_pair(r1, r2));
+  if (it != d_interEmptyCache.end())
+  {
+    return (*it).second;
+  }
+  bool result = false;
+  if (RegExpEntail::isConstRegExp(r1) && RegExpEntail::isConstRegExp(r2))
+  {
+    NodeManager* nm = NodeManager::currentNM();
+    RegExpAutomaton a(nm->mkNode(REGEXP_INTER, r1, r2));
+    bool isEmpty = false;
+    result = a.isCompiled() && a.checkEmpty(isEmpty) && isEmpty;
+  }
+  d_interEmptyCache[std::make_pair(r1, r2)] = result;
+  return result;
+}
+
+bool RegExpOpr::testConstStringInRegExp(const String& s, Node r)
+{
+  Assert(RegExpEntail::isConstRegExp(r));
+  if (options::stringRegExpAutomata())
+  {
+    std::unique_ptr<RegExpAutomaton>& a = d_automata[r];
+    if (a == nullptr)
+    {
+      a.reset(new RegExpAutomaton(r));
+    }
+    if (a->isCompiled())
+    {
+      return a->accepts(s);
+    }
+  }
+  String str = s;
+  return RegExpEntail::testConstStringInRegExp(str, 0, r);
+}
+
 /**
  * Associating formulas with their "exists form", or an existentially
  * quantified formula that is equivalent to it. This is currently used
@@ -19,6 +19,7 @@
 #define CVC5__THEORY__STRINGS__REGEXP__OPERATION_H
 
 #include <map>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -31,6 +32,8 @@ namespace cvc5 {
 namespace theory {
 namespace strings {
 
+class RegExpAutomaton;
+
 /**
  * Information on whether regular expressions contain constants or re.allchar.
  *
@@ -83,6 +86,10 @@ class RegExpOpr {
   std::map<PairNodes, Node> d_inter_cache;
   std::map<Node, std::vector<PairNodes> > d_split_cache;
   std::map<PairNodes, bool> d_inclusionCache;
+  /** cache for isIntersectEmpty */
+  std::map<PairNodes, bool> d_interEmptyCache;
+  /** cache of automata for testConstStringInRegExp */
+  std::map<Node, std::unique_ptr<RegExpAutomaton>> d_automata;
   /**
    * Helper function for mkString, pretty prints constant or variable regular
    * expression r.
@@ -184,10 +191,23 @@ class RegExpOpr {
    * Returns true if we can show that the regular expression `r1` includes
    * the regular expression `r2` (i.e. `r1` matches a superset of sequences
    * that `r2` matches). See documentation in RegExpEntail::regExpIncludes for
-   * more details. This call caches the result (which is context-independent),
-   * for performance reasons.
+   * more details. If this check fails and automata are enabled, inclusion is
+   * decided on the automaton for r2 /\ ~r1. This call caches the result (which
+   * is context-independent), for performance reasons.
    */
   bool regExpIncludes(Node r1, Node r2);
+  /**
+   * Returns true if we can show that the intersection of the regular
+   * expressions r1 and r2 is empty, using the automaton for r1 /\ r2. Returns
+   * false if automata are disabled. This call caches the result.
+   */
+  bool isIntersectEmpty(Node r1, Node r2);
+  /**
+   * Returns true if the string s is in the language of the constant regular
+   * expression r. If automata are enabled, this is decided on the automaton
+   * for r, which is cached, otherwise by RegExpEntail::testConstStringInRegExp.
+   */
+  bool testConstStringInRegExp(const String& s, Node r);
 
  private:
   /**
@@ -207,8 +207,19 @@ void RegExpSolver::check(const std::map<Node, std::vector<Node> >& mems)
                                    << nx << " IN " << r << std::endl;
         if (nx != x || changed)
         {
-          // We rewrite the membership nx IN r.
-          Node tmp = Rewriter::rewrite(nm->mkNode(STRING_IN_REGEXP, nx, r));
+          Node tmp;
+          if (nx.isConst() && options::stringRegExpAutomata()
+              && d_regexp_opr.checkConstRegExp(r))
+          {
+            // We evaluate the membership on the automaton for r.
+            tmp = nm->mkConst(d_regexp_opr.testConstStringInRegExp(
+                nx.getConst<String>(), r));
+          }
+          else
+          {
+            // We rewrite the membership nx IN r.
+            tmp = Rewriter::rewrite(nm->mkNode(STRING_IN_REGEXP, nx, r));
+          }
           Trace("strings-regexp-nf") << "Simplifies to " << tmp << std::endl;
           if (tmp.isConst())
           {
@@ -463,7 +474,30 @@ bool RegExpSolver::checkEqcIntersect(const std::vector<Node>& mems)
       rcti = rct;
       continue;
     }
-    Node resR = d_regexp_opr.intersect(mi[1], m[1]);
+    Node resR;
+    if (d_regexp_opr.isIntersectEmpty(mi[1], m[1]))
+    {
+      // emptiness was decided on automata, without computing the intersection
+      resR = d_emptyRegexp;
+    }
+    else if (options::stringRegExpAutomata()
+             && d_regexp_opr.regExpIncludes(m[1], mi[1]))
+    {
+      // x in R1 implies x in R2, hence x in R2 can be marked redundant
+      d_im.markReduced(m, ExtReducedId::STRINGS_REGEXP_INTER_SUBSUME);
+      continue;
+    }
+    else if (options::stringRegExpAutomata()
+             && d_regexp_opr.regExpIncludes(mi[1], m[1]))
+    {
+      // same as above, opposite direction
+      d_im.markReduced(mi, ExtReducedId::STRINGS_REGEXP_INTER_SUBSUME);
+      continue;
+    }
+    else
+    {
+      resR = d_regexp_opr.intersect(mi[1], m[1]);
+    }
     // intersection should be computable
     Assert(!resR.isNull());
     if (resR == d_emptyRegexp)
@@ -1547,9 +1547,10 @@ Node SequencesRewriter::rewriteSeqNth(Node node)
   if (s.isConst() && i.isConst())
   {
     size_t len = Word::getLength(s);
-    size_t pos = i.getConst<Rational>().getNumerator().toUnsignedInt();
-    if (pos < len)
+    const Rational& ri = i.getConst<Rational>();
+    if (ri.sgn() >= 0 && ri < Rational(len))
     {
+      size_t pos = ri.getNumerator().toUnsignedInt();
       std::vector<Node> elements = s.getConst<Sequence>().getVec();
       const Node& ret = elements[pos];
       return returnRewrite(node, ret, Rewrite::SEQ_NTH_EVAL);
@@ -34,6 +34,7 @@ std::ostream& operator<<(std::ostream& out, InferStep s)
     case CHECK_NORMAL_FORMS_EQ: out << "check_normal_forms_eq"; break;
     case CHECK_NORMAL_FORMS_DEQ: out << "check_normal_forms_deq"; break;
     case CHECK_CODES: out << "check_codes"; break;
+    case CHECK_ARRAY_TERMS: out << "check_array_terms"; break;
     case CHECK_LENGTH_EQC: out << "check_length_eqc"; break;
     case CHECK_EXTF_REDUCTION: out << "check_extf_reduction"; break;
     case CHECK_MEMBERSHIP: out << "check_membership"; break;
@@ -126,6 +127,10 @@ void Strategy::initializeStrategy()
     }
     addStrategyStep(CHECK_NORMAL_FORMS_DEQ);
     addStrategyStep(CHECK_CODES);
+    if (options::seqArray())
+    {
+      addStrategyStep(CHECK_ARRAY_TERMS);
+    }
     if (options::stringEagerLen() && options::stringLenNorm())
     {
       addStrategyStep(CHECK_LENGTH_EQC);
@@ -135,6 +140,11 @@ void Strategy::initializeStrategy()
       addStrategyStep(CHECK_EXTF_REDUCTION, 2);
     }
     addStrategyStep(CHECK_MEMBERSHIP);
+    if (options::stringExp() && options::seqArray())
+    {
+      // the reductions of seq.nth and seq.update, see ExtfSolver
+      addStrategyStep(CHECK_EXTF_REDUCTION, 3);
+    }
     addStrategyStep(CHECK_CARDINALITY);
     step_end[Theory::EFFORT_FULL] = d_infer_steps.size() - 1;
     if (options::stringExp() && options::stringGuessModel())
@@ -55,6 +55,8 @@ enum InferStep
   CHECK_NORMAL_FORMS_DEQ,
   // check codes
   CHECK_CODES,
+  // check seq.nth and seq.update terms with the array solver
+  CHECK_ARRAY_TERMS,
   // check lengths for equivalence classes
   CHECK_LENGTH_EQC,
   // check register terms for normal forms
@@ -21,6 +21,7 @@
 #include "smt/logic_exception.h"
 #include "theory/rewriter.h"
 #include "theory/strings/inference_manager.h"
+#include "theory/strings/regexp_entail.h"
 #include "theory/strings/theory_strings_utils.h"
 #include "theory/strings/word.h"
 
@@ -170,6 +171,10 @@ void TermRegistry::preRegisterTerm(TNode n)
     ee->addTriggerPredicate(n);
     ee->addTerm(n[0]);
     ee->addTerm(n[1]);
+    if (options::stringLenAbs())
+    {
+      registerLengthAbstraction(n);
+    }
     return;
   }
   else if (k == STRING_TO_CODE)
@@ -313,6 +318,23 @@ void TermRegistry::registerTerm(Node n, int effort)
   }
 }
 
+void TermRegistry::registerLengthAbstraction(Node n)
+{
+  Assert(n.getKind() == STRING_IN_REGEXP);
+  Node lenx = utils::mkNLength(n[0]);
+  Node abs = RegExpEntail::getLengthAbstraction(n[1], lenx);
+  if (abs.isNull())
+  {
+    return;
+  }
+  // sent eagerly, so that memberships whose lengths are inconsistent are
+  // refuted by arithmetic before they are unfolded
+  Node lem = n.impNode(abs);
+  Trace("strings-lemma") << "Strings::Lemma RE-LENGTH-ABS : " << lem
+                         << std::endl;
+  d_im->lemma(lem, InferenceId::STRINGS_RE_LENGTH_ABS);
+}
+
 void TermRegistry::registerType(TypeNode tn)
 {
   if (d_registeredTypes.find(tn) != d_registeredTypes.end())
@@ -93,6 +93,8 @@ class TermRegistry
    * - Setting phase requirements on n if it is a formula and we prefer
    * decisions with a particular polarity (e.g. positive regular expression
    * memberships).
+   * - Sending the length abstraction of regular expression memberships, if
+   * options::stringLenAbs is enabled.
    */
   void preRegisterTerm(TNode n);
   /** Register term
@@ -276,6 +278,12 @@ class TermRegistry
   TrustNode getRegisterTermAtomicLemma(Node n,
                                        LengthStatus s,
                                        std::map<Node, bool>& reqPhase);
+  /**
+   * Send the length abstraction lemma for the regular expression membership
+   * n, of the form (str.in_re x R) => F, where F is a linear constraint on
+   * (str.len x) given by RegExpEntail::getLengthAbstraction.
+   */
+  void registerLengthAbstraction(Node n);
 };
 
 }  // namespace strings
@@ -63,6 +63,7 @@ TheoryStrings::TheoryStrings(context::Context* c,
                 d_csolver,
                 d_extTheory,
                 d_statistics),
+      d_asolver(d_state, d_im, d_bsolver, d_csolver, d_extTheory),
       d_rsolver(d_state,
                 d_im,
                 d_termReg.getSkolemCache(),
@@ -112,6 +113,12 @@ void TheoryStrings::finishInit()
 
   // witness is used to eliminate str.from_code
   d_valuation.setUnevaluatedKind(WITNESS);
+  if (options::seqArray())
+  {
+    // seq.nth out of bounds does not evaluate, its value is the value of the
+    // term in the equality engine, as assigned by the array solver
+    d_valuation.setSemiEvaluatedKind(SEQ_NTH);
+  }
 
   bool eagerEval = options::stringEagerEval();
   // The kinds we are treating as function application in congruence
@@ -972,6 +979,7 @@ void TheoryStrings::runInferStep(InferStep s, int effort)
     case CHECK_NORMAL_FORMS_EQ: d_csolver.checkNormalFormsEq(); break;
     case CHECK_NORMAL_FORMS_DEQ: d_csolver.checkNormalFormsDeq(); break;
     case CHECK_CODES: checkCodes(); break;
+    case CHECK_ARRAY_TERMS: d_asolver.checkArrayTerms(); break;
     case CHECK_LENGTH_EQC: d_csolver.checkLengthsEqc(); break;
     case CHECK_REGISTER_TERMS_NF: checkRegisterTermsNormalForms(); break;
     case CHECK_EXTF_REDUCTION: d_esolver.checkExtfReductions(effort); break;
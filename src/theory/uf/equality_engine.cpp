@@ -18,8 +18,11 @@
 
 #include "theory/uf/equality_engine.h"
 
+#include <unordered_set>
+
 #include "base/output.h"
 #include "options/smt_options.h"
+#include "options/uf_options.h"
 #include "proof/proof_manager.h"
 #include "smt/smt_statistics_registry.h"
 #include "theory/rewriter.h"
@@ -116,6 +119,7 @@ EqualityEngine::EqualityEngine(context::Context* context,
       d_notify(s_notifyNone),
       d_applicationLookupsCount(context, 0),
       d_nodesCount(context, 0),
+      d_modTime(0),
       d_assertedEqualitiesCount(context, 0),
       d_equalityTriggersCount(context, 0),
       d_subtermEvaluatesSize(context, 0),
@@ -146,6 +150,7 @@ EqualityEngine::EqualityEngine(EqualityEngineNotify& notify,
       d_notify(notify),
       d_applicationLookupsCount(context, 0),
       d_nodesCount(context, 0),
+      d_modTime(0),
       d_assertedEqualitiesCount(context, 0),
       d_equalityTriggersCount(context, 0),
       d_subtermEvaluatesSize(context, 0),
@@ -223,9 +228,9 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
 
   // Add to the use lists
   Debug("equality") << d_name << "::eq::newApplicationNode(" << original << ", " << t1 << ", " << t2 << "): adding " << original << " to the uselist of " << d_nodes[t1] << std::endl;
-  d_equalityNodes[t1].usedIn(funId, d_useListNodes);
+  d_nodeData[t1].d_node.usedIn(funId, d_useListNodes);
   Debug("equality") << d_name << "::eq::newApplicationNode(" << original << ", " << t1 << ", " << t2 << "): adding " << original << " to the uselist of " << d_nodes[t2] << std::endl;
-  d_equalityNodes[t2].usedIn(funId, d_useListNodes);
+  d_nodeData[t2].d_node.usedIn(funId, d_useListNodes);
 
   // Return the new id
   Debug("equality") << d_name << "::eq::newApplicationNode(" << original << ", " << t1 << ", " << t2 << ") => " << funId << std::endl;
@@ -246,22 +251,12 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_nodes.push_back(node);
   // Note if this is an application or not
   d_applications.push_back(FunctionApplicationPair());
-  // Add the trigger list for this node
-  d_nodeTriggers.push_back(+null_trigger);
   // Add it to the equality graph
   d_equalityGraph.push_back(+null_edge);
-  // Mark the no-individual trigger
-  d_nodeIndividualTrigger.push_back(+null_set_id);
-  // Mark non-constant by default
-  d_isConstant.push_back(false);
-  // No terms to evaluate by defaul
-  d_subtermsToEvaluate.push_back(0);
-  // Mark equality nodes
-  d_isEquality.push_back(false);
-  // Mark the node as internal by default
-  d_isInternal.push_back(true);
-  // Add the equality node to the nodes
-  d_equalityNodes.push_back(EqualityNode(newId));
+  // Add the equality node, with no triggers, non-constant, non-equality and
+  // internal by default
+  d_nodeData.push_back(NodeData(newId));
+  d_modTimes.push_back(++d_modTime);
 
   // Increase the counters
   d_nodesCount = d_nodesCount + 1;
@@ -296,15 +291,15 @@ void EqualityEngine::addFunctionKind(Kind fun,
 }
 
 void EqualityEngine::subtermEvaluates(EqualityNodeId id)  {
-  Debug("equality::evaluation") << d_name << "::eq::subtermEvaluates(" << d_nodes[id] << "): " << d_subtermsToEvaluate[id] << std::endl;
-  Assert(!d_isInternal[id]);
-  Assert(d_subtermsToEvaluate[id] > 0);
-  if ((-- d_subtermsToEvaluate[id]) == 0) {
+  Debug("equality::evaluation") << d_name << "::eq::subtermEvaluates(" << d_nodes[id] << "): " << d_nodeData[id].d_subtermsToEvaluate << std::endl;
+  Assert(!d_nodeData[id].d_isInternal);
+  Assert(d_nodeData[id].d_subtermsToEvaluate > 0);
+  if ((-- d_nodeData[id].d_subtermsToEvaluate) == 0) {
     d_evaluationQueue.push(id);
   }
   d_subtermEvaluates.push_back(id);
   d_subtermEvaluatesSize = d_subtermEvaluates.size();
-  Debug("equality::evaluation") << d_name << "::eq::subtermEvaluates(" << d_nodes[id] << "): new " << d_subtermsToEvaluate[id] << std::endl;
+  Debug("equality::evaluation") << d_name << "::eq::subtermEvaluates(" << d_nodes[id] << "): new " << d_nodeData[id].d_subtermsToEvaluate << std::endl;
 }
 
 void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
@@ -331,8 +326,8 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
     EqualityNodeId t0id = getNodeId(t[0]);
     EqualityNodeId t1id = getNodeId(t[1]);
     result = newApplicationNode(t, t0id, t1id, APP_EQUALITY);
-    d_isInternal[result] = false;
-    d_isConstant[result] = false;
+    d_nodeData[result].d_isInternal = false;
+    d_nodeData[result].d_isConstant = false;
   }
   else if (t.getNumChildren() > 0 && d_congruenceKinds[tk])
   {
@@ -349,12 +344,12 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
       // Add the application
       result = newApplicationNode(t, result, tiId, isInterpreted ? APP_INTERPRETED : APP_UNINTERPRETED);
     }
-    d_isInternal[result] = false;
-    d_isConstant[result] = t.isConst();
+    d_nodeData[result].d_isInternal = false;
+    d_nodeData[result].d_isConstant = t.isConst();
     // If interpreted, set the number of non-interpreted children
     if (isInterpreted) {
       // How many children are not constants yet
-      d_subtermsToEvaluate[result] = t.getNumChildren();
+      d_nodeData[result].d_subtermsToEvaluate = t.getNumChildren();
       for (unsigned i = 0; i < t.getNumChildren(); ++ i) {
         if (isConstant(getNodeId(t[i]))) {
           Debug("equality::evaluation") << d_name << "::eq::addTermInternal(" << t << "): evaluates " << t[i] << std::endl;
@@ -368,15 +363,15 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
     // Otherwise we just create the new id
     result = newNode(t);
     // Is this an operator
-    d_isInternal[result] = isOperator;
-    d_isConstant[result] = !isOperator && t.isConst();
+    d_nodeData[result].d_isInternal = isOperator;
+    d_nodeData[result].d_isConstant = !isOperator && t.isConst();
   }
 
   if (tk == kind::EQUAL)
   {
     // We set this here as this only applies to actual terms, not the
     // intermediate application terms
-    d_isEquality[result] = true;
+    d_nodeData[result].d_isEquality = true;
   }
   else
   {
@@ -386,7 +381,7 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
     {
       d_notify.eqNotifyNewClass(t);
     }
-    if (d_constantsAreTriggers && d_isConstant[result])
+    if (d_constantsAreTriggers && d_nodeData[result].d_isConstant)
     {
       // Non-Boolean constants are trigger terms for all tags
       EqualityNodeId tId = getNodeId(t);
@@ -404,13 +399,13 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
       d_triggerTermSetUpdates.push_back(TriggerSetUpdate(tId, null_set_id));
       d_triggerTermSetUpdatesSize = d_triggerTermSetUpdatesSize + 1;
       // Mark the the new set as a trigger
-      d_nodeIndividualTrigger[tId] =
+      d_nodeData[tId].d_individualTrigger =
           newTriggerTermSet(newSetTags, newSetTriggers, newSetTriggersSize);
     }
   }
 
   // If this is not an internal node, add it to the master
-  if (d_masterEqualityEngine && !d_isInternal[result]) {
+  if (d_masterEqualityEngine && !d_nodeData[result].d_isInternal) {
     d_masterEqualityEngine->addTermInternal(t);
   }
 
@@ -436,8 +431,8 @@ EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(EqualityNodeId nodeId) {
-  Assert(nodeId < d_equalityNodes.size());
-  return d_equalityNodes[nodeId];
+  Assert(nodeId < d_nodeData.size());
+  return d_nodeData[nodeId].d_node;
 }
 
 const EqualityNode& EqualityEngine::getEqualityNode(TNode t) const {
@@ -445,8 +440,8 @@ const EqualityNode& EqualityEngine::getEqualityNode(TNode t) const {
 }
 
 const EqualityNode& EqualityEngine::getEqualityNode(EqualityNodeId nodeId) const {
-  Assert(nodeId < d_equalityNodes.size());
-  return d_equalityNodes[nodeId];
+  Assert(nodeId < d_nodeData.size());
+  return d_nodeData[nodeId].d_node;
 }
 
 void EqualityEngine::assertEqualityInternal(TNode t1, TNode t2, TNode reason, unsigned pid) {
@@ -525,14 +520,14 @@ bool EqualityEngine::assertEquality(TNode eq,
     EqualityNodeId b = getNodeId(eq[1]);
     EqualityNodeId aClassId = getEqualityNode(a).getFind();
     EqualityNodeId bClassId = getEqualityNode(b).getFind();
-    if (d_isConstant[aClassId] && d_isConstant[bClassId]) {
+    if (d_nodeData[aClassId].d_isConstant && d_nodeData[bClassId].d_isConstant) {
       return true;
     }
 
     // If we are adding a disequality, notify of the shared term representatives
     EqualityNodeId eqId = getNodeId(eq);
-    TriggerTermSetRef aTriggerRef = d_nodeIndividualTrigger[aClassId];
-    TriggerTermSetRef bTriggerRef = d_nodeIndividualTrigger[bClassId];
+    TriggerTermSetRef aTriggerRef = d_nodeData[aClassId].d_individualTrigger;
+    TriggerTermSetRef bTriggerRef = d_nodeData[bClassId].d_individualTrigger;
     if (aTriggerRef != +null_set_id && bTriggerRef != +null_set_id) {
       Debug("equality::trigger") << d_name << "::eq::addEquality(" << eq << "," << (polarity ? "true" : "false") << ": have triggers" << std::endl;
       // The sets of trigger terms
@@ -585,11 +580,17 @@ TNode EqualityEngine::getRepresentative(TNode t) const {
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ")" << std::endl;
   Assert(hasTerm(t));
   EqualityNodeId representativeId = getEqualityNode(t).getFind();
-  Assert(!d_isInternal[representativeId]);
+  Assert(!d_nodeData[representativeId].d_isInternal);
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ") => " << d_nodes[representativeId] << std::endl;
   return d_nodes[representativeId];
 }
 
+uint64_t EqualityEngine::getModificationTime(TNode t) const
+{
+  Assert(hasTerm(t));
+  return d_modTimes[getEqualityNode(t).getFind()];
+}
+
 bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggersFired) {
 
   Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << ")" << std::endl;
@@ -600,6 +601,8 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
 
   EqualityNodeId class1Id = class1.getFind();
   EqualityNodeId class2Id = class2.getFind();
+  // class 1 will be the representative of the merged class
+  d_modTimes[class1Id] = ++d_modTime;
 
   Node n1 = d_nodes[class1Id];
   Node n2 = d_nodes[class2Id];
@@ -615,19 +618,19 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Check for constant merges
-  bool class1isConstant = d_isConstant[class1Id];
-  bool class2isConstant = d_isConstant[class2Id];
+  bool class1isConstant = d_nodeData[class1Id].d_isConstant;
+  bool class2isConstant = d_nodeData[class2Id].d_isConstant;
   Assert(class1isConstant || !class2isConstant)
       << "Should always merge into constants";
   Assert(!class1isConstant || !class2isConstant) << "Don't merge constants";
 
   // Trigger set of class 1
-  TriggerTermSetRef class1triggerRef = d_nodeIndividualTrigger[class1Id];
+  TriggerTermSetRef class1triggerRef = d_nodeData[class1Id].d_individualTrigger;
   TheoryIdSet class1Tags = class1triggerRef == null_set_id
                                ? 0
                                : getTriggerTermSet(class1triggerRef).d_tags;
   // Trigger set of class 2
-  TriggerTermSetRef class2triggerRef = d_nodeIndividualTrigger[class2Id];
+  TriggerTermSetRef class2triggerRef = d_nodeData[class2Id].d_individualTrigger;
   TheoryIdSet class2Tags = class2triggerRef == null_set_id
                                ? 0
                                : getTriggerTermSet(class2triggerRef).d_tags;
@@ -661,7 +664,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
     currentNode.setFind(class1Id);
 
     // Go through the triggers and inform if necessary
-    TriggerId currentTrigger = d_nodeTriggers[currentId];
+    TriggerId currentTrigger = d_nodeData[currentId].d_triggers;
     while (currentTrigger != null_trigger) {
       Trigger& trigger = d_equalityTriggers[currentTrigger];
       Trigger& otherTrigger = d_equalityTriggers[currentTrigger ^ 1];
@@ -689,7 +692,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
 
   // Update class2 table lookup and information if not a boolean
   // since booleans can't be in an application
-  if (!d_isEquality[class2Id]) {
+  if (!d_nodeData[class2Id].d_isEquality) {
     Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of " << class2Id << std::endl;
     do {
       // Get the current node
@@ -707,7 +710,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         const FunctionApplication& fun =
             d_applications[useNode.getApplicationId()].d_normalized;
         // If it's interpreted and we can interpret
-        if (fun.isInterpreted() && class1isConstant && !d_isInternal[currentId])
+        if (fun.isInterpreted() && class1isConstant && !d_nodeData[currentId].d_isInternal)
         {
           // Get the actual term id
           TNode term = d_nodes[funId];
@@ -757,7 +760,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   if (class2triggerRef != +null_set_id) {
     if (class1triggerRef == +null_set_id) {
       // If class1 doesn't have individual triggers, but class2 does, mark it
-      d_nodeIndividualTrigger[class1Id] = class2triggerRef;
+      d_nodeData[class1Id].d_individualTrigger = class2triggerRef;
       // Add it to the list for backtracking
       d_triggerTermSetUpdates.push_back(TriggerSetUpdate(class1Id, +null_set_id));
       d_triggerTermSetUpdatesSize = d_triggerTermSetUpdatesSize + 1;
@@ -817,7 +820,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         d_triggerTermSetUpdates.push_back(TriggerSetUpdate(class1Id, class1triggerRef));
         d_triggerTermSetUpdatesSize = d_triggerTermSetUpdatesSize + 1;
         // Mark the the new set as a trigger
-        d_nodeIndividualTrigger[class1Id] = newTriggerTermSet(newSetTags, newSetTriggers, newSetTriggersSize);
+        d_nodeData[class1Id].d_individualTrigger = newTriggerTermSet(newSetTags, newSetTriggers, newSetTriggersSize);
       }
     }
   }
@@ -844,7 +847,7 @@ void EqualityEngine::undoMerge(EqualityNode& class1, EqualityNode& class2, Equal
     currentNode.setFind(class2Id);
 
     // Go through the trigger list (if any) and undo the class
-    TriggerId currentTrigger = d_nodeTriggers[currentId];
+    TriggerId currentTrigger = d_nodeData[currentId].d_triggers;
     while (currentTrigger != null_trigger) {
       Trigger& trigger = d_equalityTriggers[currentTrigger];
       trigger.d_classId = class2Id;
@@ -879,7 +882,7 @@ void EqualityEngine::backtrack() {
       if (eq.d_lhs != null_id)
       {
         undoMerge(
-            d_equalityNodes[eq.d_lhs], d_equalityNodes[eq.d_rhs], eq.d_rhs);
+            d_nodeData[eq.d_lhs].d_node, d_nodeData[eq.d_rhs].d_node, eq.d_rhs);
       }
     }
 
@@ -901,7 +904,7 @@ void EqualityEngine::backtrack() {
     // Unset the individual triggers
     for (int i = d_triggerTermSetUpdates.size() - 1, i_end = d_triggerTermSetUpdatesSize; i >= i_end; -- i) {
       const TriggerSetUpdate& update = d_triggerTermSetUpdates[i];
-      d_nodeIndividualTrigger[update.d_classId] = update.d_oldValue;
+      d_nodeData[update.d_classId].d_individualTrigger = update.d_oldValue;
     }
     d_triggerTermSetUpdates.resize(d_triggerTermSetUpdatesSize);
   }
@@ -910,7 +913,7 @@ void EqualityEngine::backtrack() {
     // Unlink the triggers from the lists
     for (int i = d_equalityTriggers.size() - 1, i_end = d_equalityTriggersCount; i >= i_end; -- i) {
       const Trigger& trigger = d_equalityTriggers[i];
-      d_nodeTriggers[trigger.d_classId] = trigger.d_nextTrigger;
+      d_nodeData[trigger.d_classId].d_triggers = trigger.d_nextTrigger;
     }
     // Get rid of the triggers
     d_equalityTriggers.resize(d_equalityTriggersCount);
@@ -926,7 +929,7 @@ void EqualityEngine::backtrack() {
 
   if (d_subtermEvaluates.size() > d_subtermEvaluatesSize) {
     for(int i = d_subtermEvaluates.size() - 1, i_end = (int)d_subtermEvaluatesSize; i >= i_end; --i) {
-      d_subtermsToEvaluate[d_subtermEvaluates[i]] ++;
+      d_nodeData[d_subtermEvaluates[i]].d_subtermsToEvaluate ++;
     }
     d_subtermEvaluates.resize(d_subtermEvaluatesSize);
   }
@@ -950,14 +953,9 @@ void EqualityEngine::backtrack() {
     // Now get rid of the nodes and the rest
     d_nodes.resize(d_nodesCount);
     d_applications.resize(d_nodesCount);
-    d_nodeTriggers.resize(d_nodesCount);
-    d_nodeIndividualTrigger.resize(d_nodesCount);
-    d_isConstant.resize(d_nodesCount);
-    d_subtermsToEvaluate.resize(d_nodesCount);
-    d_isEquality.resize(d_nodesCount);
-    d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
-    d_equalityNodes.resize(d_nodesCount);
+    d_nodeData.erase(d_nodeData.begin() + d_nodesCount, d_nodeData.end());
+    d_modTimes.resize(d_nodesCount);
   }
 
   if (d_deducedDisequalities.size() > d_deducedDisequalitiesSize) {
@@ -1018,7 +1016,7 @@ void EqualityEngine::buildEqConclusion(EqualityNodeId id1,
   // only try to build build if full applications corresponding to the given ids
   // have the same congruence n-ary non-APPLY_* kind, since the internal nodes
   // may be full nodes.
-  if ((d_isInternal[id1] || d_isInternal[id2])
+  if ((d_nodeData[id1].d_isInternal || d_nodeData[id2].d_isInternal)
       && (k1 != k2 || k1 == kind::APPLY_UF || k1 == kind::APPLY_CONSTRUCTOR
           || k1 == kind::APPLY_SELECTOR || k1 == kind::APPLY_TESTER
           || !NodeManager::isNAryKind(k1)))
@@ -1036,7 +1034,7 @@ void EqualityEngine::buildEqConclusion(EqualityNodeId id1,
     EqualityNodeId equalityNodeId = i == 0 ? id1 : id2;
     Node equalityNode = d_nodes[equalityNodeId];
     // if not an internal node, just retrieve it
-    if (!d_isInternal[equalityNodeId])
+    if (!d_nodeData[equalityNodeId].d_isInternal)
     {
       eq[i] = equalityNode;
       continue;
@@ -1103,6 +1101,29 @@ void EqualityEngine::explainEquality(TNode t1, TNode t2, bool polarity,
   EqualityNodeId t1Id = getNodeId(t1);
   EqualityNodeId t2Id = getNodeId(t2);
 
+  if (!eqp && options::eeFastExplain())
+  {
+    std::vector<EqualityPair> pairs;
+    if (polarity)
+    {
+      pairs.emplace_back(t1Id, t2Id);
+    }
+    else
+    {
+      EqualityPair pair(t1Id, t2Id);
+      Assert(d_disequalityReasonsMap.find(pair)
+             != d_disequalityReasonsMap.end())
+          << "Don't ask for stuff I didn't notify you about";
+      DisequalityReasonRef reasonRef =
+          d_disequalityReasonsMap.find(pair)->second;
+      pairs.insert(pairs.end(),
+                   d_deducedDisequalityReasons.begin() + reasonRef.d_mergesStart,
+                   d_deducedDisequalityReasons.begin() + reasonRef.d_mergesEnd);
+    }
+    getExplanationFast(pairs, equalities);
+    return;
+  }
+
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   if (polarity) {
     // Get the explanation
@@ -1254,6 +1275,12 @@ void EqualityEngine::explainPredicate(TNode p, bool polarity,
                     << std::endl;
   // Must have the term
   Assert(hasTerm(p));
+  if (!eqp && options::eeFastExplain())
+  {
+    getExplanationFast({{getNodeId(p), polarity ? d_trueId : d_falseId}},
+                       assertions);
+    return;
+  }
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*> cache;
   if (Debug.isOn("equality::internal"))
   {
@@ -1401,8 +1428,8 @@ void EqualityEngine::getExplanation(
       //
       // Note that this is robust for HOL because in that case function
       // symbols are not internal nodes
-      if (d_isInternal[t1Id] && d_nodes[t1Id].getNumChildren() == 0
-          && !d_isConstant[t1Id])
+      if (d_nodeData[t1Id].d_isInternal && d_nodes[t1Id].getNumChildren() == 0
+          && !d_nodeData[t1Id].d_isConstant)
       {
         eqp->d_node = Node::null();
       }
@@ -1706,6 +1733,129 @@ void EqualityEngine::getExplanation(
   }
 }
 
+void EqualityEngine::getExplanationFast(const std::vector<EqualityPair>& pairs,
+                                        std::vector<TNode>& equalities) const
+{
+  // The parent, the edge to the parent and the depth of the nodes in the
+  // rooted trees of the equality graph.
+  struct TreeNode
+  {
+    EqualityNodeId d_parent;
+    EqualityEdgeId d_edge;
+    size_t d_depth;
+  };
+  std::unordered_map<EqualityNodeId, TreeNode> tree;
+  // The pairs already explained and the (undirected) edges already explained
+  std::unordered_set<EqualityPair, EqualityPairHashFunction> explained;
+  std::unordered_set<EqualityEdgeId> explainedEdges;
+  std::vector<EqualityPair> toExplain(pairs.rbegin(), pairs.rend());
+
+  // Root the tree containing t at t
+  auto rootTree = [&](EqualityNodeId t) {
+    tree[t] = TreeNode{null_id, null_edge, 0};
+    std::vector<EqualityNodeId> queue{t};
+    for (size_t i = 0; i < queue.size(); ++i)
+    {
+      EqualityNodeId current = queue[i];
+      const TreeNode& info = tree[current];
+      EqualityNodeId parent = info.d_parent;
+      size_t depth = info.d_depth + 1;
+      EqualityEdgeId edgeId = d_equalityGraph[current];
+      while (edgeId != null_edge)
+      {
+        const EqualityEdge& edge = d_equalityEdges[edgeId];
+        if (edge.getNodeId() != parent)
+        {
+          tree[edge.getNodeId()] = TreeNode{current, edgeId, depth};
+          queue.push_back(edge.getNodeId());
+        }
+        edgeId = edge.getNext();
+      }
+    }
+  };
+
+  // Explain the edge from t to its parent in the tree
+  auto explainEdge = [&](EqualityNodeId t) {
+    const TreeNode& info = tree[t];
+    EqualityEdgeId edgeId = info.d_edge;
+    if (!explainedEdges.insert(edgeId >> 1).second)
+    {
+      return;
+    }
+    const EqualityEdge& edge = d_equalityEdges[edgeId];
+    EqualityNodeId currentNode = info.d_parent;
+    EqualityNodeId edgeNode = t;
+    switch (edge.getReasonType())
+    {
+      case MERGED_THROUGH_CONGRUENCE:
+      {
+        // f(x1, x2) == f(y1, y2) because x1 = y1 and x2 = y2
+        const FunctionApplication& f1 = d_applications[currentNode].d_original;
+        const FunctionApplication& f2 = d_applications[edgeNode].d_original;
+        toExplain.emplace_back(f1.d_b, f2.d_b);
+        toExplain.emplace_back(f1.d_a, f2.d_a);
+        break;
+      }
+      case MERGED_THROUGH_REFLEXIVITY:
+      {
+        // x1 == x1
+        EqualityNodeId eqId = currentNode == d_trueId ? edgeNode : currentNode;
+        const FunctionApplication& eq = d_applications[eqId].d_original;
+        Assert(eq.isEquality()) << "Must be an equality";
+        toExplain.emplace_back(eq.d_a, eq.d_b);
+        break;
+      }
+      case MERGED_THROUGH_CONSTANTS:
+      {
+        // f(c1, ..., cn) = c semantically, explain why the ci are constants
+        TNode interpreted = d_nodes[currentNode].isConst() ? d_nodes[edgeNode]
+                                                           : d_nodes[currentNode];
+        for (TNode child : interpreted)
+        {
+          EqualityNodeId childId = getNodeId(child);
+          Assert(isConstant(childId));
+          toExplain.emplace_back(childId, getEqualityNode(childId).getFind());
+        }
+        break;
+      }
+      default: equalities.push_back(edge.getReason()); break;
+    }
+  };
+
+  while (!toExplain.empty())
+  {
+    EqualityNodeId t1Id = toExplain.back().first;
+    EqualityNodeId t2Id = toExplain.back().second;
+    toExplain.pop_back();
+    if (t1Id == t2Id || !explained.insert(std::minmax(t1Id, t2Id)).second)
+    {
+      continue;
+    }
+    Trace("eq-exp") << d_name << "::eq::getExplanationFast({" << t1Id << "} "
+                    << d_nodes[t1Id] << ", {" << t2Id << "} " << d_nodes[t2Id]
+                    << ")" << std::endl;
+    if (tree.find(t1Id) == tree.end())
+    {
+      rootTree(t1Id);
+    }
+    Assert(tree.find(t2Id) != tree.end()) << "Can't explain equality";
+    // Walk up to the lowest common ancestor
+    while (t1Id != t2Id)
+    {
+      if (tree[t1Id].d_depth >= tree[t2Id].d_depth)
+      {
+        explainEdge(t1Id);
+        t1Id = tree[t1Id].d_parent;
+      }
+      else
+      {
+        explainEdge(t2Id);
+        t2Id = tree[t2Id].d_parent;
+      }
+    }
+  }
+}
+
 void EqualityEngine::addTriggerEquality(TNode eq) {
   Assert(eq.getKind() == kind::EQUAL);
 
@@ -1797,13 +1947,13 @@ void EqualityEngine::addTriggerEqualityInternal(TNode t1, TNode t2, TNode trigge
   EqualityNodeId t1Id = getNodeId(t1);
   EqualityNodeId t1classId = getEqualityNode(t1Id).getFind();
   // We will attach it to the class representative, since then we know how to backtrack it
-  TriggerId t1TriggerId = d_nodeTriggers[t1classId];
+  TriggerId t1TriggerId = d_nodeData[t1classId].d_triggers;
 
   // Get the information about t2
   EqualityNodeId t2Id = getNodeId(t2);
   EqualityNodeId t2classId = getEqualityNode(t2Id).getFind();
   // We will attach it to the class representative, since then we know how to backtrack it
-  TriggerId t2TriggerId = d_nodeTriggers[t2classId];
+  TriggerId t2TriggerId = d_nodeData[t2classId].d_triggers;
 
   Debug("equality") << d_name << "::eq::addTrigger(" << trigger << "): " << t1Id << " (" << t1classId << ") = " << t2Id << " (" << t2classId << ")" << std::endl;
 
@@ -1821,8 +1971,8 @@ void EqualityEngine::addTriggerEqualityInternal(TNode t1, TNode t2, TNode trigge
   Assert(d_equalityTriggers.size() % 2 == 0);
 
   // Add the trigger to the trigger graph
-  d_nodeTriggers[t1classId] = t1NewTriggerId;
-  d_nodeTriggers[t2classId] = t2NewTriggerId;
+  d_nodeData[t1classId].d_triggers = t1NewTriggerId;
+  d_nodeData[t2classId].d_triggers = t2NewTriggerId;
 
   if (Debug.isOn("equality::internal")) {
     debugPrintGraph();
@@ -1912,8 +2062,8 @@ void EqualityEngine::propagate() {
       continue;
     }
 
-    Debug("equality::internal") << d_name << "::eq::propagate(): t1: " << (d_isInternal[t1classId] ? "internal" : "proper") << std::endl;
-    Debug("equality::internal") << d_name << "::eq::propagate(): t2: " << (d_isInternal[t2classId] ? "internal" : "proper") << std::endl;
+    Debug("equality::internal") << d_name << "::eq::propagate(): t1: " << (d_nodeData[t1classId].d_isInternal ? "internal" : "proper") << std::endl;
+    Debug("equality::internal") << d_name << "::eq::propagate(): t2: " << (d_nodeData[t2classId].d_isInternal ? "internal" : "proper") << std::endl;
 
     // Get the nodes of the representatives
     EqualityNode& node1 = getEqualityNode(t1classId);
@@ -1927,7 +2077,7 @@ void EqualityEngine::propagate() {
         current.d_t1Id, current.d_t2Id, current.d_type, current.d_reason);
 
     // If constants are being merged we're done
-    if (d_isConstant[t1classId] && d_isConstant[t2classId]) {
+    if (d_nodeData[t1classId].d_isConstant && d_nodeData[t2classId].d_isConstant) {
       // When merging constants we are inconsistent, hence done
       d_done = true;
       // But in order to keep invariants (edges = 2*equalities) we put an equalities in
@@ -1947,18 +2097,18 @@ void EqualityEngine::propagate() {
 
     // Figure out the merge preference
     EqualityNodeId mergeInto = t1classId;
-    if (d_isInternal[t2classId] != d_isInternal[t1classId]) {
+    if (d_nodeData[t2classId].d_isInternal != d_nodeData[t1classId].d_isInternal) {
       // We always keep non-internal nodes as representatives: if any node in
       // the class is non-internal, then the representative will be non-internal
-      if (d_isInternal[t1classId]) {
+      if (d_nodeData[t1classId].d_isInternal) {
         mergeInto = t2classId;
       } else {
         mergeInto = t1classId;
       }
-    } else if (d_isConstant[t2classId] != d_isConstant[t1classId]) {
+    } else if (d_nodeData[t2classId].d_isConstant != d_nodeData[t1classId].d_isConstant) {
       // We always keep constants as representatives: if any (at most one) node
       // in the class in a constant, then the representative will be a constant
-      if (d_isConstant[t2classId]) {
+      if (d_nodeData[t2classId].d_isConstant) {
         mergeInto = t2classId;
       } else {
         mergeInto = t1classId;
@@ -1990,7 +2140,7 @@ void EqualityEngine::propagate() {
     }
 
     // If not merging internal nodes, notify the master
-    if (d_masterEqualityEngine && !d_isInternal[t1classId] && !d_isInternal[t2classId]) {
+    if (d_masterEqualityEngine && !d_nodeData[t1classId].d_isInternal && !d_nodeData[t2classId].d_isInternal) {
       d_masterEqualityEngine->assertEqualityInternal(d_nodes[t1classId], d_nodes[t2classId], TNode::null());
       d_masterEqualityEngine->propagate();
     }
@@ -2127,7 +2277,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   EqualityEngine* nonConst = const_cast<EqualityEngine*>(this);
 
   // Check for constants
-  if (d_isConstant[t1ClassId] && d_isConstant[t2ClassId] && t1ClassId != t2ClassId) {
+  if (d_nodeData[t1ClassId].d_isConstant && d_nodeData[t2ClassId].d_isConstant && t1ClassId != t2ClassId) {
     if (ensureProof) {
       nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(t1Id, t1ClassId));
       nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(t2Id, t2ClassId));
@@ -2215,7 +2365,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
   EqualityNodeId classId = eqNode.getFind();
 
   // Possibly existing set of triggers
-  TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
+  TriggerTermSetRef triggerSetRef = d_nodeData[classId].d_individualTrigger;
   if (triggerSetRef != +null_set_id && getTriggerTermSet(triggerSetRef).hasTrigger(tag)) {
     // If the term already is in the equivalence class that a tagged representative, just notify
     if (d_performNotify) {
@@ -2232,7 +2382,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
     // side of such disequalities, that have the tag on, are put in a set.
     TaggedEqualitiesSet disequalitiesToNotify;
     TheoryIdSet tags = TheoryIdSetUtil::setInsert(tag);
-    getDisequalities(!d_isConstant[classId], classId, tags, disequalitiesToNotify);
+    getDisequalities(!d_nodeData[classId].d_isConstant, classId, tags, disequalitiesToNotify);
 
     // Trigger data
     TheoryIdSet newSetTags;
@@ -2269,7 +2419,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
     d_triggerTermSetUpdates.push_back(TriggerSetUpdate(classId, triggerSetRef));
     d_triggerTermSetUpdatesSize = d_triggerTermSetUpdatesSize + 1;
     // Mark the the new set as a trigger
-    d_nodeIndividualTrigger[classId] = triggerSetRef = newTriggerTermSet(newSetTags, newSetTriggers, newSetTriggersSize);
+    d_nodeData[classId].d_individualTrigger = triggerSetRef = newTriggerTermSet(newSetTags, newSetTriggers, newSetTriggersSize);
 
     // Propagate trigger term disequalities we remembered
     Debug("equality::trigger") << d_name << "::eq::addTriggerTerm(" << t << ", " << tag << "): propagating " << disequalitiesToNotify.size() << " disequalities " << std::endl;
@@ -2280,7 +2430,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
   if (!hasTerm(t)) return false;
   EqualityNodeId classId = getEqualityNode(t).getFind();
-  TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
+  TriggerTermSetRef triggerSetRef = d_nodeData[classId].d_individualTrigger;
   return triggerSetRef != +null_set_id && getTriggerTermSet(triggerSetRef).hasTrigger(tag);
 }
 
@@ -2288,7 +2438,7 @@ bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
 TNode EqualityEngine::getTriggerTermRepresentative(TNode t, TheoryId tag) const {
   Assert(isTriggerTerm(t, tag));
   EqualityNodeId classId = getEqualityNode(t).getFind();
-  const TriggerTermSet& triggerSet = getTriggerTermSet(d_nodeIndividualTrigger[classId]);
+  const TriggerTermSet& triggerSet = getTriggerTermSet(d_nodeData[classId].d_individualTrigger);
   unsigned i = 0;
   TheoryIdSet tags = triggerSet.d_tags;
   while (TheoryIdSetUtil::setPop(tags) != tag)
@@ -2313,7 +2463,7 @@ void EqualityEngine::storeApplicationLookup(FunctionApplication& funNormalized,
     {
       enqueue(MergeCandidate(funId, d_trueId, MERGED_THROUGH_REFLEXIVITY, TNode::null()));
     }
-    else if (d_isConstant[funNormalized.d_a] && d_isConstant[funNormalized.d_b])
+    else if (d_nodeData[funNormalized.d_a].d_isConstant && d_nodeData[funNormalized.d_b].d_isConstant)
     {
       enqueue(MergeCandidate(funId, d_falseId, MERGED_THROUGH_CONSTANTS, TNode::null()));
     }
@@ -2470,9 +2620,9 @@ void EqualityEngine::getDisequalities(bool allowConstants,
   // Must be empty on input
   Assert(out.size() == 0);
   // The class we are looking for, shouldn't have any of the tags we are looking for already set
-  Assert(d_nodeIndividualTrigger[classId] == null_set_id
+  Assert(d_nodeData[classId].d_individualTrigger == null_set_id
          || TheoryIdSetUtil::setIntersection(
-                getTriggerTermSet(d_nodeIndividualTrigger[classId]).d_tags,
+                getTriggerTermSet(d_nodeData[classId].d_individualTrigger).d_tags,
                 inputTags)
                 == 0);
 
@@ -2523,9 +2673,9 @@ void EqualityEngine::getDisequalities(bool allowConstants,
           // Mark as visited
           alreadyVisited.insert(toCompareRep);
           // Get the trigger set
-          TriggerTermSetRef toCompareTriggerSetRef = d_nodeIndividualTrigger[toCompareRep];
+          TriggerTermSetRef toCompareTriggerSetRef = d_nodeData[toCompareRep].d_individualTrigger;
           // We only care if we're not both constants and there are trigger terms in the other class
-          if ((allowConstants || !d_isConstant[toCompareRep]) && toCompareTriggerSetRef != null_set_id) {
+          if ((allowConstants || !d_nodeData[toCompareRep].d_isConstant) && toCompareTriggerSetRef != null_set_id) {
             // Tags of the other gey
             TriggerTermSet& toCompareTriggerSet = getTriggerTermSet(toCompareTriggerSetRef);
             // We only care if there are things in inputTags that is also in toCompareTags
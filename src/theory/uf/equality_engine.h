@@ -164,11 +164,76 @@ private:
   /** A context-dependents count of nodes */
   context::CDO<DefaultSizeType> d_nodesCount;
 
+  /** The current modification time, see getModificationTime() */
+  uint64_t d_modTime;
+
   /** Map from ids to the applications */
   std::vector<FunctionApplicationPair> d_applications;
 
-  /** Map from ids to the equality nodes */
-  std::vector<EqualityNode> d_equalityNodes;
+  /** Reference for the trigger terms set */
+  typedef DefaultSizeType TriggerTermSetRef;
+
+  /** Null reference */
+  static const TriggerTermSetRef null_set_id = (TriggerTermSetRef)(-1);
+
+  /**
+   * The per-node data that is accessed when merging classes and propagating.
+   * It is kept in one record per node, so that visiting a class member touches
+   * a single cache line instead of one per data structure. The nodes and the
+   * applications, which are only needed when building terms and explanations,
+   * are kept separately in d_nodes and d_applications.
+   */
+  struct NodeData
+  {
+    NodeData(EqualityNodeId id)
+        : d_node(id),
+          d_triggers(null_trigger),
+          d_individualTrigger(null_set_id),
+          d_subtermsToEvaluate(0),
+          d_isConstant(false),
+          d_isEquality(false),
+          d_isInternal(true)
+    {
+    }
+    /** The equality node */
+    EqualityNode d_node;
+    /**
+     * The trigger list. The begin id changes as we merge, but the end always
+     * points to the actual end of the triggers for this node.
+     */
+    TriggerId d_triggers;
+    /** The individual trigger set, if this node is a representative */
+    TriggerTermSetRef d_individualTrigger;
+    /**
+     * For proper terms, the number of non-constant direct subterms. If we
+     * update an interpreted application to a constant, we can decrease this
+     * value. If we hit 0, we can evaluate the term.
+     */
+    unsigned d_subtermsToEvaluate;
+    /**
+     * Whether the node is a constant (constants are always representatives of
+     * their class).
+     */
+    bool d_isConstant;
+    /** Whether the node is an equality */
+    bool d_isEquality;
+    /**
+     * Whether the node is internal. An internal node is a node that
+     * corresponds to a partially currified node, for example.
+     */
+    bool d_isInternal;
+  };
+
+  /** Map from ids to the node data */
+  std::vector<NodeData> d_nodeData;
+
+  /**
+   * Map from ids to the modification time of their class, if they are
+   * representatives, see getModificationTime(TNode). This is kept apart from
+   * d_nodeData since it is not accessed when merging. Not restored on
+   * backtracking.
+   */
+  std::vector<uint64_t> d_modTimes;
 
   /** Number of asserted equalities we have so far */
   context::CDO<DefaultSizeType> d_assertedEqualitiesCount;
@@ -314,25 +379,6 @@ private:
    */
   context::CDO<DefaultSizeType> d_equalityTriggersCount;
 
-  /**
-   * Trigger lists per node. The begin id changes as we merge, but the end always points to
-   * the actual end of the triggers for this node.
-   */
-  std::vector<TriggerId> d_nodeTriggers;
-
-  /**
-   * Map from ids to whether they are constants (constants are always
-   * representatives of their class.
-   */
-  std::vector<bool> d_isConstant;
-
-  /**
-   * Map from ids of proper terms, to the number of non-constant direct subterms. If we update an interpreted
-   * application to a constant, we can decrease this value. If we hit 0, we can evaluate the term.
-   *
-   */
-  std::vector<unsigned> d_subtermsToEvaluate;
-
   /**
    * For nodes that we need to postpone evaluation.
    */
@@ -362,20 +408,9 @@ private:
    * Returns true if it's a constant
    */
   bool isConstant(EqualityNodeId id) const {
-    return d_isConstant[getEqualityNode(id).getFind()];
+    return d_nodeData[getEqualityNode(id).getFind()].d_isConstant;
   }
 
-  /**
-   * Map from ids to whether they are Boolean.
-   */
-  std::vector<bool> d_isEquality;
-
-  /**
-   * Map from ids to whether the nods is internal. An internal node is a node
-   * that corresponds to a partially currified node, for example.
-   */
-  std::vector<bool> d_isInternal;
-
   /**
    * Adds the trigger with triggerId to the beginning of the trigger list of the node with id nodeId.
    */
@@ -439,6 +474,17 @@ private:
       std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>& cache,
       EqProof* eqp) const;
 
+  /**
+   * Get an explanation of the equalities between the given pairs of ids, for
+   * when no proof is constructed. Instead of a BFS per equality, the trees of
+   * the equality graph that are visited are rooted once, so that the path
+   * between two nodes is found by walking up to their lowest common ancestor.
+   * Every edge is explained at most once, so sub-paths that are shared between
+   * the congruence steps of an explanation are walked only once.
+   */
+  void getExplanationFast(const std::vector<EqualityPair>& pairs,
+                          std::vector<TNode>& equalities) const;
+
   /**
    * Print the equality graph.
    */
@@ -500,12 +546,6 @@ private:
   /** Allocated size of the trigger term database */
   DefaultSizeType d_triggerDatabaseAllocatedSize;
 
-  /** Reference for the trigger terms set */
-  typedef DefaultSizeType TriggerTermSetRef;
-
-  /** Null reference */
-  static const TriggerTermSetRef null_set_id = (TriggerTermSetRef)(-1);
-
   /** Create new trigger term set based on the internally set information */
   TriggerTermSetRef newTriggerTermSet(TheoryIdSet newSetTags,
                                       EqualityNodeId* newSetTriggers,
@@ -546,11 +586,6 @@ private:
    */
   context::CDO<unsigned> d_triggerTermSetUpdatesSize;
 
-  /**
-   * Map from ids to the individual trigger set representatives.
-   */
-  std::vector<TriggerTermSetRef> d_nodeIndividualTrigger;
-
   typedef std::unordered_map<EqualityPair, DisequalityReasonRef, EqualityPairHashFunction> DisequalityReasonsMap;
 
   /**
@@ -673,7 +708,7 @@ private:
   /**
    * Add a kind to treat as function applications.
    * When extOperator is true, this equality engine will treat the operators of this kind
-   * as "external" e.g. not internal nodes (see d_isInternal). This means that we will
+   * as "external" e.g. not internal nodes (see NodeData::d_isInternal). This means that we will
    * consider equivalence classes containing the operators of such terms, and "hasTerm" will
    * return true.
    */
@@ -740,6 +775,20 @@ private:
    */
   TNode getRepresentative(TNode t) const;
 
+  /**
+   * Returns the current modification time. The modification time increases
+   * whenever a class is created or merged into.
+   */
+  uint64_t getModificationTime() const { return d_modTime; }
+
+  /**
+   * Returns the modification time at which the current equivalence class of
+   * t was created or last merged into. Since the times are not restored on
+   * backtracking, the class of t is guaranteed to be unchanged since time m
+   * if getModificationTime(t) <= m and no backtracking happened since then.
+   */
+  uint64_t getModificationTime(TNode t) const;
+
   /**
    * Add all the terms where the given term appears as a first child
    * (directly or implicitly).
@@ -10,33 +10,56 @@
  * directory for licensing information.
  * ****************************************************************************
  *
- * A fixed-size bit-vector, implemented as a wrapper around Integer.
+ * A fixed-size bit-vector, implemented as a machine word or as a wrapper
+ * around Integer.
  */
 
 #include "util/bitvector.h"
 
+#include <functional>
+
+#include "base/check.h"
 #include "base/exception.h"
 
 namespace cvc5 {
 
 unsigned BitVector::getSize() const { return d_size; }
 
-const Integer& BitVector::getValue() const { return d_value; }
+Integer BitVector::getValue() const { return toInteger(); }
 
-Integer BitVector::toInteger() const { return d_value; }
+Integer BitVector::toInteger() const
+{
+  return isWord() ? Integer(d_word) : *d_wide;
+}
 
 Integer BitVector::toSignedInteger() const
 {
+  if (isWord())
+  {
+    return d_size == 0 ? Integer(0) : Integer(toSignedWord());
+  }
   unsigned size = d_size;
-  Integer sign_bit = d_value.extractBitRange(1, size - 1);
-  Integer val = d_value.extractBitRange(size - 1, 0);
+  Integer sign_bit = d_wide->extractBitRange(1, size - 1);
+  Integer val = d_wide->extractBitRange(size - 1, 0);
   Integer res = Integer(-1) * sign_bit.multiplyByPow2(size - 1) + val;
   return res;
 }
 
 std::string BitVector::toString(unsigned int base) const
 {
-  std::string str = d_value.toString(base);
+  if (isWord() && base == 2 && d_size > 0)
+  {
+    std::string str(d_size, '0');
+    for (unsigned i = 0; i < d_size; ++i)
+    {
+      if ((d_word >> i) & 1)
+      {
+        str[d_size - 1 - i] = '1';
+      }
+    }
+    return str;
+  }
+  std::string str = toInteger().toString(base);
   if (base == 2 && d_size > str.size())
   {
     std::string zeroes;
@@ -54,25 +77,88 @@ std::string BitVector::toString(unsigned int base) const
 
 size_t BitVector::hash() const
 {
-  return d_value.hash() + d_size;
+  if (isWord())
+  {
+    return std::hash<uint64_t>()(d_word) + d_size;
+  }
+  return d_wide->hash() + d_size;
 }
 
 BitVector& BitVector::setBit(uint32_t i, bool value)
 {
   CheckArgument(i < d_size, i);
-  d_value.setBit(i, value);
+  if (isWord())
+  {
+    if (value)
+    {
+      d_word |= uint64_t(1) << i;
+    }
+    else
+    {
+      d_word &= ~(uint64_t(1) << i);
+    }
+  }
+  else
+  {
+    d_wide->setBit(i, value);
+  }
   return *this;
 }
 
 bool BitVector::isBitSet(uint32_t i) const
 {
   CheckArgument(i < d_size, i);
-  return d_value.isBitSet(i);
+  if (isWord())
+  {
+    return (d_word >> i) & 1;
+  }
+  return d_wide->isBitSet(i);
 }
 
 unsigned BitVector::isPow2() const
 {
-  return d_value.isPow2();
+  if (isWord())
+  {
+    if (d_word == 0 || (d_word & (d_word - 1)) != 0)
+    {
+      return 0;
+    }
+    unsigned k = 1;
+    for (uint64_t w = d_word; w > 1; w >>= 1)
+    {
+      ++k;
+    }
+    return k;
+  }
+  return d_wide->isPow2();
+}
+
+int64_t BitVector::toSignedWord() const
+{
+  Assert(isWord() && d_size > 0);
+  unsigned shift = s_wordSize - d_size;
+  return static_cast<int64_t>(d_word << shift) >> shift;
+}
+
+void BitVector::setValue(const Integer& val)
+{
+  Integer v = val.modByPow2(d_size);
+  if (!isWord())
+  {
+    d_wide.reset(new Integer(v));
+    d_word = 0;
+    return;
+  }
+  d_wide.reset();
+  if (sizeof(unsigned long) >= sizeof(uint64_t))
+  {
+    d_word = v.getUnsignedLong();
+  }
+  else
+  {
+    d_word = (uint64_t(v.extractBitRange(32, 32).toUnsignedInt()) << 32)
+             | v.extractBitRange(32, 0).toUnsignedInt();
+  }
 }
 
 /* -----------------------------------------------------------------------
@@ -83,16 +169,26 @@ unsigned BitVector::isPow2() const
 
 BitVector BitVector::concat(const BitVector& other) const
 {
-  return BitVector(d_size + other.d_size,
-                   (d_value.multiplyByPow2(other.d_size)) + other.d_value);
+  unsigned size = d_size + other.d_size;
+  if (size <= s_wordSize)
+  {
+    uint64_t hi = other.d_size == s_wordSize ? 0 : d_word << other.d_size;
+    return BitVector(size, hi | other.d_word);
+  }
+  return BitVector(
+      size, (toInteger().multiplyByPow2(other.d_size)) + other.toInteger());
 }
 
 BitVector BitVector::extract(unsigned high, unsigned low) const
 {
   CheckArgument(high < d_size, high);
   CheckArgument(low <= high, low);
+  if (isWord())
+  {
+    return BitVector(high - low + 1, d_word >> low);
+  }
   return BitVector(high - low + 1,
-                   d_value.extractBitRange(high - low + 1, low));
+                   d_wide->extractBitRange(high - low + 1, low));
 }
 
 /* (Dis)Equality --------------------------------------------------------- */
@@ -100,51 +196,50 @@ BitVector BitVector::extract(unsigned high, unsigned low) const
 bool BitVector::operator==(const BitVector& y) const
 {
   if (d_size != y.d_size) return false;
-  return d_value == y.d_value;
+  return isWord() ? d_word == y.d_word : *d_wide == *y.d_wide;
 }
 
 bool BitVector::operator!=(const BitVector& y) const
 {
-  if (d_size != y.d_size) return true;
-  return d_value != y.d_value;
+  return !(*this == y);
 }
 
 /* Unsigned Inequality --------------------------------------------------- */
 
 bool BitVector::operator<(const BitVector& y) const
 {
-  return d_value < y.d_value;
+  if (isWord() && y.isWord())
+  {
+    return d_word < y.d_word;
+  }
+  return toInteger() < y.toInteger();
 }
 
 bool BitVector::operator<=(const BitVector& y) const
 {
-  return d_value <= y.d_value;
+  return !(y < *this);
 }
 
 bool BitVector::operator>(const BitVector& y) const
 {
-  return d_value > y.d_value;
+  return y < *this;
 }
 
 bool BitVector::operator>=(const BitVector& y) const
 {
-  return d_value >= y.d_value;
+  return !(*this < y);
 }
 
 bool BitVector::unsignedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value < y.d_value;
+  return *this < y;
 }
 
 bool BitVector::unsignedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, this);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
-  return d_value <= y.d_value;
+  return *this <= y;
 }
 
 /* Signed Inequality ----------------------------------------------------- */
@@ -152,8 +247,10 @@ bool BitVector::unsignedLessThanEq(const BitVector& y) const
 bool BitVector::signedLessThan(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isWord())
+  {
+    return d_size > 0 && toSignedWord() < y.toSignedWord();
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -163,8 +260,10 @@ bool BitVector::signedLessThan(const BitVector& y) const
 bool BitVector::signedLessThanEq(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value >= 0, y);
+  if (isWord())
+  {
+    return d_size == 0 || toSignedWord() <= y.toSignedWord();
+  }
   Integer a = (*this).toSignedInteger();
   Integer b = y.toSignedInteger();
 
@@ -176,24 +275,40 @@ bool BitVector::signedLessThanEq(const BitVector& y) const
 BitVector BitVector::operator^(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseXor(y.d_value));
+  if (isWord())
+  {
+    return BitVector(d_size, d_word ^ y.d_word);
+  }
+  return BitVector(d_size, d_wide->bitwiseXor(*y.d_wide));
 }
 
 BitVector BitVector::operator|(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseOr(y.d_value));
+  if (isWord())
+  {
+    return BitVector(d_size, d_word | y.d_word);
+  }
+  return BitVector(d_size, d_wide->bitwiseOr(*y.d_wide));
 }
 
 BitVector BitVector::operator&(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  return BitVector(d_size, d_value.bitwiseAnd(y.d_value));
+  if (isWord())
+  {
+    return BitVector(d_size, d_word & y.d_word);
+  }
+  return BitVector(d_size, d_wide->bitwiseAnd(*y.d_wide));
 }
 
 BitVector BitVector::operator~() const
 {
-  return BitVector(d_size, d_value.bitwiseNot());
+  if (isWord())
+  {
+    return BitVector(d_size, ~d_word);
+  }
+  return BitVector(d_size, d_wide->bitwiseNot());
 }
 
 /* Arithmetic operations ------------------------------------------------- */
@@ -201,13 +316,21 @@ BitVector BitVector::operator~() const
 BitVector BitVector::operator+(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  Integer sum = d_value + y.d_value;
+  if (isWord())
+  {
+    return BitVector(d_size, d_word + y.d_word);
+  }
+  Integer sum = *d_wide + *y.d_wide;
   return BitVector(d_size, sum);
 }
 
 BitVector BitVector::operator-(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    return BitVector(d_size, d_word - y.d_word);
+  }
   // to maintain the invariant that we are only adding BitVectors of the
   // same size
   BitVector one(d_size, Integer(1));
@@ -216,6 +339,10 @@ BitVector BitVector::operator-(const BitVector& y) const
 
 BitVector BitVector::operator-() const
 {
+  if (isWord())
+  {
+    return BitVector(d_size, uint64_t(0) - d_word);
+  }
   BitVector one(d_size, Integer(1));
   return ~(*this) + one;
 }
@@ -223,50 +350,73 @@ BitVector BitVector::operator-() const
 BitVector BitVector::operator*(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  Integer prod = d_value * y.d_value;
+  if (isWord())
+  {
+    return BitVector(d_size, d_word * y.d_word);
+  }
+  Integer prod = *d_wide * *y.d_wide;
   return BitVector(d_size, prod);
 }
 
 BitVector BitVector::unsignedDivTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
+  if (isWord())
+  {
+    /* d_word / 0 = -1 = 2^d_size - 1 */
+    return BitVector(d_size,
+                     y.d_word == 0 ? ~uint64_t(0) : d_word / y.d_word);
+  }
   /* d_value / 0 = -1 = 2^d_size - 1 */
-  if (y.d_value == 0)
+  if (y.d_wide->isZero())
   {
     return BitVector(d_size, Integer(1).oneExtend(1, d_size - 1));
   }
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value > 0, y);
-  return BitVector(d_size, d_value.floorDivideQuotient(y.d_value));
+  CheckArgument(*d_wide >= 0, this);
+  CheckArgument(*y.d_wide > 0, y);
+  return BitVector(d_size, d_wide->floorDivideQuotient(*y.d_wide));
 }
 
 BitVector BitVector::unsignedRemTotal(const BitVector& y) const
 {
   CheckArgument(d_size == y.d_size, y);
-  if (y.d_value == 0)
+  if (isWord())
   {
-    return BitVector(d_size, d_value);
+    return BitVector(d_size, y.d_word == 0 ? d_word : d_word % y.d_word);
   }
-  CheckArgument(d_value >= 0, this);
-  CheckArgument(y.d_value > 0, y);
-  return BitVector(d_size, d_value.floorDivideRemainder(y.d_value));
+  if (y.d_wide->isZero())
+  {
+    return *this;
+  }
+  CheckArgument(*d_wide >= 0, this);
+  CheckArgument(*y.d_wide > 0, y);
+  return BitVector(d_size, d_wide->floorDivideRemainder(*y.d_wide));
 }
 
 /* Extend operations ----------------------------------------------------- */
 
 BitVector BitVector::zeroExtend(unsigned n) const
 {
-  return BitVector(d_size + n, d_value);
+  if (d_size + n <= s_wordSize)
+  {
+    return BitVector(d_size + n, d_word);
+  }
+  return BitVector(d_size + n, toInteger());
 }
 
 BitVector BitVector::signExtend(unsigned n) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
+  if (d_size + n <= s_wordSize)
+  {
+    return BitVector(d_size + n, static_cast<uint64_t>(toSignedWord()));
+  }
+  Integer value = toInteger();
+  Integer sign_bit = value.extractBitRange(1, d_size - 1);
   if (sign_bit == Integer(0))
   {
-    return BitVector(d_size + n, d_value);
+    return BitVector(d_size + n, value);
   }
-  Integer val = d_value.oneExtend(d_size, n);
+  Integer val = value.oneExtend(d_size, n);
   return BitVector(d_size + n, val);
 }
 
@@ -274,38 +424,61 @@ BitVector BitVector::signExtend(unsigned n) const
 
 BitVector BitVector::leftShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isWord() && y.isWord())
+  {
+    return y.d_word >= d_size ? BitVector(d_size)
+                              : BitVector(d_size, d_word << y.d_word);
+  }
+  Integer amount_value = y.toInteger();
+  if (amount_value > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
-  if (y.d_value == 0)
+  if (amount_value == 0)
   {
     return *this;
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.multiplyByPow2(amount);
+  CheckArgument(amount_value < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = amount_value.toUnsignedInt();
+  Integer res = toInteger().multiplyByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::logicalRightShift(const BitVector& y) const
 {
-  if (y.d_value > Integer(d_size))
+  if (isWord() && y.isWord())
+  {
+    return y.d_word >= d_size ? BitVector(d_size)
+                              : BitVector(d_size, d_word >> y.d_word);
+  }
+  Integer amount_value = y.toInteger();
+  if (amount_value > Integer(d_size))
   {
     return BitVector(d_size, Integer(0));
   }
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer res = d_value.divByPow2(amount);
+  CheckArgument(amount_value < Integer(1).multiplyByPow2(32), y);
+  uint32_t amount = amount_value.toUnsignedInt();
+  Integer res = toInteger().divByPow2(amount);
   return BitVector(d_size, res);
 }
 
 BitVector BitVector::arithRightShift(const BitVector& y) const
 {
-  Integer sign_bit = d_value.extractBitRange(1, d_size - 1);
-  if (y.d_value > Integer(d_size))
+  if (isWord() && y.isWord())
+  {
+    int64_t value = toSignedWord();
+    if (y.d_word >= d_size)
+    {
+      return BitVector(d_size, static_cast<uint64_t>(value < 0 ? -1 : 0));
+    }
+    return BitVector(d_size, static_cast<uint64_t>(value >> y.d_word));
+  }
+  Integer value = toInteger();
+  Integer amount_value = y.toInteger();
+  Integer sign_bit = value.extractBitRange(1, d_size - 1);
+  if (amount_value > Integer(d_size))
   {
     if (sign_bit == Integer(0))
     {
@@ -317,16 +490,16 @@ BitVector BitVector::arithRightShift(const BitVector& y) const
     }
   }
 
-  if (y.d_value == 0)
+  if (amount_value == 0)
   {
     return *this;
   }
 
   // making sure we don't lose information casting
-  CheckArgument(y.d_value < Integer(1).multiplyByPow2(32), y);
+  CheckArgument(amount_value < Integer(1).multiplyByPow2(32), y);
 
-  uint32_t amount = y.d_value.toUnsignedInt();
-  Integer rest = d_value.divByPow2(amount);
+  uint32_t amount = amount_value.toUnsignedInt();
+  Integer rest = value.divByPow2(amount);
 
   if (sign_bit == Integer(0))
   {
@@ -355,6 +528,10 @@ BitVector BitVector::mkOne(unsigned size)
 BitVector BitVector::mkOnes(unsigned size)
 {
   CheckArgument(size > 0, size);
+  if (size <= s_wordSize)
+  {
+    return BitVector(size, ~uint64_t(0));
+  }
   return BitVector(1, Integer(1)).signExtend(size - 1);
 }
 
@@ -10,7 +10,8 @@
  * directory for licensing information.
  * ****************************************************************************
  *
- * A fixed-size bit-vector, implemented as a wrapper around Integer.
+ * A fixed-size bit-vector, implemented as a machine word or as a wrapper
+ * around Integer.
  */
 
 #include "cvc5_public.h"
@@ -18,8 +19,10 @@
 #ifndef CVC5__BITVECTOR_H
 #define CVC5__BITVECTOR_H
 
+#include <cstdint>
 #include <iosfwd>
 #include <iostream>
+#include <memory>
 
 #include "base/exception.h"
 #include "util/integer.h"
@@ -29,12 +32,18 @@ namespace cvc5 {
 class BitVector
 {
  public:
-  BitVector(unsigned size, const Integer& val)
-      : d_size(size), d_value(val.modByPow2(size))
+  BitVector(unsigned size, const Integer& val) : d_size(size), d_word(0)
   {
+    setValue(val);
   }
 
-  BitVector(unsigned size = 0) : d_size(size), d_value(0) {}
+  BitVector(unsigned size = 0) : d_size(size), d_word(0)
+  {
+    if (!isWord())
+    {
+      d_wide.reset(new Integer(0));
+    }
+  }
 
   /**
    * BitVector constructor using a 32-bit unsigned integer for the value.
@@ -43,10 +52,7 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint32_t z) : d_size(size), d_value(z)
-  {
-    d_value = d_value.modByPow2(size);
-  }
+  BitVector(unsigned size, uint32_t z) : BitVector(size, uint64_t(z)) {}
 
   /**
    * BitVector constructor using a 64-bit unsigned integer for the value.
@@ -55,14 +61,32 @@ class BitVector
    * platforms (long is 32-bit when compiling 64-bit binaries on
    * Windows but 64-bit on Linux) and to prevent ambiguous overloads.
    */
-  BitVector(unsigned size, uint64_t z) : d_size(size), d_value(z)
+  BitVector(unsigned size, uint64_t z) : d_size(size), d_word(0)
   {
-    d_value = d_value.modByPow2(size);
+    if (isWord())
+    {
+      d_word = z & wordMask(size);
+    }
+    else
+    {
+      d_wide.reset(new Integer(z));
+    }
   }
 
-  BitVector(unsigned size, const BitVector& q)
-      : d_size(size), d_value(q.d_value)
+  /**
+   * BitVector constructor using the value of 'q', truncated to 'size' bits if
+   * 'q' is wider.
+   */
+  BitVector(unsigned size, const BitVector& q) : d_size(size), d_word(0)
   {
+    if (isWord() && q.isWord())
+    {
+      d_word = q.d_word & wordMask(size);
+    }
+    else
+    {
+      setValue(q.toInteger());
+    }
   }
 
   /**
@@ -78,16 +102,33 @@ class BitVector
    * @param num The value of the bit-vector in string representation.
    * @param base The base of the string representation.
    */
-  BitVector(const std::string& num, unsigned base = 2)
+  BitVector(const std::string& num, unsigned base = 2) : d_word(0)
   {
     CheckArgument(base == 2 || base == 10 || base == 16, base);
-    d_value = Integer(num, base);
+    Integer val(num, base);
     switch (base)
     {
-      case 10: d_size = d_value.length(); break;
+      case 10: d_size = val.length(); break;
       case 16: d_size = num.size() * 4; break;
       default: d_size = num.size();
     }
+    setValue(val);
+  }
+
+  BitVector(const BitVector& x) : d_size(x.d_size), d_word(x.d_word)
+  {
+    if (!x.isWord())
+    {
+      d_wide.reset(new Integer(*x.d_wide));
+    }
+  }
+
+  /* The moved-from bit-vector is left as the bit-vector of size 0. */
+  BitVector(BitVector&& x)
+      : d_size(x.d_size), d_word(x.d_word), d_wide(std::move(x.d_wide))
+  {
+    x.d_size = 0;
+    x.d_word = 0;
   }
 
   ~BitVector() {}
@@ -96,14 +137,34 @@ class BitVector
   {
     if (this == &x) return *this;
     d_size = x.d_size;
-    d_value = x.d_value;
+    d_word = x.d_word;
+    if (!x.isWord())
+    {
+      d_wide.reset(new Integer(*x.d_wide));
+    }
+    else
+    {
+      d_wide.reset();
+    }
+    return *this;
+  }
+
+  /* The moved-from bit-vector is left as the bit-vector of size 0. */
+  BitVector& operator=(BitVector&& x)
+  {
+    if (this == &x) return *this;
+    d_size = x.d_size;
+    d_word = x.d_word;
+    d_wide = std::move(x.d_wide);
+    x.d_size = 0;
+    x.d_word = 0;
     return *this;
   }
 
   /* Get size (bit-width). */
   unsigned getSize() const;
   /* Get value. */
-  const Integer& getValue() const;
+  Integer getValue() const;
 
   /* Return value. */
   Integer toInteger() const;
@@ -263,14 +324,39 @@ class BitVector
   static BitVector mkMaxSigned(unsigned size);
 
  private:
+  /**
+   * Bit-vectors of size up to s_wordSize store their value in d_word, which
+   * avoids the cost of arbitrary-precision arithmetic for the common case.
+   * Wider bit-vectors store their value in d_wide.
+   */
+  static constexpr unsigned s_wordSize = 64;
+
+  /* Return true if the value of this is stored in d_word. */
+  bool isWord() const { return d_size <= s_wordSize; }
+
+  /* Return the mask of the lower 'size' bits of a word, size <= 64. */
+  static uint64_t wordMask(unsigned size)
+  {
+    return size >= s_wordSize ? ~uint64_t(0) : (uint64_t(1) << size) - 1;
+  }
+
+  /* Return the two's complement interpretation of d_word, isWord() holds. */
+  int64_t toSignedWord() const;
+
+  /* Set the value of this to 'val' modulo 2^d_size. */
+  void setValue(const Integer& val);
+
   /**
    * Class invariants:
-   *  - no overflows: 2^d_size < d_value
-   *  - no negative numbers: d_value >= 0
+   *  - d_wide is set if and only if d_size > s_wordSize
+   *  - no overflows: d_word < 2^d_size, and d_wide < 2^d_size
+   *  - no negative numbers: d_wide >= 0
+   *  - d_word is zero if d_size > s_wordSize
    */
 
   unsigned d_size;
-  Integer d_value;
+  uint64_t d_word;
+  std::unique_ptr<Integer> d_wide;
 
 }; /* class BitVector */
 
@@ -194,6 +194,38 @@ uint64_t ResourceManager::getResourceRemaining() const
   return d_options[options::cumulativeResourceLimit] - d_cumulativeResourceUsed;
 }
 
+uint64_t ResourceManager::getResourceRemainingThisCall() const
+{
+  uint64_t remaining = 0;
+  uint64_t perCall = d_options[options::perCallResourceLimit];
+  if (perCall > 0)
+  {
+    remaining = perCall > d_thisCallResourceUsed
+                    ? perCall - d_thisCallResourceUsed
+                    : 1;
+  }
+  if (d_options[options::cumulativeResourceLimit] > 0)
+  {
+    uint64_t cumulative = std::max<uint64_t>(getResourceRemaining(), 1);
+    if (remaining == 0 || cumulative < remaining)
+    {
+      remaining = cumulative;
+    }
+  }
+  return remaining;
+}
+
+uint64_t ResourceManager::getTimeRemainingThisCall() const
+{
+  uint64_t limit = d_options[options::perCallMillisecondLimit];
+  if (limit == 0)
+  {
+    return 0;
+  }
+  uint64_t elapsed = d_perCallTimer.elapsed();
+  return elapsed < limit ? limit - elapsed : 1;
+}
+
 void ResourceManager::spendResource(uint64_t amount)
 {
   ++d_statistics->d_spendResourceCalls;
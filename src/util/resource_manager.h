@@ -143,6 +143,17 @@ class ResourceManager
   uint64_t getTimeUsage() const;
   /** Retrieves the remaining number of cumulative resources. */
   uint64_t getResourceRemaining() const;
+  /**
+   * Retrieves the remaining number of resources in this call, i.e. the
+   * minimum of the remaining per-call and cumulative resources. Returns 0 if
+   * there is no resource limit, and at least 1 otherwise.
+   */
+  uint64_t getResourceRemainingThisCall() const;
+  /**
+   * Retrieves the remaining number of milliseconds in this call. Returns 0 if
+   * there is no per-call time limit, and at least 1 otherwise.
+   */
+  uint64_t getTimeRemainingThisCall() const;
 
   /**
    * Spends a given resource. Throws an UnsafeInterruptException if there are
@@ -154,6 +165,12 @@ class ResourceManager
    * no remaining resources.
    */
   void spendResource(theory::InferenceId iid);
+  /**
+   * Spends the given number of resource units, for example those used by a
+   * subsolver. Throws an UnsafeInterruptException if there are no remaining
+   * resources.
+   */
+  void spendResource(uint64_t amount);
 
   /**
    * Resets perCall limits to mark the start of a new call,
@@ -195,8 +212,6 @@ class ResourceManager
   /** Receives a notification on reaching a limit. */
   std::vector<Listener*> d_listeners;
 
-  void spendResource(uint64_t amount);
-
   /** Weights for InferenceId resources */
   std::array<uint64_t, resman_detail::InferenceIdMax + 1> d_infidWeights;
   /** Weights for Resource resources */
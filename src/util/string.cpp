@@ -17,6 +17,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -30,7 +31,89 @@ namespace cvc5 {
 
 static_assert(UCHAR_MAX == 255, "Unsigned char is assumed to have 256 values.");
 
-String::String(const std::vector<unsigned> &s) : d_str(s)
+namespace {
+
+/*
+ * The kernels below compare and search blocks of code points with memcmp
+ * and memchr-style loops that the C library and the compiler vectorize,
+ * instead of comparing the code points one by one.
+ */
+
+/** Returns true if the first n code points of a and b are equal */
+bool equalCodes(const unsigned* a, const unsigned* b, size_t n)
+{
+  return n == 0 || std::memcmp(a, b, n * sizeof(unsigned)) == 0;
+}
+
+/** Returns the first index at which a and b differ, or n if there is none */
+size_t mismatchCodes(const unsigned* a, const unsigned* b, size_t n)
+{
+  // skip equal blocks with memcmp, then find the mismatch in the block
+  const size_t block = 64;
+  size_t i = 0;
+  while (i + block <= n && equalCodes(a + i, b + i, block))
+  {
+    i += block;
+  }
+  while (i < n && a[i] == b[i])
+  {
+    i++;
+  }
+  return i;
+}
+
+/**
+ * Returns the first position at least start of pattern p of length m in text
+ * t of length n, or std::string::npos.
+ */
+size_t findCodes(
+    const unsigned* t, size_t n, const unsigned* p, size_t m, size_t start)
+{
+  Assert(m > 0 && start + m <= n);
+  size_t last = m - 1;
+  if (m < 4 || n - start < 256)
+  {
+    // scan for the first code point and compare the rest
+    const unsigned* end = t + n - last;
+    for (const unsigned* cur = std::find(t + start, end, p[0]); cur != end;
+         cur = std::find(cur + 1, end, p[0]))
+    {
+      if (equalCodes(cur + 1, p + 1, last))
+      {
+        return cur - t;
+      }
+    }
+    return std::string::npos;
+  }
+  // Horspool's algorithm, where the shift table is indexed by the low byte
+  // of the code points. The shift of a byte is the minimal shift of the code
+  // points with that low byte, which is safe.
+  size_t shift[256];
+  std::fill(shift, shift + 256, m);
+  for (size_t j = 0; j < last; j++)
+  {
+    shift[p[j] & 0xff] = last - j;
+  }
+  for (size_t pos = start; pos + m <= n; pos += shift[t[pos + last] & 0xff])
+  {
+    if (t[pos + last] == p[last] && equalCodes(t + pos, p, last))
+    {
+      return pos;
+    }
+  }
+  return std::string::npos;
+}
+
+}  // namespace
+
+String::String(const std::vector<unsigned>& s) : d_str(s) { checkCodePoints(); }
+
+String::String(std::vector<unsigned>&& s) : d_str(std::move(s))
+{
+  checkCodePoints();
+}
+
+void String::checkCodePoints() const
 {
 #ifdef CVC5_ASSERTIONS
   for (unsigned u : d_str)
@@ -44,20 +127,20 @@ int String::cmp(const String &y) const {
   if (size() != y.size()) {
     return size() < y.size() ? -1 : 1;
   }
-  for (unsigned int i = 0; i < size(); ++i) {
-    if (d_str[i] != y.d_str[i]) {
-      unsigned cp = d_str[i];
-      unsigned cpy = y.d_str[i];
-      return cp < cpy ? -1 : 1;
-    }
+  size_t i = mismatchCodes(d_str.data(), y.d_str.data(), size());
+  if (i < size())
+  {
+    return d_str[i] < y.d_str[i] ? -1 : 1;
   }
   return 0;
 }
 
 String String::concat(const String &other) const {
-  std::vector<unsigned int> ret_vec(d_str);
+  std::vector<unsigned int> ret_vec;
+  ret_vec.reserve(size() + other.size());
+  ret_vec.insert(ret_vec.end(), d_str.begin(), d_str.end());
   ret_vec.insert(ret_vec.end(), other.d_str.begin(), other.d_str.end());
-  return String(ret_vec);
+  return String(std::move(ret_vec));
 }
 
 bool String::strncmp(const String& y, std::size_t n) const
@@ -71,10 +154,7 @@ bool String::strncmp(const String& y, std::size_t n) const
       return false;
     }
   }
-  for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[i] != y.d_str[i]) return false;
-  }
-  return true;
+  return equalCodes(d_str.data(), y.d_str.data(), n);
 }
 
 bool String::rstrncmp(const String& y, std::size_t n) const
@@ -88,10 +168,8 @@ bool String::rstrncmp(const String& y, std::size_t n) const
       return false;
     }
   }
-  for (std::size_t i = 0; i < n; ++i) {
-    if (d_str[size() - i - 1] != y.d_str[y.size() - i - 1]) return false;
-  }
-  return true;
+  return equalCodes(
+      d_str.data() + size() - n, y.d_str.data() + y.size() - n, n);
 }
 
 void String::addCharToInternal(unsigned char ch, std::vector<unsigned>& str)
@@ -249,29 +327,45 @@ unsigned String::back() const
 }
 
 std::size_t String::overlap(const String &y) const {
-  std::size_t i = size() < y.size() ? size() : y.size();
-  for (; i > 0; i--) {
-    String s = suffix(i);
-    String p = y.prefix(i);
-    if (s == p) {
-      return i;
+  // Run the Knuth-Morris-Pratt automaton of the prefix of y of length n on
+  // the suffix of this string of length n. Its final state is the length of
+  // the longest suffix of this string that is a prefix of y.
+  std::size_t n = size() < y.size() ? size() : y.size();
+  if (n == 0)
+  {
+    return 0;
+  }
+  const unsigned* p = y.d_str.data();
+  std::vector<std::size_t> fail(n, 0);
+  for (std::size_t i = 1, k = 0; i < n; i++)
+  {
+    while (k > 0 && p[i] != p[k])
+    {
+      k = fail[k - 1];
     }
+    if (p[i] == p[k])
+    {
+      k++;
+    }
+    fail[i] = k;
   }
-  return i;
-}
-
-std::size_t String::roverlap(const String &y) const {
-  std::size_t i = size() < y.size() ? size() : y.size();
-  for (; i > 0; i--) {
-    String s = prefix(i);
-    String p = y.suffix(i);
-    if (s == p) {
-      return i;
+  std::size_t q = 0;
+  for (std::size_t i = size() - n, s = size(); i < s; i++)
+  {
+    while (q > 0 && (q == n || d_str[i] != p[q]))
+    {
+      q = fail[q - 1];
+    }
+    if (d_str[i] == p[q])
+    {
+      q++;
     }
   }
-  return i;
+  return q;
 }
 
+std::size_t String::roverlap(const String &y) const { return y.overlap(*this); }
+
 std::string String::toString(bool useEscSequences) const {
   std::stringstream str;
   for (unsigned int i = 0; i < size(); ++i) {
@@ -304,31 +398,23 @@ std::wstring String::toWString() const
 
 bool String::isLeq(const String &y) const
 {
-  for (unsigned i = 0; i < size(); ++i)
+  size_t n = size() < y.size() ? size() : y.size();
+  size_t i = mismatchCodes(d_str.data(), y.d_str.data(), n);
+  if (i < n)
   {
-    if (i >= y.size())
-    {
-      return false;
-    }
-    unsigned ci = d_str[i];
-    unsigned cyi = y.d_str[i];
-    if (ci > cyi)
-    {
-      return false;
-    }
-    if (ci < cyi)
-    {
-      return true;
-    }
+    return d_str[i] < y.d_str[i];
   }
-  return true;
+  return size() <= y.size();
 }
 
 bool String::isRepeated() const {
   if (size() > 1) {
     unsigned int f = d_str[0];
-    for (unsigned i = 1; i < size(); ++i) {
-      if (f != d_str[i]) return false;
+    if (std::find_if(
+            d_str.begin() + 1, d_str.end(), [f](unsigned c) { return c != f; })
+        != d_str.end())
+    {
+      return false;
     }
   }
   return true;
@@ -354,12 +440,7 @@ std::size_t String::find(const String &y, const std::size_t start) const {
   if (y.empty()) return start;
   if (empty()) return std::string::npos;
 
-  std::vector<unsigned>::const_iterator itr = std::search(
-      d_str.begin() + start, d_str.end(), y.d_str.begin(), y.d_str.end());
-  if (itr != d_str.end()) {
-    return itr - d_str.begin();
-  }
-  return std::string::npos;
+  return findCodes(d_str.data(), size(), y.d_str.data(), y.size(), start);
 }
 
 std::size_t String::rfind(const String &y, const std::size_t start) const {
@@ -383,14 +464,7 @@ bool String::hasPrefix(const String& y) const
   {
     return false;
   }
-  for (size_t i = 0; i < ys; i++)
-  {
-    if (d_str[i] != y.d_str[i])
-    {
-      return false;
-    }
-  }
-  return true;
+  return equalCodes(d_str.data(), y.d_str.data(), ys);
 }
 
 bool String::hasSuffix(const String& y) const
@@ -401,22 +475,16 @@ bool String::hasSuffix(const String& y) const
   {
     return false;
   }
-  size_t idiff = s - ys;
-  for (size_t i = 0; i < ys; i++)
-  {
-    if (d_str[i + idiff] != y.d_str[i])
-    {
-      return false;
-    }
-  }
-  return true;
+  return equalCodes(d_str.data() + s - ys, y.d_str.data(), ys);
 }
 
 String String::update(std::size_t i, const String& t) const
 {
   if (i < size())
   {
-    std::vector<unsigned> vec(d_str.begin(), d_str.begin() + i);
+    std::vector<unsigned> vec;
+    vec.reserve(size());
+    vec.insert(vec.end(), d_str.begin(), d_str.begin() + i);
     size_t remNum = size() - i;
     size_t tnum = t.d_str.size();
     if (tnum >= remNum)
@@ -428,7 +496,7 @@ String String::update(std::size_t i, const String& t) const
       vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
       vec.insert(vec.end(), d_str.begin() + i + tnum, d_str.end());
     }
-    return String(vec);
+    return String(std::move(vec));
   }
   return *this;
 }
@@ -437,10 +505,11 @@ String String::replace(const String &s, const String &t) const {
   std::size_t ret = find(s);
   if (ret != std::string::npos) {
     std::vector<unsigned> vec;
-    vec.insert(vec.begin(), d_str.begin(), d_str.begin() + ret);
+    vec.reserve(size() - s.size() + t.size());
+    vec.insert(vec.end(), d_str.begin(), d_str.begin() + ret);
     vec.insert(vec.end(), t.d_str.begin(), t.d_str.end());
     vec.insert(vec.end(), d_str.begin() + ret + s.size(), d_str.end());
-    return String(vec);
+    return String(std::move(vec));
   } else {
     return *this;
   }
@@ -448,18 +517,13 @@ String String::replace(const String &s, const String &t) const {
 
 String String::substr(std::size_t i) const {
   Assert(i <= size());
-  std::vector<unsigned> ret_vec;
-  std::vector<unsigned>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, d_str.end());
-  return String(ret_vec);
+  return String(std::vector<unsigned>(d_str.begin() + i, d_str.end()));
 }
 
 String String::substr(std::size_t i, std::size_t j) const {
   Assert(i + j <= size());
-  std::vector<unsigned> ret_vec;
   std::vector<unsigned>::const_iterator itr = d_str.begin() + i;
-  ret_vec.insert(ret_vec.end(), itr, itr + j);
-  return String(ret_vec);
+  return String(std::vector<unsigned>(itr, itr + j));
 }
 
 bool String::noOverlapWith(const String& y) const
@@ -20,6 +20,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "util/rational.h"
@@ -74,6 +75,7 @@ class String
   {
   }
   explicit String(const std::vector<unsigned>& s);
+  explicit String(std::vector<unsigned>&& s);
 
   String& operator=(const String& y) {
     if (this != &y) {
@@ -259,6 +261,9 @@ class String
    */
   int cmp(const String& y) const;
 
+  /** Check that the code points of d_str are in range (in debug builds) */
+  void checkCodePoints() const;
+
   std::vector<unsigned> d_str;
 }; /* class String */
 
@@ -268,7 +273,11 @@ struct StringHashFunction
 {
   size_t operator()(const ::cvc5::String& s) const
   {
-    return std::hash<std::string>()(s.toString());
+    // hash the code points directly, without converting them to a string
+    const std::vector<unsigned>& vec = s.getVec();
+    return std::hash<std::string_view>()(
+        std::string_view(reinterpret_cast<const char*>(vec.data()),
+                         vec.size() * sizeof(unsigned)));
   }
 }; /* struct StringHashFunction */
 
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --arith-cuts
+; COMMAND-LINE: --arith-cuts --arith-cuts-mir-mult=1 --arith-cuts-ratio=1
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (<= 0 x 3))
+(assert (<= 0 y 3))
+(assert (<= 0 z 9))
+(assert (= (+ (* 5 x) (* 7 y)) 23))
+(assert (= (+ x y z) 9))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --arrays-compact-stores
+; COMMAND-LINE: --no-arrays-compact-stores
+(set-logic QF_ABV)
+(set-info :status unsat)
+(declare-fun m () (Array (_ BitVec 8) (_ BitVec 8)))
+(declare-fun x () (_ BitVec 8))
+(declare-fun i () (_ BitVec 8))
+(define-fun m1 () (Array (_ BitVec 8) (_ BitVec 8))
+  (store (store (store (store m #x03 x) #x01 #x10) #x03 #x30) #x02 (select m #x02)))
+(define-fun m2 () (Array (_ BitVec 8) (_ BitVec 8))
+  (store (store m1 i #x00) #x01 #x11))
+(assert (not (= (bvadd (select m1 #x03) (select m2 #x01) (select m1 #x02))
+                (bvadd #x41 (select m #x02)))))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --arrays-weak-equiv
+(set-logic QF_AUFLIA)
+(set-info :status unsat)
+(declare-fun a () (Array Int Int))
+(declare-fun b () (Array Int Int))
+(declare-fun c () (Array Int Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(declare-fun k () Int)
+(declare-fun v () Int)
+(assert (= b (store (store (store a 1 v) 2 v) 3 v)))
+(assert (= c (store (store b 4 v) 5 v)))
+(assert (and (distinct k 1 2 3 4 5) (= i k) (= j k)))
+(assert (not (= (select a i) (select c j))))
+(check-sat)
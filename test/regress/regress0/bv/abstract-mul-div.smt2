@@ -0,0 +1,19 @@
+; COMMAND-LINE: --incremental --bv-solver=abstract --bv-abstraction-min-width=8
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-const x (_ BitVec 16))
+(declare-const y (_ BitVec 16))
+(declare-const z (_ BitVec 16))
+(assert (bvugt x #x0001))
+(assert (bvugt y #x0001))
+(assert (= (bvmul x y) #x0143))
+(check-sat)
+(push 1)
+(assert (= ((_ extract 0 0) x) #b0))
+(check-sat)
+(pop 1)
+(assert (= (bvudiv z y) x))
+(assert (= (bvurem z x) #x0000))
+(check-sat)
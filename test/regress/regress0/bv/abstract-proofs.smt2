@@ -0,0 +1,8 @@
+; COMMAND-LINE: --bv-solver=abstract --bv-abstraction-min-width=8 --produce-proofs
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-const x (_ BitVec 16))
+(declare-const y (_ BitVec 16))
+(assert (= (bvmul x y) #x0143))
+(assert (= ((_ extract 0 0) x) #b0))
+(check-sat)
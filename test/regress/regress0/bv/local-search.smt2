@@ -0,0 +1,20 @@
+; COMMAND-LINE: --incremental --bv-solver=bitblast --bv-ls
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-const x (_ BitVec 32))
+(declare-const y (_ BitVec 32))
+(declare-const z (_ BitVec 8))
+(assert (= (bvadd (bvmul x #x00000005) y) #x12345678))
+(assert (bvult y #x00001000))
+(assert (= ((_ extract 7 0) (bvlshr x #x00000004)) (bvxor z #xa5)))
+(check-sat)
+(push 1)
+(assert (bvslt (concat z z) #x0000))
+(assert (= (bvurem x #x00000003) #x00000001))
+(check-sat)
+(pop 1)
+(assert (= (bvand y #x0000000f) #x00000003))
+(assert (= (bvor y #x0000000f) #x00000002))
+(check-sat)
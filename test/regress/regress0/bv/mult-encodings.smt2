@@ -0,0 +1,18 @@
+; COMMAND-LINE: --bv-solver=bitblast --bv-multiplier=shift-add
+; COMMAND-LINE: --bv-solver=bitblast --bv-multiplier=wallace
+; COMMAND-LINE: --bv-solver=bitblast --bv-multiplier=dadda
+; COMMAND-LINE: --bv-solver=bitblast --bv-multiplier=booth
+; COMMAND-LINE: --bv-solver=bitblast --bv-mult-const --bv-mult-share
+; COMMAND-LINE: --bv-solver=bitblast --bv-multiplier=dadda --bv-mult-const --bv-mult-share
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-const x (_ BitVec 12))
+(declare-const y (_ BitVec 12))
+(declare-const z (_ BitVec 12))
+; commutativity and associativity, with shared products
+(assert (or (distinct (bvmul x y z) (bvmul z (bvmul y x)))
+            ; multiplication by constants, with -c having fewer bits set
+            (distinct (bvmul x #xffd) (bvneg (bvmul #x003 x)))
+            (distinct (bvmul #x005 x #x007) (bvmul x #x023))
+            (distinct (bvmul x (bvadd y #x001)) (bvadd (bvmul x y) x))))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --bitblast=eager --bv-sat-preprocess --no-check-unsat-cores
+; EXPECT: unsat
+(set-logic QF_BV)
+(declare-fun x0 () (_ BitVec 3))
+(declare-fun x1 () (_ BitVec 3))
+(declare-fun x2 () (_ BitVec 3))
+(declare-fun x3 () (_ BitVec 3))
+(declare-fun x4 () (_ BitVec 3))
+(declare-fun x5 () (_ BitVec 3))
+(declare-fun x6 () (_ BitVec 3))
+(declare-fun x7 () (_ BitVec 3))
+(declare-fun y () (_ BitVec 3))
+
+; nine distinct values of three bits
+(assert (= y (bvadd x0 (bvmul x1 #b011))))
+(assert (distinct x0 x1 x2 x3 x4 x5 x6 x7 y))
+(check-sat)
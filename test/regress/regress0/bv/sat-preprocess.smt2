@@ -0,0 +1,14 @@
+; COMMAND-LINE: --bitblast=eager --bv-sat-preprocess --check-models
+; EXPECT: sat
+(set-logic QF_BV)
+(declare-fun a () (_ BitVec 16))
+(declare-fun b () (_ BitVec 16))
+(declare-fun c () (_ BitVec 16))
+(declare-fun d () (_ BitVec 16))
+
+(assert (= (bvadd a b) (bvmul c #x0007)))
+(assert (bvult a (bvadd b c)))
+(assert (= d (bvxor a (bvnot b))))
+(assert (not (= (bvand d c) #x0000)))
+(assert (distinct a b c))
+(check-sat)
@@ -0,0 +1,22 @@
+; COMMAND-LINE: --incremental --bv-bb-shared-cache
+; COMMAND-LINE: --incremental --bv-bb-shared-cache --bv-solver=bitblast
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-option :global-declarations true)
+(set-logic QF_BV)
+(declare-const x (_ BitVec 8))
+(declare-const y (_ BitVec 8))
+(assert (= (bvmul x y) #x0f))
+(assert (bvult x y))
+(check-sat)
+(assert (= ((_ extract 0 0) y) #b0))
+(check-sat)
+(reset-assertions)
+(assert (= (bvmul x y) #x0f))
+(assert (bvult x y))
+(check-sat)
+(assert (= (bvadd x y) #x00))
+(assert (= x #x01))
+(check-sat)
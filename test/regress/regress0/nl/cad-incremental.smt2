@@ -0,0 +1,16 @@
+; COMMAND-LINE: --incremental --no-nl-ext --nl-cad --nl-cad-incremental
+; REQUIRES: poly
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(assert (> (+ (* x x) (* y y)) 1.0))
+(check-sat)
+(push 1)
+(assert (< (+ (* x x) (* y y)) 1.0))
+(check-sat)
+(pop 1)
+(assert (< (* x y) 0.0))
+(check-sat)
@@ -0,0 +1,14 @@
+; REQUIRES: poly
+; COMMAND-LINE: --nl-icp
+; COMMAND-LINE: --nl-icp --no-nl-icp-float
+; EXPECT: unsat
+(set-logic QF_NRA)
+(declare-fun x () Real)
+(declare-fun y () Real)
+(declare-fun z () Real)
+(assert (>= x 2.0))
+(assert (<= x 3.0))
+(assert (= y (* x x)))
+(assert (= z (- (* x y) 1.0)))
+(assert (< z 6.5))
+(check-sat)
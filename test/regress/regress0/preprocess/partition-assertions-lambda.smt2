@@ -0,0 +1,14 @@
+; COMMAND-LINE: --partition-assertions
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun a () Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+; the component of f and a is solved separately, f is substituted by a lambda
+(assert (> (f a) (+ (f (+ a 1)) 2)))
+(assert (> x (+ y 2)))
+(assert (> y (+ z 3)))
+(assert (> (+ x y z) 20))
+(check-sat)
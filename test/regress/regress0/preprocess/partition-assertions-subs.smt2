@@ -0,0 +1,21 @@
+; COMMAND-LINE: --partition-assertions
+; EXPECT: sat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(declare-fun c () Int)
+; x and z are eliminated by top-level substitutions before the components
+; are computed, the model value of x depends on the value of y found by the
+; subsolver
+(assert (= x (+ y 1)))
+(assert (> y 3))
+(assert (< x 7))
+(assert (= z (+ a b)))
+(assert (> a (+ b 2)))
+(assert (> b (+ c 1)))
+(assert (< (+ z c) 12))
+(assert (> c 0))
+(check-sat)
@@ -0,0 +1,16 @@
+; COMMAND-LINE: --partition-assertions
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun f (Int) Int)
+(declare-fun a () Int)
+(declare-fun b () Int)
+(declare-fun c () Int)
+(assert (> (+ x y) 10))
+(assert (< (- x y) 3))
+(assert (> (f a) (f b)))
+(assert (> b (+ a 1)))
+(assert (or (> c (f a)) (< c (- 5))))
+(assert (> (+ a b c) 0))
+(check-sat)
@@ -0,0 +1,24 @@
+; COMMAND-LINE: --sym-break --check-models
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort Color 0)
+(declare-fun c1 () Color)
+(declare-fun c2 () Color)
+(declare-fun c3 () Color)
+(declare-fun v1 () Color)
+(declare-fun v2 () Color)
+(declare-fun v3 () Color)
+(declare-fun v4 () Color)
+(declare-fun v5 () Color)
+(assert (distinct c1 c2 c3))
+(assert (or (= v1 c1) (= v1 c2) (= v1 c3)))
+(assert (or (= v2 c1) (= v2 c2) (= v2 c3)))
+(assert (or (= v3 c1) (= v3 c2) (= v3 c3)))
+(assert (or (= v4 c1) (= v4 c2) (= v4 c3)))
+(assert (or (= v5 c1) (= v5 c2) (= v5 c3)))
+(assert (not (= v1 v2)))
+(assert (not (= v2 v3)))
+(assert (not (= v3 v4)))
+(assert (not (= v4 v5)))
+(assert (not (= v5 v1)))
+(check-sat)
@@ -0,0 +1,21 @@
+; COMMAND-LINE: --sym-break --check-models
+; EXPECT: sat
+; The rotations of x1, x2, x3 are symmetries, but their transpositions are not,
+; so the assertions must not be assumed invariant under all permutations of
+; x1, x2, x3.
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun x1 () U)
+(declare-fun x2 () U)
+(declare-fun x3 () U)
+(declare-fun y1 () U)
+(declare-fun y2 () U)
+(assert (distinct x1 x2 x3))
+(assert (= (f x1) x2))
+(assert (= (f x2) x3))
+(assert (= (f x3) x1))
+(assert (or (= y1 x1) (= y1 x2) (= y1 x3)))
+(assert (= (f y2) y1))
+(assert (or (= y2 x1) (= y2 x2) (= y2 x3)))
+(check-sat)
@@ -0,0 +1,19 @@
+; COMMAND-LINE: --sym-break
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-fun p1h1 () Bool)
+(declare-fun p1h2 () Bool)
+(declare-fun p2h1 () Bool)
+(declare-fun p2h2 () Bool)
+(declare-fun p3h1 () Bool)
+(declare-fun p3h2 () Bool)
+(assert (or p1h1 p1h2))
+(assert (or p2h1 p2h2))
+(assert (or p3h1 p3h2))
+(assert (not (and p1h1 p2h1)))
+(assert (not (and p1h1 p3h1)))
+(assert (not (and p2h1 p3h1)))
+(assert (not (and p1h2 p2h2)))
+(assert (not (and p1h2 p3h2)))
+(assert (not (and p2h2 p3h2)))
+(check-sat)
@@ -0,0 +1,14 @@
+; COMMAND-LINE: --ematch-code-tree
+(set-logic UF)
+(set-info :status unsat)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (forall ((x U)) (! (= (f (g x)) x) :pattern ((f (g x))))))
+(assert (or (= a (g b)) (= a (g c))))
+(assert (not (= (f a) b)))
+(assert (not (= (f a) c)))
+(check-sat)
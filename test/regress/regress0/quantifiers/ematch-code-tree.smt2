@@ -0,0 +1,17 @@
+; COMMAND-LINE: --ematch-code-tree
+; COMMAND-LINE: --no-ematch-code-tree
+(set-logic UF)
+(set-info :status unsat)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun g (U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (forall ((x U) (y U)) (! (P (f x (g y))) :pattern ((f x (g y))))))
+(assert (forall ((x U)) (! (= (f x (g x)) x) :pattern ((f x (g x))))))
+(assert (= b (g c)))
+(assert (= (f a b) a))
+(assert (or (not (P (f a b))) (not (= (f c (g c)) c))))
+(check-sat)
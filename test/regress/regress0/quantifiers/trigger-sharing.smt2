@@ -0,0 +1,21 @@
+; COMMAND-LINE: --multi-trigger-when-single
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun P (U) Bool)
+(declare-fun Q (U) Bool)
+(declare-fun R (U U) Bool)
+(declare-fun f (U) U)
+(declare-const a U)
+(declare-const b U)
+; several triggers of the same quantified formula produce the same matches in
+; one round, each of them is only sent once
+(assert (forall ((x U)) (! (or (not (P x)) (Q (f x))) :pattern ((P x)) :pattern ((f x)))))
+(assert (forall ((x U) (y U)) (! (or (not (R x y)) (P x) (P y)) :pattern ((R x y)) :pattern ((P x) (P y)))))
+(assert (forall ((x U)) (or (not (Q x)) (R x (f x)) (P (f x)))))
+(assert (R a b))
+(assert (= (f a) b))
+(assert (= (f b) a))
+(assert (not (Q a)))
+(assert (not (Q b)))
+(check-sat)
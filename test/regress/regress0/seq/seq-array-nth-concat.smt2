@@ -0,0 +1,17 @@
+; COMMAND-LINE: --strings-exp --seq-array --check-models
+; EXPECT: sat
+(set-logic ALL)
+(declare-fun s () (Seq Int))
+(declare-fun x () (Seq Int))
+(declare-fun y () (Seq Int))
+(declare-fun i () Int)
+(assert (= s (seq.++ x (seq.unit 3) y)))
+(assert (= (seq.len x) 2))
+(assert (distinct (seq.nth x 0) (seq.nth x 1) 3))
+(assert (> (seq.len y) 0))
+(assert (not (= (seq.nth y 0) 3)))
+(assert (<= 0 i))
+(assert (< i (seq.len s)))
+(assert (not (= i 2)))
+(assert (= (seq.nth s i) 3))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --strings-exp --seq-array --check-models
+; EXPECT: sat
+(set-logic ALL)
+(declare-fun s () (Seq Int))
+(declare-fun t () (Seq Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(assert (= (seq.len s) 2))
+(assert (< i 0))
+(assert (= (seq.nth s i) 5))
+(assert (= t (seq.update s j (seq.unit 3))))
+(assert (= j (seq.len s)))
+(assert (= (seq.nth t j) 4))
+(assert (= (seq.nth (seq.++ s (seq.unit 9)) 3) 6))
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --strings-exp --seq-array --check-models
+; EXPECT: sat
+(set-logic ALL)
+(declare-fun s () (Seq Int))
+(declare-fun t () (Seq Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(declare-fun k () Int)
+(assert (= t (seq.update s i (seq.unit 5))))
+(assert (= (seq.len s) 3))
+(assert (and (<= 0 i) (< i 3)))
+(assert (and (<= 0 j) (< j 3)))
+(assert (not (= i j)))
+(assert (= (seq.nth s i) 1))
+(assert (= (seq.nth t j) 4))
+(assert (= (seq.nth (seq.unit k) 0) (seq.nth t i)))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --strings-exp --seq-array
+; EXPECT: unsat
+(set-logic ALL)
+(declare-fun s () (Seq Int))
+(declare-fun t () (Seq Int))
+(declare-fun u () (Seq Int))
+(declare-fun i () Int)
+(declare-fun j () Int)
+(assert (= t (seq.update s i (seq.unit 5))))
+(assert (= u (seq.++ t (seq.unit 7))))
+(assert (<= 0 i))
+(assert (< i j))
+(assert (< j (seq.len s)))
+(assert (not (= (seq.nth u j) (seq.nth s j))))
+(check-sat)
@@ -0,0 +1,15 @@
+; COMMAND-LINE: --strings-len-abs --check-models
+; EXPECT: sat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(assert (str.in_re x ((_ re.loop 2 5) (str.to_re "abc"))))
+(assert (str.in_re y (re.union (str.to_re "a") (str.to_re "abcd"))))
+(assert (str.in_re z (re.* (re.union (str.to_re "ab") (str.to_re "abcde")))))
+(assert (> (str.len x) 10))
+(assert (= (str.len (str.++ x y)) 13))
+(assert (not (= z "")))
+(assert (< (str.len z) 6))
+(assert (not (= z "ab")))
+(check-sat)
@@ -0,0 +1,11 @@
+; COMMAND-LINE: --strings-len-abs
+(set-logic QF_SLIA)
+(set-info :status unsat)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(assert (str.in_re x (re.* ((_ re.loop 3 3) re.allchar))))
+(assert (str.in_re y (re.+ (re.union (str.to_re "abc") (str.to_re "abcdef")))))
+(assert (= (str.len z) 1))
+(assert (= (str.++ x z) y))
+(check-sat)
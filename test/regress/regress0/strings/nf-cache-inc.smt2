@@ -0,0 +1,34 @@
+; COMMAND-LINE: --incremental --strings-nf-cache
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_SLIA)
+(declare-fun x () String)
+(declare-fun y () String)
+(declare-fun z () String)
+(declare-fun w () String)
+(assert (= x (str.++ y z)))
+(assert (= w (str.++ x y)))
+(push 1)
+(assert (= y "a"))
+(assert (= z "b"))
+(check-sat)
+(pop 1)
+; the normal forms of x and w from the previous check are stale
+(push 1)
+(assert (= y "c"))
+(assert (= w "aba"))
+(check-sat)
+(pop 1)
+; the normal forms change on backtracking within this check
+(push 1)
+(assert (or (= y "a") (= y "b")))
+(assert (= z y))
+(assert (not (= x "aa")))
+(assert (= (str.len w) 3))
+(check-sat)
+(pop 1)
+(assert (= z ""))
+(assert (not (= w (str.++ y y))))
+(check-sat)
@@ -0,0 +1,12 @@
+; COMMAND-LINE: --re-automata
+; COMMAND-LINE: --no-re-automata
+(set-logic QF_SLIA)
+(set-info :status unsat)
+(declare-fun x () String)
+(declare-fun y () String)
+(assert (str.in_re "ababab" (re.* (str.to_re "ab"))))
+(assert (not (str.in_re "abba" (re.* (str.to_re "ab")))))
+(assert (str.in_re x (re.* (str.to_re "ab"))))
+(assert (str.in_re y (re.++ (str.to_re "a") (re.* (str.to_re "ba")))))
+(assert (= x y))
+(check-sat)
@@ -0,0 +1,26 @@
+; COMMAND-LINE: --ee-fast-explain
+; COMMAND-LINE: --no-ee-fast-explain
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun g (U) U)
+(declare-fun p (U) Bool)
+(declare-fun a0 () U)
+(declare-fun a1 () U)
+(declare-fun a2 () U)
+(declare-fun a3 () U)
+(declare-fun b0 () U)
+(declare-fun b1 () U)
+(declare-fun b2 () U)
+(declare-fun b3 () U)
+(assert (= a0 b0))
+(assert (= a1 b1))
+(assert (= a2 b2))
+(assert (= a3 b3))
+(assert (or (= (f a0 a1) (g a2)) (= (f a1 a0) (g a3))))
+(assert (p (f (f a0 a1) (g (g a2)))))
+(assert (or (not (p (f (f b0 b1) (g (g b2)))))
+            (not (p (f (g b3) (g (g b2)))))))
+(assert (= (f a0 a1) (g a3)))
+(check-sat)
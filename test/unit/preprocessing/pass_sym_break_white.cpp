@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the symmetry breaking preprocessing pass.
+ */
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/skolem_manager.h"
+#include "preprocessing/assertion_pipeline.h"
+#include "preprocessing/passes/sym_break.h"
+#include "smt/preprocessor.h"
+#include "smt/smt_engine.h"
+#include "test_smt.h"
+#include "theory/rewriter.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace preprocessing;
+using namespace preprocessing::passes;
+using namespace theory;
+
+namespace test {
+
+class TestPPWhiteSymBreak : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_smtEngine->finishInit();
+    d_symBreak.reset(new SymBreak(d_smtEngine->d_pp->d_ppContext.get()));
+  }
+
+  std::unique_ptr<SymBreak> d_symBreak;
+};
+
+TEST_F(TestPPWhiteSymBreak, is_symmetry)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  Node a = d_skolemManager->mkDummySkolem("a", intType);
+  Node b = d_skolemManager->mkDummySkolem("b", intType);
+  Node c = d_skolemManager->mkDummySkolem("c", intType);
+  std::vector<Node> assertions = {
+      Rewriter::rewrite(d_nodeManager->mkNode(LT, a, c)),
+      Rewriter::rewrite(d_nodeManager->mkNode(LT, b, c))};
+  std::unordered_set<Node, NodeHashFunction> aset(assertions.begin(),
+                                                  assertions.end());
+  ASSERT_TRUE(d_symBreak->buildGraph(assertions));
+  size_t va = d_symBreak->d_termIndex[a];
+  size_t vb = d_symBreak->d_termIndex[b];
+  size_t vc = d_symBreak->d_termIndex[c];
+
+  SymBreak::Permutation ab = {{va, vb}, {vb, va}};
+  ASSERT_TRUE(d_symBreak->isSymmetry(assertions, aset, ab));
+  // a < c maps to c < a, which is not an assertion
+  SymBreak::Permutation ac = {{va, vc}, {vc, va}};
+  ASSERT_FALSE(d_symBreak->isSymmetry(assertions, aset, ac));
+  SymBreak::Permutation abc = {{va, vb}, {vb, vc}, {vc, va}};
+  ASSERT_FALSE(d_symBreak->isSymmetry(assertions, aset, abc));
+}
+
+TEST_F(TestPPWhiteSymBreak, value_precedence)
+{
+  // three pigeons in three holes of an uninterpreted sort
+  TypeNode u = d_nodeManager->mkSort("U");
+  std::vector<Node> holes;
+  std::vector<Node> pigeons;
+  for (size_t i = 0; i < 3; i++)
+  {
+    holes.push_back(d_skolemManager->mkDummySkolem("h", u));
+    pigeons.push_back(d_skolemManager->mkDummySkolem("p", u));
+  }
+  AssertionPipeline pipeline;
+  pipeline.push_back(d_nodeManager->mkNode(DISTINCT, holes));
+  pipeline.push_back(d_nodeManager->mkNode(DISTINCT, pigeons));
+  for (const Node& p : pigeons)
+  {
+    std::vector<Node> disj;
+    for (const Node& h : holes)
+    {
+      disj.push_back(p.eqNode(h));
+    }
+    pipeline.push_back(d_nodeManager->mkNode(OR, disj));
+  }
+  for (size_t i = 0, size = pipeline.size(); i < size; i++)
+  {
+    pipeline.replace(i, Rewriter::rewrite(pipeline[i]));
+  }
+  size_t size = pipeline.size();
+  d_symBreak->applyInternal(&pipeline);
+  ASSERT_GT(pipeline.size(), size);
+
+  // the constraints do not exclude all models
+  for (const Node& a : pipeline.ref())
+  {
+    d_smtEngine->assertFormula(a);
+  }
+  ASSERT_TRUE(d_smtEngine->checkSat().isSat() == Result::SAT);
+}
+
+}  // namespace test
+}  // namespace cvc5
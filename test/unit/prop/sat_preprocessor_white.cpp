@@ -0,0 +1,385 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the model reconstruction of cvc5::prop::SatPreprocessor.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "base/check.h"
+#include "prop/sat_preprocessor.h"
+#include "prop/sat_solver.h"
+#include "test.h"
+#include "util/random.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+
+using namespace prop;
+
+namespace test {
+
+/**
+ * A back end that enumerates all assignments, starting with the one that
+ * assigns false to all variables. Only suitable for a handful of variables.
+ */
+class EnumeratingSatSolver : public SatSolver
+{
+ public:
+  EnumeratingSatSolver() : d_numVars(0) {}
+
+  ClauseId addClause(SatClause& clause, bool removable) override
+  {
+    d_clauses.push_back(clause);
+    return ClauseIdUndef;
+  }
+
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
+  {
+    Unreachable();
+  }
+
+  SatVariable newVar(bool isTheoryAtom, bool preRegister, bool canErase) override
+  {
+    return d_numVars++;
+  }
+
+  SatVariable trueVar() override
+  {
+    SatVariable v = d_numVars++;
+    d_clauses.push_back({SatLiteral(v)});
+    return v;
+  }
+
+  SatVariable falseVar() override
+  {
+    SatVariable v = d_numVars++;
+    d_clauses.push_back({SatLiteral(v, true)});
+    return v;
+  }
+
+  SatValue solve() override { return solve(std::vector<SatLiteral>()); }
+
+  SatValue solve(long unsigned int& resource) override { return solve(); }
+
+  SatValue solve(const std::vector<SatLiteral>& assumptions) override
+  {
+    Assert(d_numVars < 20);
+    d_model.resize(d_numVars);
+    for (uint64_t a = 0, end = uint64_t(1) << d_numVars; a < end; ++a)
+    {
+      for (SatVariable v = 0; v < d_numVars; ++v)
+      {
+        d_model[v] = (a >> v) & 1;
+      }
+      if (isTrue(assumptions))
+      {
+        bool sat = true;
+        for (const SatClause& c : d_clauses)
+        {
+          sat = sat && isTrueClause(c);
+        }
+        if (sat)
+        {
+          return SAT_VALUE_TRUE;
+        }
+      }
+    }
+    d_model.clear();
+    d_unsatAssumptions = assumptions;
+    return SAT_VALUE_FALSE;
+  }
+
+  void getUnsatAssumptions(std::vector<SatLiteral>& assumptions) override
+  {
+    assumptions = d_unsatAssumptions;
+  }
+
+  void interrupt() override {}
+
+  SatValue value(SatLiteral l) override
+  {
+    if (l.getSatVariable() >= d_model.size())
+    {
+      return SAT_VALUE_UNKNOWN;
+    }
+    return d_model[l.getSatVariable()] != l.isNegated() ? SAT_VALUE_TRUE
+                                                        : SAT_VALUE_FALSE;
+  }
+
+  SatValue modelValue(SatLiteral l) override { return value(l); }
+
+  unsigned getAssertionLevel() const override { return 0; }
+
+  bool ok() const override { return true; }
+
+ private:
+  bool isTrue(const std::vector<SatLiteral>& lits)
+  {
+    for (const SatLiteral& l : lits)
+    {
+      if (d_model[l.getSatVariable()] == l.isNegated())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  bool isTrueClause(const SatClause& c)
+  {
+    for (const SatLiteral& l : c)
+    {
+      if (d_model[l.getSatVariable()] != l.isNegated())
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  SatVariable d_numVars;
+  std::vector<SatClause> d_clauses;
+  std::vector<bool> d_model;
+  std::vector<SatLiteral> d_unsatAssumptions;
+};
+
+class TestPropWhiteSatPreprocessor : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    d_solver.reset();
+    d_registry.reset(new StatisticsRegistry());
+    d_backend = new EnumeratingSatSolver();
+    d_solver.reset(new SatPreprocessor(d_backend, *d_registry, "test::"));
+    d_clauses.clear();
+  }
+
+  /** Returns a new variable, which is frozen if frozen is true */
+  SatVariable newVar(bool frozen)
+  {
+    return d_solver->newVar(false, false, !frozen);
+  }
+
+  /** Adds clause c, and remembers it for checking models */
+  void addClause(const SatClause& c)
+  {
+    d_clauses.push_back(c);
+    SatClause clause = c;
+    d_solver->addClause(clause, false);
+  }
+
+  /**
+   * Returns true if the values of the preprocessor satisfy all clauses added
+   * so far and the given assumptions.
+   */
+  bool isModel(const std::vector<SatLiteral>& assumptions = {})
+  {
+    for (const SatLiteral& l : assumptions)
+    {
+      if (d_solver->value(l) != SAT_VALUE_TRUE)
+      {
+        return false;
+      }
+    }
+    for (const SatClause& c : d_clauses)
+    {
+      bool sat = false;
+      for (const SatLiteral& l : c)
+      {
+        sat = sat || d_solver->value(l) == SAT_VALUE_TRUE;
+      }
+      if (!sat)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::unique_ptr<StatisticsRegistry> d_registry;
+  /** The back end, owned by d_solver */
+  EnumeratingSatSolver* d_backend;
+  std::unique_ptr<SatPreprocessor> d_solver;
+  /** The clauses added to d_solver */
+  std::vector<SatClause> d_clauses;
+};
+
+TEST_F(TestPropWhiteSatPreprocessor, variable_elimination)
+{
+  SatVariable x = newVar(false);
+  SatVariable a = newVar(true);
+  SatVariable b = newVar(true);
+  addClause({SatLiteral(x), SatLiteral(a)});
+  addClause({SatLiteral(x, true), SatLiteral(b)});
+  // The back end only sees the resolvent (a b) and assigns false to x, so x
+  // must be flipped if a is false.
+  std::vector<SatLiteral> assumptions{SatLiteral(a, true)};
+  ASSERT_EQ(d_solver->solve(assumptions), SAT_VALUE_TRUE);
+  ASSERT_TRUE(d_solver->d_eliminated[x]);
+  ASSERT_EQ(d_backend->value(SatLiteral(x)), SAT_VALUE_FALSE);
+  ASSERT_EQ(d_solver->value(SatLiteral(x)), SAT_VALUE_TRUE);
+  ASSERT_TRUE(isModel(assumptions));
+}
+
+TEST_F(TestPropWhiteSatPreprocessor, blocked_clause_elimination)
+{
+  SatVariable x = newVar(false);
+  SatVariable a = newVar(true);
+  std::vector<SatVariable> bs, cs;
+  for (size_t i = 0; i < 3; i++)
+  {
+    bs.push_back(newVar(true));
+    cs.push_back(newVar(true));
+  }
+  // Eliminating x would add 9 resolvents for 7 clauses, but (x a) is blocked
+  // on x, since all clauses with -x contain -a.
+  for (size_t i = 0; i < 3; i++)
+  {
+    addClause({SatLiteral(x, true), SatLiteral(a, true), SatLiteral(bs[i])});
+    addClause({SatLiteral(x), SatLiteral(cs[i])});
+  }
+  addClause({SatLiteral(x), SatLiteral(a)});
+  std::vector<SatLiteral> assumptions{SatLiteral(a, true)};
+  for (SatVariable c : cs)
+  {
+    assumptions.push_back(SatLiteral(c));
+  }
+  ASSERT_EQ(d_solver->solve(assumptions), SAT_VALUE_TRUE);
+  ASSERT_FALSE(d_solver->d_eliminated[x]);
+  ASSERT_EQ(d_solver->d_reconstruction.size(), 1);
+  ASSERT_EQ(d_backend->value(SatLiteral(x)), SAT_VALUE_FALSE);
+  ASSERT_EQ(d_solver->value(SatLiteral(x)), SAT_VALUE_TRUE);
+  ASSERT_TRUE(isModel(assumptions));
+}
+
+TEST_F(TestPropWhiteSatPreprocessor, equivalent_literals)
+{
+  SatVariable x = newVar(false);
+  SatVariable y = newVar(true);
+  SatVariable a = newVar(true);
+  SatVariable b = newVar(true);
+  // x is equivalent to -y
+  addClause({SatLiteral(x), SatLiteral(y)});
+  addClause({SatLiteral(x, true), SatLiteral(y, true)});
+  addClause({SatLiteral(x), SatLiteral(a), SatLiteral(b)});
+  addClause({SatLiteral(x, true), SatLiteral(a, true), SatLiteral(b)});
+  std::vector<SatLiteral> assumptions{SatLiteral(y, true),
+                                      SatLiteral(b, true)};
+  ASSERT_EQ(d_solver->solve(assumptions), SAT_VALUE_TRUE);
+  ASSERT_TRUE(d_solver->d_eliminated[x]);
+  ASSERT_EQ(d_solver->value(SatLiteral(x)), SAT_VALUE_TRUE);
+  ASSERT_EQ(d_solver->value(SatLiteral(a)), SAT_VALUE_FALSE);
+  ASSERT_TRUE(isModel(assumptions));
+}
+
+TEST_F(TestPropWhiteSatPreprocessor, assumptions)
+{
+  SatVariable x = newVar(false);
+  SatVariable y = newVar(false);
+  SatVariable a = newVar(true);
+  addClause({SatLiteral(x), SatLiteral(a)});
+  addClause({SatLiteral(x, true), SatLiteral(y)});
+  addClause({SatLiteral(y, true), SatLiteral(a, true)});
+  // x is frozen by the assumption of the first call
+  std::vector<SatLiteral> assumptions{SatLiteral(x)};
+  ASSERT_EQ(d_solver->solve(assumptions), SAT_VALUE_TRUE);
+  ASSERT_FALSE(d_solver->d_eliminated[x]);
+  ASSERT_TRUE(isModel(assumptions));
+  // y was eliminated, assuming it restores the removed clauses
+  ASSERT_TRUE(d_solver->d_eliminated[y]);
+  assumptions = {SatLiteral(y, true)};
+  ASSERT_EQ(d_solver->solve(assumptions), SAT_VALUE_TRUE);
+  ASSERT_TRUE(isModel(assumptions));
+  assumptions = {SatLiteral(y), SatLiteral(x, true)};
+  ASSERT_EQ(d_solver->solve(assumptions), SAT_VALUE_FALSE);
+  std::vector<SatLiteral> core;
+  d_solver->getUnsatAssumptions(core);
+  ASSERT_FALSE(core.empty());
+}
+
+TEST_F(TestPropWhiteSatPreprocessor, incremental)
+{
+  SatVariable x = newVar(false);
+  SatVariable y = newVar(false);
+  SatVariable z = newVar(false);
+  SatVariable a = newVar(true);
+  addClause({SatLiteral(x), SatLiteral(a)});
+  addClause({SatLiteral(x, true), SatLiteral(y)});
+  addClause({SatLiteral(y, true), SatLiteral(z)});
+  addClause({SatLiteral(z, true), SatLiteral(x)});
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_TRUE);
+  ASSERT_TRUE(isModel());
+  // clauses over eliminated variables after the first call
+  addClause({SatLiteral(y, true)});
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_TRUE);
+  ASSERT_TRUE(isModel());
+  ASSERT_EQ(d_solver->value(SatLiteral(x)), SAT_VALUE_FALSE);
+  ASSERT_EQ(d_solver->value(SatLiteral(a)), SAT_VALUE_TRUE);
+  addClause({SatLiteral(a, true), SatLiteral(z)});
+  ASSERT_EQ(d_solver->solve(), SAT_VALUE_FALSE);
+}
+
+TEST_F(TestPropWhiteSatPreprocessor, random)
+{
+  Random& rnd = Random::getRandom();
+  rnd.setSeed(42);
+  for (size_t round = 0; round < 200; round++)
+  {
+    SetUp();
+    EnumeratingSatSolver reference;
+    size_t numVars = rnd.pick(3, 10);
+    for (size_t i = 0; i < numVars; i++)
+    {
+      newVar(rnd.pickWithProb(0.2));
+      reference.newVar(false, false, true);
+    }
+    size_t numClauses = rnd.pick(numVars, 5 * numVars);
+    for (size_t i = 0; i < numClauses; i++)
+    {
+      SatClause c;
+      for (size_t j = 0, size = rnd.pick(1, 3); j < size; j++)
+      {
+        c.push_back(SatLiteral(rnd.pick(0, numVars - 1), rnd.pickWithProb(0.5)));
+      }
+      addClause(c);
+      reference.addClause(c, false);
+    }
+    std::vector<SatLiteral> assumptions;
+    if (rnd.pickWithProb(0.5))
+    {
+      assumptions.push_back(
+          SatLiteral(rnd.pick(0, numVars - 1), rnd.pickWithProb(0.5)));
+    }
+    SatValue res = d_solver->solve(assumptions);
+    ASSERT_EQ(res, reference.solve(assumptions));
+    if (res == SAT_VALUE_TRUE)
+    {
+      ASSERT_TRUE(isModel(assumptions));
+    }
+    // incremental call with a clause over arbitrary variables
+    SatClause c{SatLiteral(rnd.pick(0, numVars - 1), rnd.pickWithProb(0.5)),
+                SatLiteral(rnd.pick(0, numVars - 1), rnd.pickWithProb(0.5))};
+    addClause(c);
+    reference.addClause(c, false);
+    res = d_solver->solve();
+    ASSERT_EQ(res, reference.solve());
+    if (res == SAT_VALUE_TRUE)
+    {
+      ASSERT_TRUE(isModel());
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::theory::strings::RegExpAutomaton.
+ */
+
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "test_smt.h"
+#include "theory/rewriter.h"
+#include "theory/strings/regexp_automaton.h"
+#include "theory/strings/regexp_entail.h"
+#include "util/random.h"
+#include "util/regexp.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+using namespace theory::strings;
+
+namespace test {
+
+class TestTheoryBlackRegexpAutomaton : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    Random::getRandom().setSeed(7);
+    // all strings over {a, b, c} of length at most 4, and some longer ones
+    d_strings.push_back(String(""));
+    for (size_t i = 0; i < d_strings.size() && d_strings.size() < 121; i++)
+    {
+      for (const char* c : {"a", "b", "c"})
+      {
+        d_strings.push_back(d_strings[i].concat(String(c)));
+      }
+    }
+    for (size_t i = 0; i < 20; i++)
+    {
+      d_strings.push_back(mkRandomString(Random::getRandom().pick(5, 8)));
+    }
+  }
+
+  String mkRandomString(size_t len)
+  {
+    std::string s;
+    for (size_t i = 0; i < len; i++)
+    {
+      s.push_back('a' + Random::getRandom().pick(0, 2));
+    }
+    return String(s);
+  }
+
+  Node mkChar() { return d_nodeManager->mkConst(mkRandomString(1)); }
+
+  /** Returns a random regular expression of the given depth */
+  Node mkRandomRegExp(size_t depth)
+  {
+    Random& rnd = Random::getRandom();
+    NodeManager* nm = d_nodeManager.get();
+    if (depth == 0)
+    {
+      switch (rnd.pick(0, 4))
+      {
+        case 0:
+          return nm->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+        case 1:
+        {
+          Node c1 = mkChar();
+          Node c2 = mkChar();
+          if (c2.getConst<String>() < c1.getConst<String>())
+          {
+            std::swap(c1, c2);
+          }
+          return nm->mkNode(REGEXP_RANGE, c1, c2);
+        }
+        case 2: return nm->mkNode(REGEXP_EMPTY, std::vector<Node>{});
+        default:
+          return nm->mkNode(STRING_TO_REGEXP,
+                            nm->mkConst(mkRandomString(rnd.pick(0, 2))));
+      }
+    }
+    Node r1 = mkRandomRegExp(depth - 1);
+    switch (rnd.pick(0, 9))
+    {
+      case 0:
+      case 1:
+        return nm->mkNode(REGEXP_CONCAT, r1, mkRandomRegExp(depth - 1));
+      case 2:
+      case 3: return nm->mkNode(REGEXP_UNION, r1, mkRandomRegExp(depth - 1));
+      case 4: return nm->mkNode(REGEXP_STAR, r1);
+      case 5: return nm->mkNode(REGEXP_PLUS, r1);
+      case 6: return nm->mkNode(REGEXP_OPT, r1);
+      case 7:
+      {
+        uint32_t l = rnd.pick(0, 2);
+        uint32_t u = l + rnd.pick(0, 2);
+        return nm->mkNode(REGEXP_LOOP, nm->mkConst(RegExpLoop(l, u)), r1);
+      }
+      case 8: return nm->mkNode(REGEXP_INTER, r1, mkRandomRegExp(depth - 1));
+      default: return nm->mkNode(REGEXP_COMPLEMENT, r1);
+    }
+  }
+
+  std::vector<String> d_strings;
+};
+
+TEST_F(TestTheoryBlackRegexpAutomaton, accepts)
+{
+  size_t numCompiled = 0;
+  for (size_t i = 0; i < 200; i++)
+  {
+    Node r = mkRandomRegExp(Random::getRandom().pick(1, 3));
+    // testConstStringInRegExp requires rewritten regular expressions, the
+    // automaton is built for the original one
+    Node rr = Rewriter::rewrite(r);
+    RegExpAutomaton a(r);
+    if (!a.isCompiled())
+    {
+      continue;
+    }
+    numCompiled++;
+    bool acceptsAny = false;
+    for (const String& s : d_strings)
+    {
+      String t = s;
+      bool expected = RegExpEntail::testConstStringInRegExp(t, 0, rr);
+      ASSERT_EQ(a.accepts(s), expected) << s << " in " << r;
+      acceptsAny = acceptsAny || expected;
+    }
+    bool isEmpty = false;
+    if (a.checkEmpty(isEmpty) && isEmpty)
+    {
+      ASSERT_FALSE(acceptsAny) << r;
+    }
+  }
+  // intersections and complements below other operators are not supported
+  ASSERT_GT(numCompiled, 100);
+}
+
+TEST_F(TestTheoryBlackRegexpAutomaton, includes)
+{
+  for (size_t i = 0; i < 100; i++)
+  {
+    Node r1 = mkRandomRegExp(Random::getRandom().pick(1, 2));
+    Node r2 = mkRandomRegExp(Random::getRandom().pick(1, 2));
+    bool includes = false;
+    if (!RegExpAutomaton::checkIncludes(r1, r2, includes) || !includes)
+    {
+      continue;
+    }
+    Node rr1 = Rewriter::rewrite(r1);
+    Node rr2 = Rewriter::rewrite(r2);
+    for (const String& s : d_strings)
+    {
+      String t = s;
+      if (RegExpEntail::testConstStringInRegExp(t, 0, rr2))
+      {
+        ASSERT_TRUE(RegExpEntail::testConstStringInRegExp(t, 0, rr1))
+            << s << " in " << r2 << " but not in " << r1;
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
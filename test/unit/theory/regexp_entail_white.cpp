@@ -0,0 +1,150 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the length abstraction of regular expressions.
+ */
+
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/type_checker.h"
+#include "test_smt.h"
+#include "theory/strings/regexp_entail.h"
+#include "util/regexp.h"
+#include "util/string.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+using namespace theory::strings;
+
+namespace test {
+
+class TestTheoryWhiteRegexpEntail : public TestSmt
+{
+ protected:
+  Node mkWord(const char* s)
+  {
+    return d_nodeManager->mkNode(STRING_TO_REGEXP,
+                                 d_nodeManager->mkConst(String(s)));
+  }
+
+  Node mkLoop(Node r, uint32_t lo, uint32_t hi)
+  {
+    return d_nodeManager->mkNode(
+        REGEXP_LOOP, d_nodeManager->mkConst(RegExpLoop(lo, hi)), r);
+  }
+
+  /**
+   * Asserts that the lengths of r are abstracted by the lengths in [min, max]
+   * (unbounded if max is negative) congruent to rem modulo mod.
+   */
+  void checkLengthAbs(Node r, int min, int max, int mod, int rem)
+  {
+    RegExpEntail::LengthAbs la = RegExpEntail::computeLengthAbs(r);
+    ASSERT_FALSE(la.d_empty) << r;
+    ASSERT_EQ(la.d_min, Integer(min)) << r;
+    ASSERT_EQ(la.d_hasMax, max >= 0) << r;
+    if (max >= 0)
+    {
+      ASSERT_EQ(la.d_max, Integer(max)) << r;
+    }
+    ASSERT_EQ(la.d_mod, Integer(mod)) << r;
+    ASSERT_EQ(la.d_rem, Integer(rem)) << r;
+  }
+
+  void checkEmpty(Node r)
+  {
+    ASSERT_TRUE(RegExpEntail::computeLengthAbs(r).d_empty) << r;
+  }
+};
+
+TEST_F(TestTheoryWhiteRegexpEntail, loop)
+{
+  Node abc = mkWord("abc");
+  // (abc){2,5} has lengths 6, 9, 12 and 15
+  checkLengthAbs(mkLoop(abc, 2, 5), 6, 15, 3, 0);
+  // exactly three copies
+  checkLengthAbs(mkLoop(abc, 3, 3), 9, 9, 0, 9);
+  // zero copies
+  checkLengthAbs(mkLoop(abc, 0, 0), 0, 0, 0, 0);
+  // (ab|abcd){1,2} has lengths 2, 4, 6 and 8
+  Node u = d_nodeManager->mkNode(REGEXP_UNION, mkWord("ab"), mkWord("abcd"));
+  checkLengthAbs(mkLoop(u, 1, 2), 2, 8, 2, 0);
+  Node none = d_nodeManager->mkNode(REGEXP_EMPTY, std::vector<Node>{});
+  checkEmpty(mkLoop(none, 1, 2));
+  checkLengthAbs(mkLoop(none, 0, 2), 0, 0, 0, 0);
+}
+
+TEST_F(TestTheoryWhiteRegexpEntail, star)
+{
+  Node abc = mkWord("abc");
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_STAR, abc), 0, -1, 3, 0);
+  // the empty word any number of times
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_STAR, mkWord("")), 0, 0, 0, 0);
+  // (ab|abc)* has all lengths but 1
+  Node u = d_nodeManager->mkNode(REGEXP_UNION, mkWord("ab"), mkWord("abc"));
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_STAR, u), 0, -1, 1, 0);
+  // (abc)+ has lengths 3, 6, 9, ...
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_PLUS, abc), 3, -1, 3, 0);
+  // (allchar)* has no information
+  Node sigma = d_nodeManager->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_STAR, sigma), 0, -1, 1, 0);
+}
+
+TEST_F(TestTheoryWhiteRegexpEntail, union)
+{
+  // a|abcd has lengths 1 and 4
+  Node u = d_nodeManager->mkNode(REGEXP_UNION, mkWord("a"), mkWord("abcd"));
+  checkLengthAbs(u, 1, 4, 3, 1);
+  // the empty regular expression does not contribute
+  Node none = d_nodeManager->mkNode(REGEXP_EMPTY, std::vector<Node>{});
+  checkLengthAbs(
+      d_nodeManager->mkNode(REGEXP_UNION, none, mkWord("ab")), 2, 2, 0, 2);
+  checkEmpty(d_nodeManager->mkNode(REGEXP_UNION, none, none));
+  // (abc)?
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_OPT, mkWord("abc")), 0, 3, 3, 0);
+}
+
+TEST_F(TestTheoryWhiteRegexpEntail, intersection)
+{
+  Node ab = mkWord("ab");
+  Node abc = mkWord("abc");
+  // the bounds are intersected, the congruence of the first one is kept
+  Node star = d_nodeManager->mkNode(REGEXP_STAR, ab);
+  checkLengthAbs(
+      d_nodeManager->mkNode(REGEXP_INTER, star, mkLoop(abc, 1, 3)), 3, 9, 2, 0);
+  // an exact length is kept
+  Node sigma = d_nodeManager->mkNode(REGEXP_SIGMA, std::vector<Node>{});
+  Node all = d_nodeManager->mkNode(REGEXP_STAR, sigma);
+  checkLengthAbs(
+      d_nodeManager->mkNode(REGEXP_INTER, all, mkWord("abcd")), 4, 4, 0, 4);
+  // words of different lengths
+  checkEmpty(d_nodeManager->mkNode(REGEXP_INTER, ab, abc));
+  checkEmpty(d_nodeManager->mkNode(REGEXP_INTER, mkLoop(abc, 1, 3), ab));
+}
+
+TEST_F(TestTheoryWhiteRegexpEntail, range)
+{
+  Node a = d_nodeManager->mkConst(String("a"));
+  Node z = d_nodeManager->mkConst(String("z"));
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_RANGE, a, z), 1, 1, 0, 1);
+  checkLengthAbs(d_nodeManager->mkNode(REGEXP_RANGE, z, z), 1, 1, 0, 1);
+  // empty ranges are rejected by the type checker, so that the length of a
+  // range is always one
+  ASSERT_THROW(d_nodeManager->mkNode(REGEXP_RANGE, z, a).getType(true),
+               TypeCheckingExceptionPrivate);
+}
+
+}  // namespace test
+}  // namespace cvc5
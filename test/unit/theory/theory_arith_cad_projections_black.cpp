@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the cache for CAD projections.
+ */
+
+#include <vector>
+
+#include "test.h"
+#include "theory/arith/nl/cad/projections.h"
+
+namespace cvc5 {
+
+using namespace theory::arith::nl::cad;
+
+namespace test {
+
+#ifndef CVC5_POLY_IMP
+#error "This unit test should only be enabled for CVC5_POLY_IMP"
+#endif
+
+class TestTheoryBlackArithCadProjections : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    TestInternal::SetUp();
+    poly::Polynomial x(poly::Variable("x"));
+    poly::Polynomial y(poly::Variable("y"));
+    d_polys.push_back(y * y - x);
+    d_polys.push_back(y - x * x + poly::Integer(1));
+    d_polys.push_back(x * y * y + y - poly::Integer(3));
+    d_polys.push_back((y * y - poly::Integer(2)) * (y + x));
+  }
+
+  /** Returns the square-free factors of p, sorted and without duplicates */
+  PolyVector factors(const poly::Polynomial& p)
+  {
+    PolyVector res;
+    res.add(p);
+    res.reduce();
+    return res;
+  }
+
+  /** Returns a sorted copy of v, without duplicates */
+  PolyVector reduced(const PolyVector& v)
+  {
+    PolyVector res = v;
+    res.reduce();
+    return res;
+  }
+
+  std::vector<poly::Polynomial> d_polys;
+};
+
+TEST_F(TestTheoryBlackArithCadProjections, discriminant)
+{
+  ProjectionCache cache;
+  for (size_t round = 0; round < 2; round++)
+  {
+    for (const poly::Polynomial& p : d_polys)
+    {
+      ASSERT_EQ(reduced(cache.discriminant(p)),
+                factors(poly::discriminant(p)));
+    }
+  }
+  ASSERT_EQ(cache.size(), d_polys.size());
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+}
+
+TEST_F(TestTheoryBlackArithCadProjections, resultant)
+{
+  ProjectionCache cache;
+  for (size_t i = 0, n = d_polys.size(); i < n; i++)
+  {
+    for (size_t j = i + 1; j < n; j++)
+    {
+      const poly::Polynomial& p = d_polys[i];
+      const poly::Polynomial& q = d_polys[j];
+      const PolyVector& pq = cache.resultant(p, q);
+      const PolyVector& qp = cache.resultant(q, p);
+      // both orders share a single entry
+      ASSERT_EQ(&pq, &qp);
+      ASSERT_EQ(reduced(pq), factors(poly::resultant(p, q)));
+      ASSERT_EQ(reduced(qp), factors(poly::resultant(q, p)));
+    }
+  }
+  size_t n = d_polys.size();
+  ASSERT_EQ(cache.size(), n * (n - 1) / 2);
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the multiplier encodings of the bit-blaster.
+ */
+
+#include <vector>
+
+#include "test.h"
+#include "theory/bv/bitblast/bitblast_utils.h"
+#include "util/bitvector.h"
+#include "util/random.h"
+
+namespace cvc5 {
+namespace test {
+
+/**
+ * A concrete bit, to evaluate the encodings directly. Not a bool, since the
+ * encodings take references into std::vector<bool> otherwise.
+ */
+struct Bit
+{
+  bool d_value;
+  bool operator==(const Bit& other) const { return d_value == other.d_value; }
+  bool operator!=(const Bit& other) const { return d_value != other.d_value; }
+};
+
+}  // namespace test
+
+namespace theory {
+namespace bv {
+
+using test::Bit;
+
+template <>
+inline Bit mkTrue<Bit>()
+{
+  return Bit{true};
+}
+
+template <>
+inline Bit mkFalse<Bit>()
+{
+  return Bit{false};
+}
+
+template <>
+inline Bit mkNot<Bit>(Bit a)
+{
+  return Bit{!a.d_value};
+}
+
+template <>
+inline Bit mkOr<Bit>(Bit a, Bit b)
+{
+  return Bit{a.d_value || b.d_value};
+}
+
+template <>
+inline Bit mkAnd<Bit>(Bit a, Bit b)
+{
+  return Bit{a.d_value && b.d_value};
+}
+
+template <>
+inline Bit mkXor<Bit>(Bit a, Bit b)
+{
+  return Bit{a.d_value != b.d_value};
+}
+
+}  // namespace bv
+}  // namespace theory
+
+using namespace theory::bv;
+
+namespace test {
+
+class TestTheoryWhiteBvBitblastUtils : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    TestInternal::SetUp();
+    Random::getRandom().setSeed(3);
+  }
+
+  BitVector mkRandomBitVector(size_t width)
+  {
+    Random& rnd = Random::getRandom();
+    BitVector res(width);
+    for (size_t i = 0; i < width; ++i)
+    {
+      if (rnd.pickWithProb(0.5))
+      {
+        res.setBit(i, true);
+      }
+    }
+    // also hit the all-zeroes and all-ones operands
+    if (rnd.pickWithProb(0.1))
+    {
+      return rnd.pickWithProb(0.5) ? BitVector(width) : ~BitVector(width);
+    }
+    return res;
+  }
+
+  std::vector<Bit> toBits(const BitVector& bv)
+  {
+    std::vector<Bit> bits;
+    for (size_t i = 0, width = bv.getSize(); i < width; ++i)
+    {
+      bits.push_back(Bit{bv.isBitSet(i)});
+    }
+    return bits;
+  }
+
+  BitVector fromBits(const std::vector<Bit>& bits)
+  {
+    BitVector res(bits.size());
+    for (size_t i = 0, width = bits.size(); i < width; ++i)
+    {
+      res.setBit(i, bits[i].d_value);
+    }
+    return res;
+  }
+
+  /** Checks all multiplier encodings on a * b. */
+  void checkMultipliers(const BitVector& a, const BitVector& b)
+  {
+    BitVector expected = a * b;
+    std::vector<Bit> abits = toBits(a);
+    std::vector<Bit> bbits = toBits(b);
+    std::vector<Bit> res;
+
+    shiftAddMultiplier(abits, bbits, res);
+    ASSERT_EQ(fromBits(res), expected) << "shift-add " << a << " * " << b;
+    res.clear();
+    treeMultiplier(abits, bbits, res, false);
+    ASSERT_EQ(fromBits(res), expected) << "wallace " << a << " * " << b;
+    res.clear();
+    treeMultiplier(abits, bbits, res, true);
+    ASSERT_EQ(fromBits(res), expected) << "dadda " << a << " * " << b;
+    res.clear();
+    boothMultiplier(abits, bbits, res);
+    ASSERT_EQ(fromBits(res), expected) << "booth " << a << " * " << b;
+    res.clear();
+    constantMultiplier(abits, b, res);
+    ASSERT_EQ(fromBits(res), expected) << "constant " << a << " * " << b;
+  }
+};
+
+TEST_F(TestTheoryWhiteBvBitblastUtils, multipliers_exhaustive)
+{
+  for (size_t width = 1; width <= 5; ++width)
+  {
+    uint32_t max = 1u << width;
+    for (uint32_t i = 0; i < max; ++i)
+    {
+      for (uint32_t j = 0; j < max; ++j)
+      {
+        checkMultipliers(BitVector(width, i), BitVector(width, j));
+      }
+    }
+  }
+}
+
+TEST_F(TestTheoryWhiteBvBitblastUtils, multipliers_random)
+{
+  for (size_t width = 1; width <= 40; ++width)
+  {
+    for (size_t i = 0; i < 200; ++i)
+    {
+      checkMultipliers(mkRandomBitVector(width), mkRandomBitVector(width));
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,91 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the bit-blasting cache shared between bit-blasters.
+ */
+
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/skolem_manager.h"
+#include "options/options.h"
+#include "test_smt.h"
+#include "theory/bv/bitblast/shared_bb_cache.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory::bv;
+
+namespace test {
+
+class TestTheoryWhiteBvSharedBBCache : public TestSmt
+{
+ protected:
+  std::vector<Node> mkBits(size_t size)
+  {
+    std::vector<Node> bits;
+    for (size_t i = 0; i < size; ++i)
+    {
+      bits.push_back(
+          d_skolemManager->mkDummySkolem("b", d_nodeManager->booleanType()));
+    }
+    return bits;
+  }
+};
+
+TEST_F(TestTheoryWhiteBvSharedBBCache, encodings)
+{
+  TypeNode bv4 = d_nodeManager->mkBitVectorType(4);
+  Node x = d_skolemManager->mkDummySkolem("x", bv4);
+  Node y = d_skolemManager->mkDummySkolem("y", bv4);
+  Node mul = d_nodeManager->mkNode(BITVECTOR_MULT, x, y);
+  Node atom = d_nodeManager->mkNode(EQUAL, mul, x);
+  Node def =
+      d_skolemManager->mkDummySkolem("d", d_nodeManager->booleanType());
+  std::vector<Node> bits = mkBits(4);
+  std::vector<Node> wallaceBits = mkBits(4);
+  std::vector<Node> res;
+
+  Options shiftAdd;
+  Options wallace;
+  wallace.setOption("bv-multiplier", "wallace");
+
+  {
+    Options::OptionsScope scope(&shiftAdd);
+    SharedBBCache::storeTerm(mul, bits);
+    SharedBBCache::storeAtom(atom, def);
+    ASSERT_TRUE(SharedBBCache::getTerm(mul, res));
+    ASSERT_EQ(res, bits);
+    ASSERT_EQ(SharedBBCache::getAtom(atom), def);
+  }
+  {
+    // the results of the shift-add multiplier are not reused
+    Options::OptionsScope scope(&wallace);
+    res.clear();
+    ASSERT_FALSE(SharedBBCache::getTerm(mul, res));
+    ASSERT_TRUE(SharedBBCache::getAtom(atom).isNull());
+    SharedBBCache::storeTerm(mul, wallaceBits);
+    res.clear();
+    ASSERT_TRUE(SharedBBCache::getTerm(mul, res));
+    ASSERT_EQ(res, wallaceBits);
+  }
+  {
+    // the results of the Wallace tree replaced them
+    Options::OptionsScope scope(&shiftAdd);
+    res.clear();
+    ASSERT_FALSE(SharedBBCache::getTerm(mul, res));
+    ASSERT_EQ(SharedBBCache::getAtom(atom), def);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,231 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Unit tests for the hash-based index of instantiations.
+ */
+
+#include <vector>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "smt/smt_engine.h"
+#include "test_smt.h"
+#include "theory/quantifiers/inst_tuple_index.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/theory_quantifiers.h"
+#include "theory/theory_engine.h"
+#include "theory/uf/equality_engine.h"
+#include "util/random.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory;
+using namespace theory::quantifiers;
+
+namespace test {
+
+class TestTheoryWhiteQuantifiersInstTupleIndex : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    for (size_t i = 0; i < 50; i++)
+    {
+      d_terms.push_back(d_nodeManager->mkConst(Rational(i)));
+    }
+    TheoryQuantifiers* tq = static_cast<TheoryQuantifiers*>(
+        d_smtEngine->getTheoryEngine()->d_theoryTable[THEORY_QUANTIFIERS]);
+    d_qstate = &tq->d_qstate;
+    Random::getRandom().setSeed(5);
+  }
+
+  /**
+   * Returns true if a tuple of insts is equal to m position-wise, by checking
+   * every tuple.
+   */
+  bool naiveExistsModEq(const std::vector<std::vector<Node>>& insts,
+                        const std::vector<Node>& m)
+  {
+    for (const std::vector<Node>& t : insts)
+    {
+      bool eq = true;
+      for (size_t i = 0, size = m.size(); i < size && eq; i++)
+      {
+        eq = t[i] == m[i]
+             || (d_qstate->hasTerm(t[i]) && d_qstate->hasTerm(m[i])
+                 && d_qstate->areEqual(t[i], m[i]));
+      }
+      if (eq)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::vector<Node> d_terms;
+  QuantifiersState* d_qstate;
+};
+
+TEST_F(TestTheoryWhiteQuantifiersInstTupleIndex, add_remove)
+{
+  InstTupleIndex index;
+  std::vector<Node> t1 = {d_terms[0], d_terms[1]};
+  std::vector<Node> t2 = {d_terms[1], d_terms[0]};
+  ASSERT_TRUE(index.add(t1));
+  ASSERT_FALSE(index.add(t1));
+  ASSERT_TRUE(index.exists(t1));
+  ASSERT_FALSE(index.exists(t2));
+  ASSERT_TRUE(index.add(t2));
+  ASSERT_EQ(index.size(), 2);
+
+  std::vector<std::vector<Node>> insts;
+  index.getInstantiations(insts);
+  ASSERT_EQ(insts.size(), 2);
+  ASSERT_TRUE(insts[0] < insts[1]);
+
+  ASSERT_TRUE(index.remove(t1));
+  ASSERT_FALSE(index.remove(t1));
+  ASSERT_FALSE(index.exists(t1));
+  ASSERT_TRUE(index.add(t1));
+  index.clear();
+  ASSERT_EQ(index.size(), 0);
+  ASSERT_FALSE(index.exists(t2));
+}
+
+TEST_F(TestTheoryWhiteQuantifiersInstTupleIndex, context_dependent)
+{
+  context::Context ctx;
+  CDInstTupleIndex index(&ctx);
+  std::vector<Node> t1 = {d_terms[0], d_terms[1]};
+  std::vector<Node> t2 = {d_terms[2], d_terms[3]};
+  ASSERT_TRUE(index.add(t1));
+  ctx.push();
+  ASSERT_FALSE(index.add(t1));
+  ASSERT_TRUE(index.add(t2));
+  ASSERT_TRUE(index.remove(t1));
+  ASSERT_FALSE(index.exists(t1));
+  std::vector<std::vector<Node>> insts;
+  index.getInstantiations(insts);
+  ASSERT_EQ(insts.size(), 1);
+  ctx.pop();
+  ASSERT_TRUE(index.exists(t1));
+  ASSERT_FALSE(index.exists(t2));
+  insts.clear();
+  index.getInstantiations(insts);
+  ASSERT_EQ(insts.size(), 1);
+  ASSERT_TRUE(index.add(t2));
+}
+
+TEST_F(TestTheoryWhiteQuantifiersInstTupleIndex, many_tuples)
+{
+  // all 125000 tuples of length 3 over 50 terms, each added twice
+  size_t nterms = d_terms.size();
+  InstTupleIndex index;
+  context::Context ctx;
+  CDInstTupleIndex cdindex(&ctx);
+  size_t added = 0;
+  std::vector<Node> tuple(3);
+  for (size_t round = 0; round < 2; round++)
+  {
+    for (size_t i = 0; i < nterms; i++)
+    {
+      tuple[0] = d_terms[i];
+      for (size_t j = 0; j < nterms; j++)
+      {
+        tuple[1] = d_terms[j];
+        for (size_t k = 0; k < nterms; k++)
+        {
+          tuple[2] = d_terms[k];
+          bool isNew = index.add(tuple);
+          ASSERT_EQ(isNew, cdindex.add(tuple));
+          if (isNew)
+          {
+            added++;
+          }
+        }
+      }
+    }
+  }
+  ASSERT_EQ(added, nterms * nterms * nterms);
+  ASSERT_EQ(index.size(), added);
+}
+
+TEST_F(TestTheoryWhiteQuantifiersInstTupleIndex, exists_mod_eq)
+{
+  Random& rnd = Random::getRandom();
+  eq::EqualityEngine* ee = d_qstate->getEqualityEngine();
+  TypeNode u = d_nodeManager->mkSort("U");
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 12; i++)
+  {
+    vars.push_back(d_nodeManager->mkVar("x" + std::to_string(i), u));
+  }
+  // the last two variables are not in the equality engine
+  for (size_t i = 0; i < 10; i++)
+  {
+    ee->addTerm(vars[i]);
+  }
+
+  InstTupleIndex index;
+  CDInstTupleIndex cdindex(d_smtEngine->getUserContext());
+  std::vector<std::vector<Node>> insts;
+  auto mkTuple = [&]() {
+    std::vector<Node> t;
+    for (size_t i = 0; i < 3; i++)
+    {
+      t.push_back(vars[rnd.pick(0, vars.size() - 1)]);
+    }
+    return t;
+  };
+  for (size_t i = 0; i < 15; i++)
+  {
+    std::vector<Node> t = mkTuple();
+    if (index.add(t))
+    {
+      insts.push_back(t);
+    }
+    cdindex.add(t);
+  }
+
+  size_t numFound = 0;
+  for (size_t round = 0; round < 6; round++)
+  {
+    for (size_t i = 0; i < 200; i++)
+    {
+      std::vector<Node> m = mkTuple();
+      bool expected = naiveExistsModEq(insts, m);
+      ASSERT_EQ(index.existsModEq(*d_qstate, m), expected);
+      ASSERT_EQ(cdindex.existsModEq(*d_qstate, m), expected);
+      numFound += expected ? 1 : 0;
+    }
+    // merge two equivalence classes, the prefixes of the tuples are checked
+    // against more candidates in the next round
+    Node a = vars[rnd.pick(0, 9)];
+    Node b = vars[rnd.pick(0, 9)];
+    Node eq = a.eqNode(b);
+    ee->assertEquality(eq, true, eq);
+    // tuples added after the first check modulo equality update the prefixes
+    std::vector<Node> t = mkTuple();
+    if (index.add(t))
+    {
+      insts.push_back(t);
+    }
+    cdindex.add(t);
+  }
+  ASSERT_GT(numFound, 0);
+  ASSERT_LT(numFound, 1200);
+}
+
+}  // namespace test
+}  // namespace cvc5
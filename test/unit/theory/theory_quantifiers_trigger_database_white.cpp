@@ -0,0 +1,85 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the trigger database.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/skolem_manager.h"
+#include "smt/smt_engine.h"
+#include "test_smt.h"
+#include "theory/quantifiers/ematching/trigger_database.h"
+#include "theory/quantifiers/theory_quantifiers.h"
+#include "theory/theory_engine.h"
+
+namespace cvc5 {
+
+using namespace kind;
+using namespace theory;
+using namespace theory::quantifiers;
+using namespace theory::quantifiers::inst;
+
+namespace test {
+
+class TestTheoryWhiteQuantifiersTriggerDatabase : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    TheoryQuantifiers* tq = static_cast<TheoryQuantifiers*>(
+        d_smtEngine->getTheoryEngine()->d_theoryTable[THEORY_QUANTIFIERS]);
+    d_tdb.reset(new TriggerDatabase(
+        tq->d_qstate, tq->d_qim, tq->d_qreg, tq->d_treg));
+  }
+
+  std::unique_ptr<TriggerDatabase> d_tdb;
+};
+
+TEST_F(TestTheoryWhiteQuantifiersTriggerDatabase, round_matches)
+{
+  TypeNode u = d_nodeManager->mkSort("U");
+  TypeNode pType = d_nodeManager->mkFunctionType(
+      {u, u}, d_nodeManager->booleanType());
+  Node p = d_skolemManager->mkDummySkolem("P", pType);
+  Node x = d_nodeManager->mkBoundVar("x", u);
+  Node y = d_nodeManager->mkBoundVar("y", u);
+  Node bvl = d_nodeManager->mkNode(BOUND_VAR_LIST, x, y);
+  Node pxy = d_nodeManager->mkNode(APPLY_UF, p, x, y);
+  Node q1 = d_nodeManager->mkNode(FORALL, bvl, pxy);
+  Node q2 = d_nodeManager->mkNode(FORALL, bvl, pxy.notNode());
+  Node a = d_skolemManager->mkDummySkolem("a", u);
+  Node b = d_skolemManager->mkDummySkolem("b", u);
+  std::vector<Node> ab = {a, b};
+  std::vector<Node> ba = {b, a};
+
+  d_tdb->resetRound();
+  ASSERT_TRUE(d_tdb->addRoundMatch(q1, ab));
+  // the same match, e.g., from another trigger of q1, is dropped
+  ASSERT_FALSE(d_tdb->addRoundMatch(q1, ab));
+  ASSERT_TRUE(d_tdb->addRoundMatch(q1, ba));
+  ASSERT_FALSE(d_tdb->addRoundMatch(q1, ba));
+  // the matches are kept per quantified formula
+  ASSERT_TRUE(d_tdb->addRoundMatch(q2, ab));
+  ASSERT_FALSE(d_tdb->addRoundMatch(q2, ab));
+
+  // and only for the current round
+  d_tdb->resetRound();
+  ASSERT_TRUE(d_tdb->addRoundMatch(q1, ab));
+  ASSERT_TRUE(d_tdb->addRoundMatch(q2, ab));
+  ASSERT_FALSE(d_tdb->addRoundMatch(q1, ab));
+}
+
+}  // namespace test
+}  // namespace cvc5
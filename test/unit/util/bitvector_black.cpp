@@ -201,5 +201,80 @@ TEST_F(TestUtilBlackBitVector, static_helpers)
   ASSERT_EQ(BitVector::mkMinSigned(4).toSignedInteger(), Integer(-8));
   ASSERT_EQ(BitVector::mkMaxSigned(4).toSignedInteger(), Integer(7));
 }
+
+TEST_F(TestUtilBlackBitVector, word_boundary)
+{
+  // Bit-vectors of size up to 64 are stored as machine words, wider ones as
+  // Integer. Results must not depend on the representation.
+  for (unsigned size : {63u, 64u, 65u})
+  {
+    Integer mod = Integer(1).multiplyByPow2(size);
+    BitVector ones = BitVector::mkOnes(size);
+    BitVector one = BitVector::mkOne(size);
+    BitVector zero = BitVector::mkZero(size);
+    BitVector min = BitVector::mkMinSigned(size);
+    BitVector max = BitVector::mkMaxSigned(size);
+
+    ASSERT_EQ(ones.getValue(), mod - 1);
+    ASSERT_EQ(ones.toSignedInteger(), Integer(-1));
+    ASSERT_EQ(min.toSignedInteger(), -mod.divByPow2(1));
+    ASSERT_EQ(ones + one, zero);
+    ASSERT_EQ(zero - one, ones);
+    ASSERT_EQ(-one, ones);
+    ASSERT_EQ(max + one, min);
+    ASSERT_EQ((ones * ones).getValue(), Integer(1));
+    ASSERT_EQ(ones.unsignedDivTotal(zero), ones);
+    ASSERT_EQ(ones.unsignedRemTotal(max), one);
+    ASSERT_TRUE(min.signedLessThan(max));
+    ASSERT_TRUE(max.unsignedLessThan(min));
+    ASSERT_TRUE(ones.signedLessThanEq(zero));
+
+    BitVector shift(size, size - 1);
+    ASSERT_EQ(one.leftShift(shift), min);
+    ASSERT_EQ(min.logicalRightShift(shift), one);
+    ASSERT_EQ(min.arithRightShift(shift), ones);
+    ASSERT_EQ(one.leftShift(ones), zero);
+    ASSERT_EQ(min.arithRightShift(ones), ones);
+
+    BitVector wide = ones.concat(one);
+    ASSERT_EQ(wide.getSize(), 2 * size);
+    ASSERT_EQ(wide.getValue(), (mod - 1).multiplyByPow2(size) + 1);
+    ASSERT_EQ(wide.extract(size - 1, 0), one);
+    ASSERT_EQ(wide.extract(2 * size - 1, size), ones);
+    ASSERT_EQ(one.signExtend(1).getValue(), Integer(1));
+    ASSERT_EQ(ones.signExtend(1), BitVector::mkOnes(size + 1));
+    ASSERT_EQ(ones.zeroExtend(1).getValue(), mod - 1);
+    ASSERT_EQ(min.isPow2(), size);
+    ASSERT_EQ(BitVector(size, Integer(-1)), ones);
+    ASSERT_EQ(BitVector(ones.toString(), 2), ones);
+  }
+}
+
+TEST_F(TestUtilBlackBitVector, move)
+{
+  for (unsigned size : {8u, 64u, 65u, 100u})
+  {
+    BitVector ones = BitVector::mkOnes(size);
+    BitVector a(ones);
+    BitVector b(std::move(a));
+    ASSERT_EQ(b, ones);
+    // the moved-from bit-vector is the bit-vector of size 0
+    ASSERT_EQ(a.getSize(), 0);
+    ASSERT_EQ(a.getValue(), Integer(0));
+    a = b;
+    ASSERT_EQ(a, ones);
+    BitVector c;
+    c = std::move(a);
+    ASSERT_EQ(c, ones);
+    ASSERT_EQ(a.getSize(), 0);
+    a = BitVector::mkOne(size);
+    ASSERT_EQ(a.getValue(), Integer(1));
+
+    c.setBit(0, false);
+    ASSERT_EQ(c.getValue(), ones.getValue() - 1);
+    BitVector d(c);
+    ASSERT_EQ(d.getValue(), ones.getValue() - 1);
+  }
+}
 }  // namespace test
 }  // namespace cvc5
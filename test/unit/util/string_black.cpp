@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::String.
+ */
+
+#include <string>
+#include <vector>
+
+#include "test.h"
+#include "util/random.h"
+#include "util/string.h"
+
+namespace cvc5 {
+namespace test {
+
+class TestUtilBlackString : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    TestInternal::SetUp();
+    Random::getRandom().setSeed(11);
+  }
+
+  /**
+   * Returns a random string of the given length over the first size code
+   * points of d_alphabet. The code points 0x61, 0x161, 0x1061 and 0x10061
+   * share their low byte.
+   */
+  String mkRandomString(size_t len, size_t size)
+  {
+    std::vector<unsigned> vec;
+    for (size_t i = 0; i < len; i++)
+    {
+      vec.push_back(d_alphabet[Random::getRandom().pick(0, size - 1)]);
+    }
+    return String(vec);
+  }
+
+  /** Naive find, as in the definition of str.indexof */
+  static size_t naiveFind(const String& t, const String& p, size_t start)
+  {
+    for (size_t i = start; i + p.size() <= t.size(); i++)
+    {
+      if (t.substr(i, p.size()) == p)
+      {
+        return i;
+      }
+    }
+    return std::string::npos;
+  }
+
+  /** Naive overlap, the longest suffix of x that is a prefix of y */
+  static size_t naiveOverlap(const String& x, const String& y)
+  {
+    size_t i = std::min(x.size(), y.size());
+    for (; i > 0; i--)
+    {
+      if (x.suffix(i) == y.prefix(i))
+      {
+        break;
+      }
+    }
+    return i;
+  }
+
+  const std::vector<unsigned> d_alphabet = {
+      0x61, 0x161, 0x1061, 0x10061, 0x62, 0x262, 0x63, 0x0};
+};
+
+TEST_F(TestUtilBlackString, find_short)
+{
+  Random& rnd = Random::getRandom();
+  for (size_t i = 0; i < 2000; i++)
+  {
+    String t = mkRandomString(rnd.pick(0, 40), rnd.pick(1, 8));
+    String p = mkRandomString(rnd.pick(0, 5), rnd.pick(1, 8));
+    size_t start = rnd.pick(0, 10);
+    ASSERT_EQ(t.find(p, start), naiveFind(t, p, start))
+        << t << " " << p << " " << start;
+  }
+}
+
+TEST_F(TestUtilBlackString, find_horspool)
+{
+  // texts with at least 256 code points from the start and patterns of length
+  // at least 4, which are searched for with the shift table
+  Random& rnd = Random::getRandom();
+  for (size_t i = 0; i < 500; i++)
+  {
+    size_t size = rnd.pick(1, 8);
+    String t = mkRandomString(rnd.pick(256, 1000), size);
+    size_t start = rnd.pick(0, 20);
+    size_t m = rnd.pick(4, 12);
+    String p;
+    if (rnd.pickWithProb(0.5))
+    {
+      // a pattern that occurs in the text
+      p = t.substr(rnd.pick(0, t.size() - m), m);
+    }
+    else if (rnd.pickWithProb(0.5))
+    {
+      // a pattern that only differs from an occurrence in one code point
+      // with the same low byte
+      String occ = t.substr(rnd.pick(0, t.size() - m), m);
+      std::vector<unsigned> vec = occ.getVec();
+      size_t j = rnd.pick(0, m - 1);
+      vec[j] = vec[j] ^ 0x100;
+      p = String(vec);
+    }
+    else
+    {
+      p = mkRandomString(m, size);
+    }
+    ASSERT_EQ(t.find(p, start), naiveFind(t, p, start))
+        << t << " " << p << " " << start;
+  }
+}
+
+TEST_F(TestUtilBlackString, find_low_byte)
+{
+  // all code points of the text share their low byte with the last code
+  // point of the pattern, but only match it at the end
+  std::vector<unsigned> tvec(300, 0x161);
+  tvec.push_back(0x61);
+  String t(tvec);
+  String p(std::vector<unsigned>{0x161, 0x161, 0x161, 0x61});
+  ASSERT_EQ(t.find(p, 0), 297);
+  ASSERT_EQ(t.find(p, 297), 297);
+  ASSERT_EQ(t.find(p, 298), std::string::npos);
+  String q(std::vector<unsigned>{0x161, 0x61, 0x161, 0x61});
+  ASSERT_EQ(t.find(q, 0), std::string::npos);
+}
+
+TEST_F(TestUtilBlackString, overlap)
+{
+  Random& rnd = Random::getRandom();
+  for (size_t i = 0; i < 5000; i++)
+  {
+    // small alphabets produce long overlaps
+    size_t size = rnd.pick(1, 3);
+    String x = mkRandomString(rnd.pick(0, 30), size);
+    String y = mkRandomString(rnd.pick(0, 30), size);
+    if (rnd.pickWithProb(0.3) && !x.empty())
+    {
+      // a string that has a suffix of x as prefix
+      y = x.suffix(rnd.pick(0, x.size())).concat(y);
+    }
+    ASSERT_EQ(x.overlap(y), naiveOverlap(x, y)) << x << " " << y;
+    ASSERT_EQ(x.roverlap(y), naiveOverlap(y, x)) << x << " " << y;
+  }
+}
+
+TEST_F(TestUtilBlackString, overlap_periodic)
+{
+  String a(std::vector<unsigned>{0x61});
+  String b(std::vector<unsigned>{0x161});
+  String aaa = a.concat(a).concat(a);
+  String aab = a.concat(a).concat(b);
+  String abab = a.concat(b).concat(a).concat(b);
+  ASSERT_EQ(aaa.overlap(aaa), 3);
+  ASSERT_EQ(aaa.overlap(aab), 2);
+  ASSERT_EQ(aab.overlap(aaa), 0);
+  ASSERT_EQ(aab.roverlap(aaa), 2);
+  ASSERT_EQ(abab.overlap(abab), 4);
+  ASSERT_EQ(abab.concat(a).overlap(abab), 3);
+  ASSERT_EQ(abab.overlap(b), 1);
+  ASSERT_EQ(abab.overlap(String()), 0);
+  ASSERT_EQ(String().roverlap(abab), 0);
+}
+
+}  // namespace test
+}  // namespace cvc5